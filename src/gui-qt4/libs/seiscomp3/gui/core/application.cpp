@@ -308,6 +308,8 @@ Application::Application(int& argc, char **argv, int flags, Type type)
 	_nonInteractive = false;
 	_filterCommands = true;
 	_mapsDesc.isMercatorProjected = false;
+	_mapsDesc.asyncLoading = false;
+	_mapsDesc.cacheSize = 0;
 
 	// argc and argv may be modified by QApplication. It removes the
 	// commandline options it recognizes so we can go on without an
@@ -903,6 +905,10 @@ bool Application::initConfiguration() {
 	try { _mapsDesc.cacheSize = configGetInt("map.cacheSize"); }
 	catch ( ... ) {}
 
+	_mapsDesc.asyncLoading = false;
+	try { _mapsDesc.asyncLoading = configGetBool("map.asyncLoading"); }
+	catch ( ... ) {}
+
 	_mapsDesc.location = Environment::Instance()->absolutePath(_mapsDesc.location.toStdString()).c_str();
 
 	_eventTimeAgo = 0.0;
@@ -30,14 +30,18 @@ namespace Gui {
  *   - Initial version
  * 2
  *   - Allow TileStore::load to return null images
+ * 3
+ *   - Added TileStore::postLoaded for thread-safe delivery of tiles
+ *   - Added MapsDesc::asyncLoading
  */
-#define TILESTORE_VERSION 2
+#define TILESTORE_VERSION 3
 
 
 struct SC_GUI_API MapsDesc {
 	QString location;
 	QString type;
 	bool    isMercatorProjected;
+	bool    asyncLoading;
 	size_t  cacheSize;
 };
 
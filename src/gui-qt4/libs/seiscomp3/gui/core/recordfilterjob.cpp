@@ -0,0 +1,160 @@
+/***************************************************************************
+ *   Copyright (C) by gempa GmbH and GFZ Potsdam                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_COMPONENT Gui::RecordFilterJob
+#include <seiscomp3/logging/log.h>
+#include <seiscomp3/core/genericrecord.h>
+#include <seiscomp3/core/typedarray.h>
+
+#include "recordfilterjob.h"
+
+
+namespace Seiscomp {
+namespace Gui {
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordFilterJob::RecordFilterJob(int slot, RecordSequence *snapshot, Filter *filter)
+: _slot(slot), _snapshot(snapshot), _filteredRecords(NULL)
+, _filter(filter), _valid(false), _canceled(0) {
+	// The job is deleted in the thread it lives in after finished()
+	// has been emitted and not by the thread pool
+	setAutoDelete(false);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordFilterJob::~RecordFilterJob() {
+	if ( _snapshot ) delete _snapshot;
+	if ( _filteredRecords ) delete _filteredRecords;
+	if ( _filter ) delete _filter;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordFilterJob::cancel() {
+	_canceled.fetchAndStoreOrdered(1);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool RecordFilterJob::isCanceled() const {
+	return const_cast<QAtomicInt&>(_canceled).fetchAndAddOrdered(0) != 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordSequence *RecordFilterJob::takeFilteredRecords() {
+	RecordSequence *seq = _filteredRecords;
+	_filteredRecords = NULL;
+	return seq;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+RecordFilterJob::Filter *RecordFilterJob::takeFilter() {
+	Filter *filter = _filter;
+	_filter = NULL;
+	return filter;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordFilterJob::run() {
+	if ( !isCanceled() && _snapshot && _filter && !_snapshot->empty() ) {
+		const Record *first = _snapshot->front().get();
+
+		try {
+			_filter->setSamplingFrequency(first->samplingFrequency());
+			_filter->setStartTime(first->startTime());
+			_filter->setStreamID(first->networkCode(), first->stationCode(),
+			                     first->locationCode(), first->channelCode());
+
+			// Records are only read here. Their reference counts must not
+			// be touched since the GUI thread holds them as well.
+			_filteredRecords = _snapshot->clone();
+			_valid = true;
+
+			for ( RecordSequence::const_iterator it = _snapshot->begin();
+			      it != _snapshot->end(); ++it ) {
+				if ( isCanceled() ) {
+					_valid = false;
+					break;
+				}
+
+				const Record *rec = it->get();
+				if ( rec->data() == NULL ) continue;
+
+				FloatArrayPtr arr = (FloatArray*)rec->data()->copy(Array::FLOAT);
+				GenericRecordPtr crec = new GenericRecord(*rec);
+
+				_filter->apply(arr->size(), arr->typedData());
+
+				try {
+					crec->endTime();
+				}
+				catch (...) {
+					SEISCOMP_ERROR("Filtered record has invalid endtime -> skipping");
+					continue;
+				}
+
+				crec->setData(arr.get());
+				_filteredRecords->feed(crec.get());
+				_endTime = rec->endTime();
+			}
+		}
+		catch ( std::exception &e ) {
+			SEISCOMP_ERROR("%s: filter: %s", first->streamID().c_str(), e.what());
+			_valid = false;
+		}
+	}
+
+	// Nothing must be touched after this call since the job might be
+	// deleted already
+	QMetaObject::invokeMethod(this, "notify", Qt::QueuedConnection);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordFilterJob::notify() {
+	emit finished();
+	deleteLater();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+}
+}
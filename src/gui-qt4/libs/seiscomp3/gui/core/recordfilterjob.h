@@ -0,0 +1,102 @@
+/***************************************************************************
+ *   Copyright (C) by gempa GmbH and GFZ Potsdam                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#ifndef __SEISCOMP_GUI_RECORDFILTERJOB_H__
+#define __SEISCOMP_GUI_RECORDFILTERJOB_H__
+
+
+#include <QObject>
+#include <QRunnable>
+#include <QAtomicInt>
+
+#ifndef Q_MOC_RUN
+#include <seiscomp3/core/recordsequence.h>
+#include <seiscomp3/math/filter.h>
+#endif
+#include <seiscomp3/gui/qt4.h>
+
+
+namespace Seiscomp {
+namespace Gui {
+
+
+//! \brief Filters a snapshot of a record sequence in a worker thread.
+//!
+//! The job is created in the GUI thread with a copy of the raw record
+//! sequence and a clone of the filter. It is executed by a QThreadPool and
+//! emits finished() in the thread it lives in when done. The job does not
+//! touch the records of the snapshot other than reading their data. The
+//! filtered sequence and the filter (which holds the state after the last
+//! sample) can be taken in the slots connected to finished(). The job
+//! deletes itself afterwards.
+class SC_GUI_API RecordFilterJob : public QObject, public QRunnable {
+	Q_OBJECT
+
+	public:
+		typedef Math::Filtering::InPlaceFilter<float> Filter;
+
+
+	public:
+		//! Creates a job that takes ownership of the snapshot and the filter.
+		RecordFilterJob(int slot, RecordSequence *snapshot, Filter *filter);
+		~RecordFilterJob();
+
+
+	public:
+		//! Requests cancellation. The job stops processing at the next
+		//! record boundary. This method is thread-safe.
+		void cancel();
+		bool isCanceled() const;
+
+		int slot() const { return _slot; }
+
+		//! Returns whether the job has finished successfully
+		bool isValid() const { return _valid; }
+
+		//! Returns the end time of the last raw record processed
+		const Core::Time &endTime() const { return _endTime; }
+
+		//! Returns the filtered records and transfers ownership to the caller
+		RecordSequence *takeFilteredRecords();
+
+		//! Returns the filter and transfers ownership to the caller
+		Filter *takeFilter();
+
+		void run();
+
+
+	signals:
+		void finished();
+
+
+	private slots:
+		void notify();
+
+
+	private:
+		int             _slot;
+		RecordSequence *_snapshot;
+		RecordSequence *_filteredRecords;
+		Filter         *_filter;
+		Core::Time      _endTime;
+		bool            _valid;
+		QAtomicInt      _canceled;
+};
+
+
+}
+}
+
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <QPainter>
 #include <QToolTip>
+#include <QThreadPool>
 
 #define SEISCOMP_COMPONENT Gui::RecordWidget
 #include <seiscomp3/core/genericrecord.h>
@@ -27,6 +28,7 @@ using namespace std;
 using namespace Seiscomp;
 
 #include "recordwidget.h"
+#include "recordfilterjob.h"
 
 namespace  sc = Seiscomp::Core;
 
@@ -757,6 +759,7 @@ RecordWidget::Stream::Stream(bool owner) {
 	traces[0].timingQuality = traces[1].timingQuality = -1;
 	traces[0].timingQualityCount = traces[1].timingQualityCount = 0;
 	filter = NULL;
+	filterJob = NULL;
 	pen = QPen(SCScheme.colors.records.foreground, SCScheme.records.lineWidth);
 	antialiasing = SCScheme.records.antiAliasing;
 	stepFunction = false;
@@ -803,6 +806,13 @@ void RecordWidget::Stream::setDirty() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void RecordWidget::Stream::free() {
+	// A pending job is finished and deleted in the background, its
+	// results are ignored
+	if ( filterJob != NULL ) {
+		filterJob->cancel();
+		filterJob = NULL;
+	}
+
 	if ( records[0] != NULL && ownRawRecords ) delete records[0];
 	if ( records[1] != NULL && ownFilteredRecords ) delete records[1];
 	if ( filter != NULL ) delete filter;
@@ -909,6 +919,7 @@ void RecordWidget::init() {
 	_hoveredMarker = NULL;
 
 	_enabled = isEnabled();
+	_asyncFiltering = SCScheme.records.asynchronousFiltering;
 	setDrawAxis(false);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -1108,6 +1119,11 @@ bool RecordWidget::setRecordFilter(int slot, const Filter *filter) {
 	if ( stream->filter )
 		delete stream->filter;
 
+	if ( stream->filterJob ) {
+		stream->filterJob->cancel();
+		stream->filterJob = NULL;
+	}
+
 	if ( filter )
 		stream->filter = filter->clone();
 	else {
@@ -1129,7 +1145,10 @@ bool RecordWidget::setRecordFilter(int slot, const Filter *filter) {
 			stream->filter->setStartTime(rec->startTime());
 			stream->filter->setStreamID(rec->networkCode(), rec->stationCode(),
 			                            rec->locationCode(), rec->channelCode());
-			filterRecords(stream);
+			if ( _asyncFiltering )
+				startFilterJob(slot, stream);
+			else
+				filterRecords(stream);
 		}
 		catch ( std::exception &e ) {
 			SEISCOMP_ERROR("%s: filter: %s", rec->streamID().c_str(), e.what());
@@ -4059,6 +4078,10 @@ bool RecordWidget::createFilter(int slot) {
 		return true;
 	}
 
+	// Records fed while a background job is running are filtered
+	// when the job has finished
+	if ( s->filterJob ) return false;
+
 	if (s->records[Stream::Raw] && !s->records[Stream::Raw]->empty()) {
 		const Record *rec = s->records[Stream::Raw]->front().get();
 		double fs = rec->samplingFrequency();
@@ -4070,7 +4093,10 @@ bool RecordWidget::createFilter(int slot) {
 				s->filter->setStartTime(rec->startTime());
 				s->filter->setStreamID(rec->networkCode(), rec->stationCode(),
 				                       rec->locationCode(), rec->channelCode());
-				filterRecords(s);
+				if ( _asyncFiltering )
+					startFilterJob(slot, s);
+				else
+					filterRecords(s);
 			}
 			catch ( std::exception &e ) {
 				SEISCOMP_ERROR("%s: filter: %s", rec->streamID().c_str(), e.what());
@@ -4125,6 +4151,97 @@ void RecordWidget::filterRecords(Stream *s) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordWidget::startFilterJob(int slot, Stream *s) {
+	if ( s->filterJob ) {
+		s->filterJob->cancel();
+		s->filterJob = NULL;
+	}
+
+	RecordSequence *raw = s->records[Stream::Raw];
+	RecordSequence *snapshot = raw->clone();
+	for ( RecordSequence::const_iterator it = raw->begin(); it != raw->end(); ++it ) {
+		// Decode the data in this thread to not modify the records
+		// concurrently from the worker
+		(*it)->data();
+		snapshot->push_back(*it);
+	}
+
+	s->filterJob = new RecordFilterJob(slot, snapshot, s->filter->clone());
+	connect(s->filterJob, SIGNAL(finished()), this, SLOT(filterJobFinished()));
+	QThreadPool::globalInstance()->start(s->filterJob);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordWidget::filterJobFinished() {
+	RecordFilterJob *job = static_cast<RecordFilterJob*>(sender());
+	if ( job->slot() < 0 || job->slot() >= _streams.size() ) return;
+
+	// Stale job: either the filter or the records have changed in the
+	// meantime
+	Stream *s = _streams[job->slot()];
+	if ( s->filterJob != job ) return;
+
+	s->filterJob = NULL;
+	if ( job->isCanceled() || !job->isValid() || !s->records[Stream::Raw] ) return;
+
+	Filter *filter = job->takeFilter();
+	if ( s->filter ) delete s->filter;
+	s->filter = filter;
+
+	if ( s->records[Stream::Filtered] && s->ownFilteredRecords )
+		delete s->records[Stream::Filtered];
+
+	s->records[Stream::Filtered] = job->takeFilteredRecords();
+	s->ownFilteredRecords = true;
+
+	// Filter all records that have been fed while the job was running
+	const Core::Time &endTime = job->endTime();
+	for ( RecordSequence::const_iterator it = s->records[Stream::Raw]->begin();
+	      it != s->records[Stream::Raw]->end(); ++it ) {
+		if ( (*it)->endTime() <= endTime ) continue;
+		RecordPtr frec = filteredRecord(s->filter, it->get());
+		if ( frec ) s->records[Stream::Filtered]->feed(frec.get());
+	}
+
+	if ( _shadowWidget && (_shadowWidget->_shadowWidgetFlags & Filtered) )
+		_shadowWidget->setFilteredRecords(job->slot(), s->records[Stream::Filtered], false);
+
+	s->traces[Stream::Filtered].dirty = true;
+	_drawRecords = true;
+
+	setDirty();
+	update();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void RecordWidget::setAsynchronousFilteringEnabled(bool enable) {
+	_asyncFiltering = enable;
+	if ( _shadowWidget ) _shadowWidget->setAsynchronousFilteringEnabled(enable);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool RecordWidget::isFilterPending(int slot) const {
+	const Stream *s = getStream(slot);
+	return s != NULL && s->filterJob != NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Record* RecordWidget::filteredRecord(Math::Filtering::InPlaceFilter<float> *filter,
                                      const Record* rec, const Record* lastRec) const {
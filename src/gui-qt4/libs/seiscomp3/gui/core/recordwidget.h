@@ -37,6 +37,7 @@ namespace Gui {
 
 
 class RecordWidget;
+class RecordFilterJob;
 
 
 //! \brief RecordMarker - marks a certain timestamp in the record
@@ -348,6 +349,16 @@ class SC_GUI_API RecordWidget : public QWidget {
 		void setValuePrecision(int p);
 		int valuePrecision() const { return _valuePrecision; }
 
+		//! Enables filtering of the records in a background thread pool
+		//! when the filter changes. The filtered trace is shown as soon
+		//! as the job has finished while the GUI stays responsive. The
+		//! default is taken from scheme.records.asynchronousFiltering.
+		void setAsynchronousFilteringEnabled(bool enable);
+		bool isAsynchronousFilteringEnabled() const { return _asyncFiltering; }
+
+		//! Returns whether a background filter job is pending for slot
+		bool isFilterPending(int slot) const;
+
 		//! Sets a shadow widget that gets informed about record changes.
 		//! Available record slots are copied by reference
 		//! in that way that the listener is not the owner of the
@@ -586,6 +597,7 @@ class SC_GUI_API RecordWidget : public QWidget {
 
 	private slots:
 		void scroll(int);
+		void filterJobFinished();
 
 
 	signals:
@@ -707,6 +719,10 @@ class SC_GUI_API RecordWidget : public QWidget {
 			QVariant        userData;
 
 			Filter         *filter;
+
+			// The currently running background filter job. It is canceled
+			// if the filter or the records change.
+			RecordFilterJob *filterJob;
 		};
 
 
@@ -717,6 +733,7 @@ class SC_GUI_API RecordWidget : public QWidget {
 		bool createFilter();
 		bool createFilter(int slot);
 		void filterRecords(Stream *s);
+		void startFilterJob(int slot, Stream *s);
 		bool setFilteredRecords(int slot, RecordSequence* seq, bool owner);
 		Record* filteredRecord(Filter *filter,
 		                       const Record*, const Record* = NULL) const;
@@ -774,6 +791,7 @@ class SC_GUI_API RecordWidget : public QWidget {
 		bool      _enabled;
 		bool      _useGlobalOffset;
 		bool      _drawAxis;
+		bool      _asyncFiltering;
 
 		int          _tracePaintOffset;
 		int          _axisWidth;
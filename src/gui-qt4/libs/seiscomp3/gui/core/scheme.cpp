@@ -430,6 +430,7 @@ Scheme::Records::Records() {
 	lineWidth = 1;
 	antiAliasing = true;
 	optimize = true;
+	asynchronousFiltering = false;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -642,6 +643,7 @@ void Scheme::fetch() {
 	READ_INT(records.lineWidth);
 	READ_BOOL(records.antiAliasing);
 	READ_BOOL(records.optimize);
+	READ_BOOL(records.asynchronousFiltering);
 
 	try {
 		string mode = SCApp->configGetString("scheme.records.borders.drawMode");
@@ -277,6 +277,7 @@ class SC_GUI_API Scheme {
 			int lineWidth;
 			bool antiAliasing;
 			bool optimize;
+			bool asynchronousFiltering;
 			RecordBorders recordBorders;
 		};
 
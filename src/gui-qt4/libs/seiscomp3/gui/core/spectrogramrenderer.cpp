@@ -17,6 +17,21 @@
 
 namespace Seiscomp {
 namespace Gui {
+
+
+namespace {
+
+
+bool isOutside(const IO::Spectrum *spec, const Core::TimeWindow &tw) {
+	if ( tw.startTime().valid() && spec->endTime() <= tw.startTime() )
+		return true;
+	if ( tw.endTime().valid() && spec->startTime() >= tw.endTime() )
+		return true;
+	return false;
+}
+
+
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -44,6 +59,7 @@ SpectrogramRenderer::SpectrogramRenderer() {
 	_logarithmic = false;
 	_smoothTransform = true;
 	_dirty = false;
+	_updated = false;
 
 	_renderedFmin = _renderedFmax = -1;
 }
@@ -162,8 +178,13 @@ bool SpectrogramRenderer::feed(const Record *rec) {
 			}
 
 			_spectra.push_back(spec);
-			addSpectrum(spec.get());
-			setDirty();
+
+			// If the images are valid then just add another column
+			// otherwise they are rebuilt from all spectra anyway
+			if ( !_dirty ) {
+				addSpectrum(spec.get());
+				_updated = true;
+			}
 		}
 	}
 
@@ -183,8 +204,6 @@ bool SpectrogramRenderer::feedSequence(const RecordSequence *seq) {
 	for ( it = seq->begin(); it != seq->end(); ++it )
 		if ( feed(it->get()) ) result = true;
 
-	setDirty();
-
 	return result;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -230,24 +249,46 @@ void SpectrogramRenderer::setTimeWindow(const Core::TimeWindow& tw) {
 
 	// Trim spectra
 	if ( _timeWindow.startTime().valid() || _timeWindow.endTime().valid() ) {
-		Spectra::iterator it;
-		bool needUpdate = false;
-
-		for ( it = _spectra.begin(); it != _spectra.end(); ) {
-			IO::Spectrum *spec = it->get();
-			if ( _timeWindow.startTime().valid() && spec->endTime() <= _timeWindow.startTime() ) {
-				it = _spectra.erase(it);
-				needUpdate = true;
-			}
-			else if ( _timeWindow.endTime().valid() && spec->startTime() >= _timeWindow.endTime() ) {
-				it = _spectra.erase(it);
-				needUpdate = true;
+		int count = _spectra.size();
+		int front = 0, back = 0;
+
+		while ( front < count && isOutside(_spectra[front].get(), _timeWindow) )
+			++front;
+
+		while ( back < count-front && isOutside(_spectra[count-1-back].get(), _timeWindow) )
+			++back;
+
+		bool removedInBetween = false;
+		for ( int i = front; i < count-back; ++i ) {
+			if ( isOutside(_spectra[i].get(), _timeWindow) ) {
+				removedInBetween = true;
+				break;
 			}
-			else
-				++it;
 		}
 
-		if ( needUpdate ) setDirty();
+		if ( removedInBetween ) {
+			Spectra::iterator it;
+			for ( it = _spectra.begin(); it != _spectra.end(); ) {
+				if ( isOutside(it->get(), _timeWindow) )
+					it = _spectra.erase(it);
+				else
+					++it;
+			}
+
+			setDirty();
+		}
+		else if ( front > 0 || back > 0 ) {
+			_spectra.erase(_spectra.end()-back, _spectra.end());
+			_spectra.erase(_spectra.begin(), _spectra.begin()+front);
+
+			// Each spectrum occupies exactly one image column in feed order,
+			// trimming spectra at both ends thus trims the images and the
+			// remaining columns do not need to be recomputed
+			if ( !_dirty ) {
+				trimImages(front, back);
+				_updated = true;
+			}
+		}
 	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -332,6 +373,7 @@ void SpectrogramRenderer::renderSpectrogram() {
 		addSpectrum(it->get());
 
 	_dirty = false;
+	_updated = true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -377,7 +419,7 @@ void SpectrogramRenderer::addSpectrum(IO::Spectrum *spec) {
 		Core::Time currentEndTime = img.startTime + Core::TimeSpan(img.width*dt);
 
 		bool needNewImage = (fabs((double)(newTime - currentEndTime)) > dt*0.5)
-		                 || (img.data.height() != nSamples)
+		                 || (img.data.height() != data->size())
 		                 || (img.minimumFrequency != minFreq)
 		                 || (img.maximumFrequency != spec->maximumFrequency())
 		                 || (img.dt != spec->dt());
@@ -418,6 +460,41 @@ void SpectrogramRenderer::addSpectrum(IO::Spectrum *spec) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void SpectrogramRenderer::trimImages(int front, int back) {
+	while ( front > 0 && !_images.empty() ) {
+		SpecImage &img = _images.front();
+		if ( front >= img.width ) {
+			front -= img.width;
+			_images.removeFirst();
+			continue;
+		}
+
+		img.data = img.data.copy(front, 0, img.data.width()-front, img.data.height());
+		img.startTime += Core::TimeSpan((double)img.dt * front);
+		img.width -= front;
+		front = 0;
+	}
+
+	while ( back > 0 && !_images.empty() ) {
+		SpecImage &img = _images.back();
+		if ( back >= img.width ) {
+			back -= img.width;
+			_images.removeLast();
+			continue;
+		}
+
+		// Keep the allocated width, the trimmed columns are overwritten
+		// by subsequent spectra
+		img.width -= back;
+		back = 0;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void SpectrogramRenderer::fillRow(SpecImage &img, ComplexDoubleArray *spec,
                                   int column, int offset) {
@@ -430,24 +507,37 @@ void SpectrogramRenderer::fillRow(SpecImage &img, ComplexDoubleArray *spec,
 	// Goto nth column
 	rgb += column;
 
+	// Compute the power spectrum of all bins in one tight loop over
+	// contiguous memory which can be vectorized by the compiler. A complex
+	// value is stored as two consecutive doubles.
+	if ( (int)_power.size() < n ) _power.resize(n);
+	double *power = &_power[0];
+	const double *values = reinterpret_cast<const double*>(spec->typedData());
+	double norm2 = norm*norm;
+
+	for ( int i = 0; i < n; ++i ) {
+		double re = values[2*i];
+		double im = values[2*i+1];
+		power[i] = (re*re + im*im) * norm2;
+	}
+
+	double amin = 0, ascale = 1.0;
+
 	if ( _normalize ) {
-		double amin = -1, amax = -1;
+		amin = -1;
+		double amax = -1;
 		double fmin = 0.0, fmax = maxFreq;
 		if ( _fmin ) fmin = *_fmin;
 		if ( _fmax ) fmax = *_fmax;
 
 		// Compute min/max amplitude
 		double f = maxFreq;
-		double df = maxFreq / (spec->size()-1);
+		double df = maxFreq / (n-1);
 
-		for ( int i = n; i > offset; --i, f -= df ) {
+		for ( int i = n-1; i >= offset; --i, f -= df ) {
 			if ( f < fmin || f > fmax ) continue;
 
-			Seiscomp::ComplexDoubleArray::Type &v = (*spec)[i-1];
-
-			double sr = v.real()*norm;
-			double si = v.imag()*norm;
-			double ps = sr*sr + si*si;
+			double ps = power[i];
 			if ( ps > 0 ) {
 				if ( amin < 0 || amin > ps )
 					amin = ps;
@@ -456,8 +546,6 @@ void SpectrogramRenderer::fillRow(SpecImage &img, ComplexDoubleArray *spec,
 			}
 		}
 
-		double ascale = 1.0;
-
 		if ( amin > 0 && amax > 0 ) {
 			amin = log10(amin);
 			amax = log10(amax);
@@ -470,111 +558,62 @@ void SpectrogramRenderer::fillRow(SpecImage &img, ComplexDoubleArray *spec,
 			amin = 0;
 			ascale = 0;
 		}
+	}
 
-		if ( _logarithmic ) {
+	// Resample the power spectrum to a logarithmic frequency axis. The
+	// sample positions only depend on the number of bins and are cached.
+	if ( _logarithmic ) {
+		if ( _logIndex.size() != (size_t)n ) {
 			double logTo = log10(n);
 			double logFrom = 0;
 			double logRange = logTo - logFrom;
 
-			for ( int i = n; i > offset; --i ) {
-				double li = pow(10.0, (i-1)*logRange/(n-1) + logFrom) - 1;
-				int i0 = (int)li;
-				double t = li-i0;
-				double sr, si, ps;
-
-				if ( i0 >= n-1 ) {
-					sr = (*spec)[n-1].real()*norm;
-					si = (*spec)[n-1].imag()*norm;
-					ps = sr*sr + si*si;
-				}
-				else if ( t == 0 ) {
-					sr = (*spec)[i0].real()*norm;
-					si = (*spec)[i0].imag()*norm;
-					ps = sr*sr + si*si;
-				}
-				else {
-					sr = (*spec)[i0].real()*norm;
-					si = (*spec)[i0].imag()*norm;
-					ps = sr*sr + si*si;
-
-					sr = (*spec)[i0+1].real()*norm;
-					si = (*spec)[i0+1].imag()*norm;
-					ps = ps * (1-t) + (sr*sr + si*si) * t;
-				}
-
-				double amp = ps > 0?log10(ps):_gradient.lowerBound();
-				amp = (amp-amin)*ascale;
-
-				*rgb = _gradient.valueAtNormalizedIndex(amp);
-				rgb += ofs;
+			_logIndex.resize(n);
+			_logWeight.resize(n);
+
+			for ( int i = 0; i < n; ++i ) {
+				double li = pow(10.0, i*logRange/(n-1) + logFrom) - 1;
+				_logIndex[i] = (int)li;
+				_logWeight[i] = li - _logIndex[i];
 			}
 		}
-		else {
-			for ( int i = n; i > offset; --i ) {
-				Seiscomp::ComplexDoubleArray::Type &v = (*spec)[i-1];
 
-				double sr = v.real()*norm;
-				double si = v.imag()*norm;
-				double ps = sr*sr + si*si;
-				double amp = ps > 0?log10(ps):_gradient.lowerBound();
-				amp = (amp-amin)*ascale;
+		if ( (int)_logPower.size() < n ) _logPower.resize(n);
+		double *logPower = &_logPower[0];
 
-				*rgb = _gradient.valueAtNormalizedIndex(amp);
-				rgb += ofs;
-			}
+		for ( int i = offset; i < n; ++i ) {
+			int i0 = _logIndex[i];
+			double t = _logWeight[i];
+
+			if ( i0 >= n-1 )
+				logPower[i] = power[n-1];
+			else if ( t == 0 )
+				logPower[i] = power[i0];
+			else
+				logPower[i] = power[i0] * (1-t) + power[i0+1] * t;
 		}
+
+		power = logPower;
 	}
-	else {
-		// Go from highest to lowest frequency
-		if ( _logarithmic ) {
-			double logTo = log10(n);
-			double logFrom = 0;
-			double logRange = logTo - logFrom;
 
-			for ( int i = n; i > offset; --i ) {
-				double li = pow(10.0, (i-1)*logRange/(n-1) + logFrom) - 1;
-				int i0 = (int)li;
-				double t = li-i0;
-				double sr, si, ps;
-
-				if ( i0 >= n-1 ) {
-					sr = (*spec)[n-1].real()*norm;
-					si = (*spec)[n-1].imag()*norm;
-					ps = sr*sr + si*si;
-				}
-				else if ( t == 0 ) {
-					sr = (*spec)[i0].real()*norm;
-					si = (*spec)[i0].imag()*norm;
-					ps = sr*sr + si*si;
-				}
-				else {
-					sr = (*spec)[i0].real()*norm;
-					si = (*spec)[i0].imag()*norm;
-					ps = sr*sr + si*si;
-
-					sr = (*spec)[i0+1].real()*norm;
-					si = (*spec)[i0+1].imag()*norm;
-					ps = ps * (1-t) + (sr*sr + si*si) * t;
-				}
-
-				double amp = ps > 0?log10(ps):_gradient.lowerBound();
-
-				*rgb = _gradient.valueAt(amp);
-				rgb += ofs;
-			}
-		}
-		else {
-			for ( int i = n; i > offset; --i ) {
-				Seiscomp::ComplexDoubleArray::Type &v = (*spec)[i-1];
+	// Go from highest to lowest frequency
+	if ( _normalize ) {
+		for ( int i = n-1; i >= offset; --i ) {
+			double ps = power[i];
+			double amp = ps > 0?log10(ps):_gradient.lowerBound();
+			amp = (amp-amin)*ascale;
 
-				double sr = v.real()*norm;
-				double si = v.imag()*norm;
-				double ps = sr*sr + si*si;
-				double amp = ps > 0?log10(ps):_gradient.lowerBound();
+			*rgb = _gradient.valueAtNormalizedIndex(amp);
+			rgb += ofs;
+		}
+	}
+	else {
+		for ( int i = n-1; i >= offset; --i ) {
+			double ps = power[i];
+			double amp = ps > 0?log10(ps):_gradient.lowerBound();
 
-				*rgb = _gradient.valueAt(amp);
-				rgb += ofs;
-			}
+			*rgb = _gradient.valueAt(amp);
+			rgb += ofs;
 		}
 	}
 }
@@ -601,6 +640,8 @@ void SpectrogramRenderer::render(QPainter &p, const QRect &rect,
 	if ( (h <= 0) || (w <= 0) ) return;
 
 	if ( _dirty ) renderSpectrogram();
+	_updated = false;
+
 	if ( _images.empty() ) return;
 
 	if ( !_fmax ) {
@@ -25,6 +25,8 @@
 
 #include <QPainter>
 
+#include <vector>
+
 
 namespace Seiscomp {
 namespace Gui {
@@ -96,7 +98,10 @@ class SC_GUI_API SpectrogramRenderer {
 		//! Sets the transfer function for deconvolution
 		void setTransferFunction(Math::Restitution::FFT::TransferFunction *tf);
 
-		bool isDirty() const { return _dirty; }
+		//! Returns whether the spectrogram has changed since the last call
+		//! to render, either because new spectra were added incrementally
+		//! or because it needs to be rebuilt.
+		bool isDirty() const { return _dirty || _updated; }
 
 		//! Creates the spectrogram. This is usually done in render if the
 		//! spectrogram is dirty but can called from outside.
@@ -130,6 +135,7 @@ class SC_GUI_API SpectrogramRenderer {
 
 		void setDirty();
 		void addSpectrum(IO::Spectrum *);
+		void trimImages(int front, int back);
 		void fillRow(SpecImage &img, Seiscomp::ComplexDoubleArray *spec,
 		             int column, int offset);
 
@@ -161,6 +167,11 @@ class SC_GUI_API SpectrogramRenderer {
 		bool                      _logarithmic;
 		bool                      _smoothTransform;
 		bool                      _dirty;
+		bool                      _updated;
+		std::vector<double>       _power;
+		std::vector<double>       _logPower;
+		std::vector<int>          _logIndex;
+		std::vector<double>       _logWeight;
 		double                    _renderedFmin;
 		double                    _renderedFmax;
 };
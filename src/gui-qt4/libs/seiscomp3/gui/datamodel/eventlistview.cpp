@@ -51,6 +51,8 @@
 #include <QTreeWidgetItem>
 #include <QHeaderView>
 
+#include <algorithm>
+
 
 using namespace Seiscomp::Core;
 using namespace Seiscomp::Client;
@@ -680,6 +682,34 @@ bool itemTextGreaterThan(const SortItem& left, const SortItem& right) {
 }
 
 
+// Returns the depth of an item or -1 if it is not part of a tree
+int itemDepth(const QTreeWidgetItem *item) {
+	if ( item->treeWidget() == NULL ) return -1;
+	int depth = 0;
+	while ( (item = item->parent()) != NULL ) ++depth;
+	return depth;
+}
+
+
+QList<int> itemPath(const QTreeWidgetItem *item) {
+	QList<int> path;
+	for ( ; item != NULL; item = item->parent() ) {
+		if ( item->parent() )
+			path.prepend(item->parent()->indexOfChild(const_cast<QTreeWidgetItem*>(item)));
+		else
+			path.prepend(item->treeWidget()->indexOfTopLevelItem(const_cast<QTreeWidgetItem*>(item)));
+	}
+	return path;
+}
+
+
+// Returns whether the first item comes before the second item in the tree
+bool itemPrecedes(const QTreeWidgetItem *first, const QTreeWidgetItem *second) {
+	QList<int> a = itemPath(first), b = itemPath(second);
+	return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+
 }
 
 
@@ -733,7 +763,17 @@ class TreeItem : public QTreeWidgetItem {
 class SchemeTreeItem : public TreeItem {
 	protected:
 		SchemeTreeItem(int type, PublicObject* object, const EventListView::ItemConfig &cfg, QTreeWidgetItem * parent = 0)
-		: TreeItem(parent, type, cfg), _object(object) { init(); }
+		: TreeItem(parent, type, cfg), _object(object) {
+			init();
+			if ( _object && config.index )
+				config.index->insert(_object->publicID().c_str(), this);
+		}
+
+	public:
+		~SchemeTreeItem() {
+			if ( _object && config.index )
+				config.index->remove(_object->publicID().c_str(), this);
+		}
 
 	public:
 		void init() {
@@ -1971,7 +2011,8 @@ EventListView::EventListView(Seiscomp::DataModel::DatabaseQuery* reader, bool wi
                              bool withFocalMechanisms, QWidget * parent, Qt::WindowFlags f)
  : QWidget(parent, f), _reader(reader),
    _withOrigins(withOrigins), _withFocalMechanisms(withFocalMechanisms),
-   _blockSelection(false), _blockRemovingOfExpiredEvents(false) {
+   _blockSelection(false), _blockRemovingOfExpiredEvents(false),
+   _eventsTimeOrdered(true) {
 	_ui.setupUi(this);
 
 	_regionIndex = 0;
@@ -1995,6 +2036,7 @@ EventListView::EventListView(Seiscomp::DataModel::DatabaseQuery* reader, bool wi
 	_unassociatedEventItem = NULL;
 	_updateLocalEPInstance = false;
 
+	_itemConfig.index = &_itemIndex;
 	_itemConfig.disabledColor = palette().color(QPalette::Disabled, QPalette::Text);
 	_itemConfig.columnMap.clear();
 	for ( int i = 0; i < EventListColumns::Quantity; ++i ) {
@@ -2388,6 +2430,9 @@ EventListView::EventListView(Seiscomp::DataModel::DatabaseQuery* reader, bool wi
 	//_treeWidget->setHeaderLabels(QStringList() << "PublicID" << "Desc/Time" << "Mag" << "StaCount" << "defPhaseCount");
 	_treeWidget->setHeaderLabels(_itemConfig.header);
 	_treeWidget->setAlternatingRowColors(true);
+	// All rows share the same height which lets the view skip measuring
+	// each item and only layout the visible rows
+	_treeWidget->setUniformRowHeights(true);
 
 	for ( int i = 0; i < EventListColumns::Quantity; ++i )
 		_treeWidget->header()->setSectionHidden(_itemConfig.columnMap[i], !colVisibility[i]);
@@ -2632,6 +2677,12 @@ bool EventListView::updateHideState(QTreeWidgetItem *item) {
 
 EventListView::~EventListView() {
 	PublicObjectEvaluator::Instance().clear(this);
+
+	// Items reference the item configuration in their destructor, so remove
+	// them while it is still valid
+	_itemConfig.index = NULL;
+	_treeWidget->blockSignals(true);
+	_treeWidget->clear();
 }
 
 
@@ -2759,6 +2810,7 @@ void EventListView::setEventModificationsEnabled(bool e) {
 void EventListView::initTree() {
 
 	_treeWidget->clear();
+	_eventsTimeOrdered = true;
 
 	if ( _withOrigins )
 		_unassociatedEventItem = addEvent(NULL, false);
@@ -3438,20 +3490,47 @@ EventTreeItem* EventListView::addEvent(Seiscomp::DataModel::Event* event, bool f
 	EventTreeItem *item = new EventTreeItem(event, _itemConfig);
 	item->setShowOneItemPerAgency(_showOnlyLatestPerAgency);
 
-	if ( _treeWidget->topLevelItemCount() == 0 )
-		_treeWidget->insertTopLevelItem(0, item);
-	else {
-		int pos = _treeWidget->topLevelItemCount();
-		for ( int i = 0; i  < _treeWidget->topLevelItemCount(); ++i ) {
-			if ( _treeWidget->topLevelItem(i)->data(_itemConfig.columnMap[COL_OTIME], Qt::UserRole).toDouble()
-				  < item->data(_itemConfig.columnMap[COL_OTIME], Qt::UserRole).toDouble() ) {
+	int col = _itemConfig.columnMap[COL_OTIME];
+	double otime = item->data(col, Qt::UserRole).toDouble();
+	int count = _treeWidget->topLevelItemCount();
+	int pos = -1;
+
+	// While the events are sorted by descending origin time the position
+	// of the first item with a smaller time is searched with a bisection
+	// rather than scanning the whole list which makes loading large
+	// catalogs quadratic.
+	if ( _eventsTimeOrdered ) {
+		int lo = 0, hi = count;
+		while ( lo < hi ) {
+			int mid = lo + (hi-lo)/2;
+			if ( _treeWidget->topLevelItem(mid)->data(col, Qt::UserRole).toDouble() < otime )
+				hi = mid;
+			else
+				lo = mid+1;
+		}
+
+		// The origin time of an event changes with its preferred origin
+		// which can break the order. Fall back to scanning until the
+		// events are sorted by time again.
+		if ( (lo > 0 && _treeWidget->topLevelItem(lo-1)->data(col, Qt::UserRole).toDouble() < otime) ||
+		     (lo < count && _treeWidget->topLevelItem(lo)->data(col, Qt::UserRole).toDouble() >= otime) )
+			_eventsTimeOrdered = false;
+		else
+			pos = lo;
+	}
+
+	if ( pos < 0 ) {
+		pos = count;
+		for ( int i = 0; i < count; ++i ) {
+			if ( _treeWidget->topLevelItem(i)->data(col, Qt::UserRole).toDouble() < otime ) {
 				pos = i;
 				break;
 			}
 		}
-		_treeWidget->insertTopLevelItem(pos, item);
 	}
 
+	_treeWidget->insertTopLevelItem(pos, item);
+
 	item->update(this);
 
 	updateHideState(item);
@@ -4271,51 +4350,35 @@ void EventListView::insertFocalMechanism(Seiscomp::DataModel::FocalMechanism *fm
 }
 
 
-EventTreeItem* EventListView::findEvent(const std::string& publicID) {
-	for ( int i = 0; i < _treeWidget->topLevelItemCount(); ++i ) {
-		SchemeTreeItem* item = (SchemeTreeItem*)_treeWidget->topLevelItem(i);
-		if ( item->object() && item->object()->publicID() == publicID ) {
-			return (EventTreeItem*)item;
-		}
+template <typename T>
+T *EventListView::findItem(const std::string &publicID, int depth) const {
+	// Only items at the given depth are taken into account and if an
+	// object is shown more than once the first item in the tree is
+	// returned as when the tree was scanned
+	SchemeTreeItem *found = NULL;
+	ItemIndex::const_iterator it = _itemIndex.find(publicID.c_str());
+	for ( ; it != _itemIndex.end() && it.key() == publicID.c_str(); ++it ) {
+		if ( itemDepth(it.value()) != depth ) continue;
+		if ( found == NULL || itemPrecedes(it.value(), found) )
+			found = it.value();
 	}
 
-	return NULL;
+	return static_cast<T*>(found);
 }
 
 
-OriginTreeItem* EventListView::findOrigin(const std::string& publicID) {
-	for ( int i = 0; i < _treeWidget->topLevelItemCount(); ++i ) {
-		QTreeWidgetItem* item = _treeWidget->topLevelItem(i);
-		for ( int j = 0; j < item->childCount(); ++j ) {
-			QTreeWidgetItem* citem = item->child(j);
-			for ( int k = 0; k < citem->childCount(); ++k ) {
-				SchemeTreeItem* schemeItem = (SchemeTreeItem*)citem->child(k);
-				if ( schemeItem->object() && schemeItem->object()->publicID() == publicID ) {
-					return (OriginTreeItem*)schemeItem;
-				}
-			}
-		}
-	}
+EventTreeItem* EventListView::findEvent(const std::string& publicID) {
+	return findItem<EventTreeItem>(publicID, 0);
+}
 
-	return NULL;
+
+OriginTreeItem* EventListView::findOrigin(const std::string& publicID) {
+	return findItem<OriginTreeItem>(publicID, 2);
 }
 
 
 FocalMechanismTreeItem* EventListView::findFocalMechanism(const std::string &publicID) {
-	for ( int i = 0; i < _treeWidget->topLevelItemCount(); ++i ) {
-		QTreeWidgetItem* item = _treeWidget->topLevelItem(i);
-		for ( int j = 0; j < item->childCount(); ++j ) {
-			QTreeWidgetItem* citem = item->child(j);
-			for ( int k = 0; k < citem->childCount(); ++k ) {
-				SchemeTreeItem* schemeItem = (SchemeTreeItem*)citem->child(k);
-				if ( schemeItem->object() && schemeItem->object()->publicID() == publicID ) {
-					return (FocalMechanismTreeItem*)schemeItem;
-				}
-			}
-		}
-	}
-
-	return NULL;
+	return findItem<FocalMechanismTreeItem>(publicID, 2);
 }
 
 
@@ -4581,9 +4644,13 @@ void EventListView::sortItems(int col) {
 
 	_treeWidget->blockSignals(true);
 
+	// Take all items at once instead of one by one which would cause the
+	// model to emit a removal for each row
+	QList<QTreeWidgetItem*> children = _treeWidget->invisibleRootItem()->takeChildren();
+
 	QVector<SortItem> items(count);
 	for ( int i = 0; i < items.count(); ++i ) {
-		items[i].first = _treeWidget->takeTopLevelItem(0);
+		items[i].first = children[i];
 		items[i].second = col;
 	}
 
@@ -4601,11 +4668,16 @@ void EventListView::sortItems(int col) {
 		compare = (order == Qt::AscendingOrder ? &itemTextLessThan : &itemTextGreaterThan);
 
 	qStableSort(items.begin(), items.end(), compare);
+	_eventsTimeOrdered = col == _itemConfig.columnMap[COL_OTIME] &&
+	                     order == Qt::DescendingOrder;
 
-	for ( int i = 0; i < items.count(); ++i ) {
-		_treeWidget->addTopLevelItem(items[i].first);
+	for ( int i = 0; i < items.count(); ++i )
+		children[i] = items[i].first;
+
+	_treeWidget->addTopLevelItems(children);
+
+	for ( int i = 0; i < items.count(); ++i )
 		static_cast<SchemeTreeItem*>(items[i].first)->update(this);
-	}
 
 	updateHideState();
 
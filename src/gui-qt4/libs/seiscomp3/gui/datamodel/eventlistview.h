@@ -25,6 +25,7 @@
 #include <seiscomp3/gui/datamodel/ui_eventlistview.h>
 #include <seiscomp3/gui/datamodel/ui_eventlistviewregionfilterdialog.h>
 
+#include <QHash>
 #include <QWidget>
 
 class QTreeWidget;
@@ -57,6 +58,7 @@ namespace Gui {
 
 namespace Private {
 
+class SchemeTreeItem;
 class EventTreeItem;
 class OriginTreeItem;
 class FocalMechanismTreeItem;
@@ -233,6 +235,9 @@ class SC_GUI_API EventListView : public QWidget {
 		Private::OriginTreeItem* findOrigin(const std::string&);
 		Private::FocalMechanismTreeItem* findFocalMechanism(const std::string&);
 
+		template <typename T>
+		T *findItem(const std::string &publicID, int depth) const;
+
 		void removeExpiredEvents();
 		void updateHideState();
 		bool updateHideState(QTreeWidgetItem *item);
@@ -253,8 +258,12 @@ class SC_GUI_API EventListView : public QWidget {
 			QString script;
 		};
 
+		//! Maps publicIDs to the tree items showing the corresponding
+		//! objects. It is maintained by the items themselves.
+		typedef QMultiHash<QString, Private::SchemeTreeItem*> ItemIndex;
+
 		struct ItemConfig {
-			ItemConfig() : createFMLink(false) {}
+			ItemConfig() : createFMLink(false), index(NULL) {}
 
 			QColor                    disabledColor;
 
@@ -273,6 +282,7 @@ class SC_GUI_API EventListView : public QWidget {
 			QHash<QString, int>       eventScriptColumnMap;
 			QSet<int>                 hiddenEventTypes;
 			QSet<QString>             preferredAgencies;
+			ItemIndex                *index;
 		};
 
 		struct Region {
@@ -289,6 +299,7 @@ class SC_GUI_API EventListView : public QWidget {
 		::Ui::EventListView                 _ui;
 		Private::EventFilterWidget         *_filterWidget;
 		ItemConfig                          _itemConfig;
+		ItemIndex                           _itemIndex;
 		FilterRegions                       _filterRegions;
 		QTreeWidget                        *_treeWidget;
 		QTreeWidgetItem                    *_unassociatedEventItem;
@@ -306,6 +317,10 @@ class SC_GUI_API EventListView : public QWidget {
 		//bool                              _withComments;
 		bool                                _blockSelection;
 		bool                                _blockRemovingOfExpiredEvents;
+		//! Whether the top-level items are sorted by descending origin
+		//! time which allows to search the insert position of new events
+		//! with a bisection
+		bool                                _eventsTimeOrdered;
 		bool                                _hideOtherEvents;
 		bool                                _hideForeignEvents;
 		bool                                _hideOutsideRegion;
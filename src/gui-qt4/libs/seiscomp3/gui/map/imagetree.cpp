@@ -17,6 +17,11 @@
 #include <seiscomp3/core/interfacefactory.ipp>
 #include <seiscomp3/logging/log.h>
 
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutexLocker>
+#include <QSet>
+
 #include <cstdio>
 #include <clocale>
 
@@ -111,9 +116,41 @@ const char* generateID(const std::string& pattern, const std::string& id) {
 
 
 
+class TileDirectory;
+
+
+// Loads and decodes a single tile image in a pool thread
+class TileLoadJob : public QRunnable {
+	public:
+		TileLoadJob(TileDirectory *store, Alg::MapTreeNode *node,
+		            const QString &path)
+		: _store(store), _node(node), _path(path) {}
+
+		void run();
+
+	private:
+		TileDirectory    *_store;
+		Alg::MapTreeNode *_node;
+		QString           _path;
+};
+
+
 class TileDirectory : public TileStore {
 	public:
-		TileDirectory() {}
+		TileDirectory(bool asyncLoading) : _asyncLoading(asyncLoading), _closing(false) {
+			// Decoding is mostly I/O bound, a few threads are enough
+			_pool.setMaxThreadCount(2);
+		}
+
+		~TileDirectory() {
+			{
+				QMutexLocker lock(&_requestMutex);
+				_closing = true;
+			}
+
+			// Queued jobs return immediately
+			_pool.waitForDone();
+		}
 
 		bool open(MapsDesc &desc) {
 			_filePattern = desc.location.toStdString();
@@ -136,16 +173,42 @@ class TileDirectory : public TileStore {
 		}
 
 		bool load(QImage &img, Alg::MapTreeNode *node) {
-			return img.load(getID(node));
+			if ( !_asyncLoading )
+				return img.load(getID(node));
+
+			// Return a null image and let the texture cache use the
+			// parent tile until the image is delivered via postLoaded
+			img = QImage();
+
+			QMutexLocker lock(&_requestMutex);
+			if ( !_pendingRequests.contains(node) ) {
+				_pendingRequests.insert(node);
+				_pool.start(new TileLoadJob(this, node, getID(node)));
+			}
+
+			return true;
 		}
 
 		QString getID(const MapTreeNode *node) const {
 			return generatePath(node->level(), node->column(), node->row(), _filePattern);
 		}
 
-		// Tiles are never loaded asynchronously
 		bool hasPendingRequests() const {
-			return false;
+			QMutexLocker lock(&_requestMutex);
+			return !_pendingRequests.isEmpty();
+		}
+
+		// Called from the pool threads
+		bool isClosing() const {
+			QMutexLocker lock(&_requestMutex);
+			return _closing;
+		}
+
+		void loaded(QImage &img, Alg::MapTreeNode *node) {
+			QMutexLocker lock(&_requestMutex);
+			_pendingRequests.remove(node);
+			if ( !_closing && !img.isNull() )
+				postLoaded(img, node);
 		}
 
 		void refresh() {}
@@ -163,10 +226,31 @@ class TileDirectory : public TileStore {
 		}
 
 	private:
-		std::string _filePattern;
+		std::string                  _filePattern;
+		bool                         _asyncLoading;
+		bool                         _closing;
+		mutable QMutex               _requestMutex;
+		QSet<Alg::MapTreeNode*>      _pendingRequests;
+		QThreadPool                  _pool;
 };
 
 
+void TileLoadJob::run() {
+	QImage img;
+
+	if ( !_store->isClosing() ) {
+		// Decode and convert the image here to keep the GUI thread free
+		// from it
+		if ( img.load(_path) &&
+		     img.format() != QImage::Format_RGB32 &&
+		     img.format() != QImage::Format_ARGB32 )
+			img = img.convertToFormat(QImage::Format_ARGB32);
+	}
+
+	_store->loaded(img, _node);
+}
+
+
 }
 
 
@@ -187,6 +271,21 @@ void TileStore::finishedLoading(QImage &img, Alg::MapTreeNode *node) {
 }
 
 
+void TileStore::postLoaded(const QImage &img, Alg::MapTreeNode *node) {
+	bool notify;
+
+	{
+		QMutexLocker lock(&_loadedMutex);
+		_loadedTiles.append(LoadedTile(img, node));
+		// Only the first tile of a batch triggers a delivery
+		notify = _loadedTiles.size() == 1;
+	}
+
+	if ( notify && _tree != NULL )
+		QMetaObject::invokeMethod(_tree, "deliverLoadedTiles", Qt::QueuedConnection);
+}
+
+
 void TileStore::invalidate(Alg::MapTreeNode *node) {
 	if ( _tree != NULL )
 		_tree->invalidate(node);
@@ -194,8 +293,10 @@ void TileStore::invalidate(Alg::MapTreeNode *node) {
 
 
 ImageTree::ImageTree(const MapsDesc &meta) {
+	_asyncLoading = meta.asyncLoading;
+
 	if ( meta.type.isEmpty() )
-		_store = new TileDirectory;
+		_store = new TileDirectory(_asyncLoading);
 	else
 		_store = TileStoreFactory::Create(meta.type.toLatin1());
 
@@ -236,6 +337,8 @@ TextureCache *ImageTree::getCache() {
 		_cache = new TextureCache(_store.get(), _isMercatorProjected);
 		if ( _cacheSize > 0 )
 			_cache->setCacheLimit(_cacheSize);
+		// Prefetching is only useful if it does not block the GUI thread
+		_cache->setPrefetchEnabled(_asyncLoading);
 	}
 
 	return _cache.get();
@@ -259,6 +362,29 @@ void ImageTree::finishedLoading(QImage &img, Alg::MapTreeNode *node) {
 }
 
 
+void ImageTree::deliverLoadedTiles() {
+	if ( !_store ) return;
+
+	QList<TileStore::LoadedTile> tiles;
+
+	{
+		QMutexLocker lock(&_store->_loadedMutex);
+		tiles.swap(_store->_loadedTiles);
+	}
+
+	if ( !_cache || tiles.isEmpty() ) return;
+
+	for ( int i = 0; i < tiles.size(); ++i )
+		_cache->setTexture(tiles[i].first, tiles[i].second);
+
+	// Notify once per batch and not per tile to avoid excessive repaints
+	tilesUpdated();
+
+	if ( !hasPendingRequests() )
+		tilesComplete();
+}
+
+
 void ImageTree::invalidate(Alg::MapTreeNode *node) {
 	if ( _cache ) _cache->invalidateTexture(node);
 }
@@ -15,6 +15,10 @@
 #define __SEISCOMP_GUI_MAP_IMAGETREE_H__
 
 
+#include <QMutex>
+#include <QList>
+#include <QPair>
+
 #ifndef Q_MOC_RUN
 #include <seiscomp3/core/interfacefactory.h>
 #endif
@@ -63,12 +67,27 @@ class SC_GUI_API TileStore : public Alg::MapTree {
 		//! Async notification that a tile has been loaded.
 		void finishedLoading(QImage &img, Alg::MapTreeNode *node);
 
+		//! Thread-safe variant of finishedLoading which can be called
+		//! from any thread, e.g. a loader thread. The image is delivered
+		//! to the image tree in its thread.
+		void postLoaded(const QImage &img, Alg::MapTreeNode *node);
+
 		//! Invalidates the tile of a particular node
 		void invalidate(Alg::MapTreeNode *node);
 
 
 	protected:
 		ImageTree *_tree;
+
+
+	private:
+		typedef QPair<QImage, Alg::MapTreeNode*> LoadedTile;
+
+		QMutex            _loadedMutex;
+		QList<LoadedTile> _loadedTiles;
+
+
+	friend class ImageTree;
 };
 
 
@@ -109,6 +128,11 @@ class SC_GUI_API ImageTree : public QObject, public Core::BaseObject {
 		void invalidate(Alg::MapTreeNode *node);
 
 
+	private slots:
+		//! Delivers all tiles posted by the store with postLoaded
+		void deliverLoadedTiles();
+
+
 	signals:
 		void tilesUpdated();
 
@@ -122,6 +146,7 @@ class SC_GUI_API ImageTree : public QObject, public Core::BaseObject {
 		TextureCachePtr  _cache;
 		TileStorePtr     _store;
 		bool             _isMercatorProjected;
+		bool             _asyncLoading;
 		size_t           _cacheSize;
 
 
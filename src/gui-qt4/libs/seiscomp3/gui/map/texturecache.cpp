@@ -97,6 +97,8 @@ TextureCache::TextureCache(TileStore *tree, bool mercatorProjected) {
 	_lastTile[0] = _lastTile[1] = NULL;
 	_currentIndex = 0;
 	_currentTick = 0;
+	_prefetch = false;
+	_paintLevel = _lastPaintLevel = -1;
 }
 
 
@@ -113,6 +115,74 @@ TextureCache::~TextureCache() {
 
 
 void TextureCache::beginPaint() {
+	_lastPaintLevel = _paintLevel;
+	for ( int i = 0; i < 4; ++i )
+		_lastPaintRange[i] = _paintRange[i];
+
+	_paintLevel = -1;
+}
+
+
+void TextureCache::endPaint() {
+	if ( !_prefetch || _paintLevel < 0 || _paintLevel != _lastPaintLevel )
+		return;
+
+	// Direction of the movement in tile units
+	int dRow = (_paintRange[0] + _paintRange[1]) - (_lastPaintRange[0] + _lastPaintRange[1]);
+	int dCol = (_paintRange[2] + _paintRange[3]) - (_lastPaintRange[2] + _lastPaintRange[3]);
+
+	// Columns wrap around the dateline, a jump by more than the visible
+	// range is not a movement
+	if ( qAbs(dCol) > 2*(_paintRange[3] - _paintRange[2] + 1) ) dCol = 0;
+
+	if ( dRow != 0 ) {
+		int row = dRow > 0 ? _paintRange[1]+1 : _paintRange[0]-1;
+		for ( int col = _paintRange[2]; col <= _paintRange[3]; ++col )
+			prefetch(_paintLevel, row, col);
+	}
+
+	if ( dCol != 0 ) {
+		int col = dCol > 0 ? _paintRange[3]+1 : _paintRange[2]-1;
+		for ( int row = _paintRange[0]; row <= _paintRange[1]; ++row )
+			prefetch(_paintLevel, row, col);
+	}
+}
+
+
+void TextureCache::setPrefetchEnabled(bool enable) {
+	_prefetch = enable;
+}
+
+
+void TextureCache::prefetch(int level, int row, int column) {
+	int tiles = 1 << level;
+	if ( row < 0 || row >= tiles ) return;
+
+	column %= tiles;
+	if ( column < 0 ) column += tiles;
+
+	TextureID id(level, row, column);
+	if ( _firstLevel.contains(id) ) return;
+
+	Alg::MapTreeNode *node = getNode(_mapTree, id);
+	// The tile does not exist at the requested level
+	if ( node == NULL || node->level() != level ) return;
+
+	Storage::iterator it = _storage.find(node);
+	if ( it != _storage.end() ) {
+		_firstLevel[id] = it.value().get();
+		return;
+	}
+
+	Texture *tex = new Texture;
+	tex->load(this, node);
+	tex->lastUsed = _currentTick;
+
+	_storage[node] = tex;
+	_storedBytes += tex->numBytes();
+	_firstLevel[id] = tex;
+
+	checkResources(tex);
 }
 
 
@@ -179,8 +249,15 @@ bool TextureCache::load(QImage &img, Alg::MapTreeNode *node) {
 
 void TextureCache::checkResources(Texture *tex) {
 	//if ( _textureCountLimit <= 0 || _storage.size () < _textureCountLimit ) return;
-	if ( _storedBytes <= _textureCacheLimit ) return;
+	// Evict least recently used textures until the cache fits into its
+	// limit again
+	while ( _storedBytes > _textureCacheLimit && _storage.size() > 1 ) {
+		if ( !removeLeastRecentlyUsed(tex) ) break;
+	}
+}
 
+
+bool TextureCache::removeLeastRecentlyUsed(Texture *tex) {
 	qint64 min = _currentTick;
 	Storage::iterator it, min_it = _storage.end();
 	for ( it = _storage.begin(); it != _storage.end(); ++it ) {
@@ -210,7 +287,11 @@ void TextureCache::checkResources(Texture *tex) {
 
 		if ( _lastTile[1] == min_tex.get() )
 			_lastTile[1] = NULL;
+
+		return true;
 	}
+
+	return false;
 }
 
 
@@ -240,7 +321,11 @@ void TextureCache::setTexture(QImage &img, Alg::MapTreeNode *node) {
 			tex->setImage(img);
 			_storedBytes += tex->numBytes();
 
-			checkResources();
+			// The last tiles could refer to a parent texture used in
+			// place of the formerly dummy texture
+			_lastTile[0] = _lastTile[1] = NULL;
+
+			checkResources(tex);
 		}
 	}
 }
@@ -294,6 +379,7 @@ void TextureCache::clear() {
 	_lastTile[0] = _lastTile[1] = NULL;
 	_currentIndex = 0;
 	_currentTick = 0;
+	_paintLevel = _lastPaintLevel = -1;
 }
 
 
@@ -388,6 +474,18 @@ Texture *TextureCache::get(const TextureID &id) {
 
 	tex->lastUsed = _currentTick;
 
+	if ( id.level > _paintLevel ) {
+		_paintLevel = id.level;
+		_paintRange[0] = _paintRange[1] = id.row;
+		_paintRange[2] = _paintRange[3] = id.column;
+	}
+	else if ( id.level == _paintLevel ) {
+		if ( id.row < _paintRange[0] ) _paintRange[0] = id.row;
+		if ( id.row > _paintRange[1] ) _paintRange[1] = id.row;
+		if ( id.column < _paintRange[2] ) _paintRange[2] = id.column;
+		if ( id.column > _paintRange[3] ) _paintRange[3] = id.column;
+	}
+
 	// If its a dummy texture then travel up the parent chain to check
 	// for valid textures
 	if ( tex->isDummy ) {
@@ -116,6 +116,16 @@ class SC_GUI_API TextureCache : public Core::BaseObject {
 
 		void beginPaint();
 
+		//! Finishes a paint cycle. If prefetching is enabled then the
+		//! tiles adjacent to the painted area in the direction of the
+		//! movement since the last paint are requested.
+		void endPaint();
+
+		//! Enables prefetching of tiles in endPaint. This is only
+		//! useful with tile stores that load asynchronously.
+		void setPrefetchEnabled(bool enable);
+		bool isPrefetchEnabled() const { return _prefetch; }
+
 		void setCacheLimit(int limit);
 		void setCurrentTime(const Core::Time &t);
 
@@ -150,6 +160,10 @@ class SC_GUI_API TextureCache : public Core::BaseObject {
 		getNode(Alg::MapTreeNode *node, const TextureID &id) const;
 
 		void checkResources(Texture *tex = NULL);
+		bool removeLeastRecentlyUsed(Texture *tex);
+
+		//! Requests a texture without using it for rendering
+		void prefetch(int level, int row, int column);
 
 		static void remove(const QString &name);
 
@@ -170,6 +184,14 @@ class SC_GUI_API TextureCache : public Core::BaseObject {
 		TextureID         _lastId[2];
 		int               _currentIndex;
 
+		// The tile range (min row, max row, min column, max column)
+		// accessed at the highest level of the current and the last paint
+		bool              _prefetch;
+		int               _paintLevel;
+		int               _paintRange[4];
+		int               _lastPaintLevel;
+		int               _lastPaintRange[4];
+
 		typedef QPair<QImage, int> CacheEntry;
 		typedef QMap<QString, CacheEntry> ImageCache;
 
@@ -18,6 +18,7 @@
 #include <seiscomp3/logging/channel.h>
 
 #include <seiscomp3/client/inventory.h>
+#include <seiscomp3/client/queue.ipp>
 
 #include <seiscomp3/datamodel/pick.h>
 #include <seiscomp3/datamodel/origin.h>
@@ -31,6 +32,7 @@
 #include <seiscomp3/processing/amplitudeprocessor.h>
 
 #include <boost/bind.hpp>
+#include <algorithm>
 #include <iomanip>
 
 
@@ -76,6 +78,7 @@ AmpTool::AmpTool(int argc, char **argv) : StreamApplication(argc, argv) {
 	_fetchMissingAmplitudes = true;
 	_minWeight = 0.5;
 	_forceReprocessing = false;
+	_threads = 1;
 
 	setAutoApplyNotifierEnabled(true);
 	setInterpretNotifierEnabled(true);
@@ -187,6 +190,14 @@ bool AmpTool::initConfiguration() {
 	try { _runningAcquisitionTimeout = configGetDouble("amptool.runningAcquisitionTimeout"); }
 	catch ( ... ) {}
 
+	try { _threads = configGetInt("amptool.threads"); }
+	catch ( ... ) {}
+
+	if ( _threads < 1 ) {
+		SEISCOMP_ERROR("amptool.threads must be greater than 0");
+		return false;
+	}
+
 	_dumpRecords = commandline().hasOption("dump-records");
 	_reprocessAmplitudes = commandline().hasOption("reprocess");
 	_forceReprocessing = commandline().hasOption("force");
@@ -427,6 +438,7 @@ bool AmpTool::run() {
 			}
 
 			_reprocessMap.clear();
+			startWorkers();
 			readRecords(false);
 
 			list<AmplitudePtr> updates;
@@ -824,6 +836,7 @@ void AmpTool::process(Origin *origin) {
 
 	SEISCOMP_INFO("Starting timeout monitor");
 	_timer.start();
+	startWorkers();
 	readRecords(false);
 	if ( _timer.isActive() ) _timer.stop();
 }
@@ -1212,8 +1225,6 @@ AmpTool::createAmplitude(const Seiscomp::Processing::AmplitudeProcessor *proc,
 
 	proc->finalizeAmplitude(amp.get());
 
-	logObject(_outputAmps, now);
-
 	return amp;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -1227,9 +1238,26 @@ void AmpTool::emitAmplitude(const AmplitudeProcessor *proc,
 	if ( _dumpRecords && !_originID.empty() )
 		proc->writeData();
 
+	// Called from a worker thread, publish later from the main thread
+	if ( !_workers.empty() ) {
+		queueAmplitude(proc, res, false);
+		return;
+	}
+
 	AmplitudePtr amp = createAmplitude(proc, res);
 	if ( !amp ) return;
 
+	logObject(_outputAmps, Time::GMT());
+	publishAmplitude(proc, amp.get());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::publishAmplitude(const AmplitudeProcessor *proc,
+                               Amplitude *amp) {
 	ProcAmpReuseMap::iterator it = _ampIDReuse.find(proc);
 
 	if ( connection() && !_testMode ) {
@@ -1257,7 +1285,7 @@ void AmpTool::emitAmplitude(const AmplitudeProcessor *proc,
 				nmsg->attach(new Notifier("EventParameters", OP_UPDATE, it->second.get()));
 		}
 		else
-			nmsg->attach(new Notifier("EventParameters", OP_ADD, amp.get()));
+			nmsg->attach(new Notifier("EventParameters", OP_ADD, amp));
 
 		if ( nmsg && !nmsg->empty() )
 			connection()->send(nmsg.get());
@@ -1266,7 +1294,7 @@ void AmpTool::emitAmplitude(const AmplitudeProcessor *proc,
 		cerr << *amp << endl;
 	else if ( _ep ) {
 		if ( it == _ampIDReuse.end() ) {
-			_ep->add(amp.get());
+			_ep->add(amp);
 			SEISCOMP_DEBUG("+ %s  %s", amp->publicID().c_str(), amp->type().c_str());
 		}
 		else {
@@ -1294,7 +1322,7 @@ void AmpTool::emitAmplitude(const AmplitudeProcessor *proc,
 
 	// Store the amplitude for pickID
 	if ( it == _ampIDReuse.end() )
-		feed(amp.get());
+		feed(amp);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -1304,9 +1332,15 @@ void AmpTool::emitAmplitude(const AmplitudeProcessor *proc,
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void AmpTool::storeLocalAmplitude(const Seiscomp::Processing::AmplitudeProcessor *proc,
                                   const Seiscomp::Processing::AmplitudeProcessor::Result &res) {
+	if ( !_workers.empty() ) {
+		queueAmplitude(proc, res, true);
+		return;
+	}
+
 	AmplitudePtr amp = createAmplitude(proc, res);
 	if ( !amp ) return;
 
+	logObject(_outputAmps, Time::GMT());
 	_reprocessMap[amp->type()] = amp;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -1314,6 +1348,142 @@ void AmpTool::storeLocalAmplitude(const Seiscomp::Processing::AmplitudeProcessor
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::queueAmplitude(const AmplitudeProcessor *proc,
+                             const AmplitudeProcessor::Result &res,
+                             bool local) {
+	PendingAmplitude pending;
+	pending.amp = createAmplitude(proc, res);
+	if ( !pending.amp ) return;
+
+	pending.proc = proc;
+	pending.local = local;
+
+	// The processor index is written before the workers start
+	boost::mutex::scoped_lock l(_resultMutex);
+	pending.index = _processorIndex[proc];
+	_pendingAmplitudes.push_back(pending);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::flushAmplitudes() {
+	boost::mutex::scoped_lock l(_resultMutex);
+
+	if ( _pendingAmplitudes.empty() ) return;
+
+	// Publish in the order the processors have been added independent
+	// of the worker that finished first
+	std::stable_sort(_pendingAmplitudes.begin(), _pendingAmplitudes.end());
+
+	for ( PendingAmplitudes::iterator it = _pendingAmplitudes.begin();
+	      it != _pendingAmplitudes.end(); ++it ) {
+		// The object log is not thread-safe and only used from the main
+		// thread
+		logObject(_outputAmps, Time::GMT());
+
+		if ( it->local )
+			_reprocessMap[it->amp->type()] = it->amp;
+		else
+			publishAmplitude(it->proc, it->amp.get());
+	}
+
+	_pendingAmplitudes.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::startWorkers() {
+	if ( _threads <= 1 || _processors.empty() ) return;
+
+	for ( int i = 0; i < _threads; ++i )
+		_workers.push_back(new Worker);
+
+	// All streams of a station are handled by the same worker since
+	// a processor can be registered for more than one component
+	typedef std::map<std::string, Worker*> StationWorkerMap;
+	StationWorkerMap stationWorkers;
+	size_t nextWorker = 0;
+
+	for ( ProcessorMap::iterator it = _processors.begin();
+	      it != _processors.end(); ++it ) {
+		std::string stationID = it->first.substr(0, it->first.find('.', it->first.find('.')+1));
+
+		Worker *&worker = stationWorkers[stationID];
+		if ( worker == NULL )
+			worker = _workers[nextWorker++ % _workers.size()];
+
+		_streamWorkers[it->first] = worker;
+		worker->processors[it->first].swap(it->second);
+
+		for ( ProcessorSlot::iterator pit = worker->processors[it->first].begin();
+		      pit != worker->processors[it->first].end(); ++pit )
+			_processorIndex.insert(ProcessorIndex::value_type(pit->get(), _processorIndex.size()));
+	}
+
+	_processors.clear();
+
+	SEISCOMP_DEBUG("Processing %d stations with %d threads",
+	               (int)stationWorkers.size(), (int)_workers.size());
+
+	for ( Workers::iterator it = _workers.begin(); it != _workers.end(); ++it )
+		(*it)->thread = new boost::thread(boost::bind(&AmpTool::processRecords, this, *it));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::stopWorkers() {
+	if ( _workers.empty() ) return;
+
+	for ( Workers::iterator it = _workers.begin(); it != _workers.end(); ++it ) {
+		(*it)->queue.push(NULL);
+		(*it)->thread->join();
+		delete (*it)->thread;
+	}
+
+	// Hand back the unfinished processors for the report
+	for ( Workers::iterator it = _workers.begin(); it != _workers.end(); ++it ) {
+		for ( ProcessorMap::iterator pit = (*it)->processors.begin();
+		      pit != (*it)->processors.end(); ++pit )
+			_processors[pit->first].swap(pit->second);
+		delete *it;
+	}
+
+	_workers.clear();
+	_streamWorkers.clear();
+
+	flushAmplitudes();
+
+	_processorIndex.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::processRecords(Worker *worker) {
+	try {
+		Record *rec;
+		while ( (rec = worker->queue.pop()) != NULL )
+			handleRecord(worker->processors, rec);
+	}
+	catch ( QueueClosedException & ) {}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool AmpTool::storeRecord(Record *rec) {
 	if ( _firstRecord ) {
@@ -1325,7 +1495,20 @@ bool AmpTool::storeRecord(Record *rec) {
 
 	// This flag is resetted by handleTimeout each second
 	_hasRecordsReceived = true;
-	handleRecord(rec);
+
+	if ( _workers.empty() ) {
+		handleRecord(rec);
+		return true;
+	}
+
+	StreamWorkerMap::iterator it = _streamWorkers.find(rec->streamID());
+	if ( it == _streamWorkers.end() )
+		delete rec;
+	else
+		// Blocks if the worker is busy
+		it->second->queue.push(rec);
+
+	flushAmplitudes();
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -1335,20 +1518,32 @@ bool AmpTool::storeRecord(Record *rec) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void AmpTool::handleRecord(Record *rec) {
+	handleRecord(_processors, rec);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void AmpTool::handleRecord(ProcessorMap &processors, Record *rec) {
 	Seiscomp::RecordPtr tmp(rec);
 
 	std::string streamID = rec->streamID();
 
-	ProcessorMap::iterator slot_it = _processors.find(streamID);
-	if ( slot_it == _processors.end() ) return;
+	ProcessorMap::iterator slot_it = processors.find(streamID);
+	if ( slot_it == processors.end() ) return;
 
 	for ( ProcessorSlot::iterator it = slot_it->second.begin(); it != slot_it->second.end(); ) {
+		// Do not hold the result lock while feeding, the publish
+		// callbacks acquire it
 		(*it)->feed(rec);
 		if ( (*it)->status() == WaveformProcessor::InProgress ) {
 			// processor still needs some time (progress = (*it)->statusValue())
 			++it;
 		}
 		else if ( (*it)->status() == WaveformProcessor::Finished ) {
+			boost::mutex::scoped_lock l(_resultMutex);
 			_result << "   + " << (*it)->type() << ", " << slot_it->first.c_str() << std::endl;
 			if ( (*it)->noiseOffset() )
 				_result << "     + noiseOffset = " << *(*it)->noiseOffset() << std::endl;
@@ -1363,6 +1558,7 @@ void AmpTool::handleRecord(Record *rec) {
 			it = slot_it->second.erase(it);
 		}
 		else if ( (*it)->isFinished() ) {
+			boost::mutex::scoped_lock l(_resultMutex);
 			_result << "   - " << (*it)->type() << ", " << slot_it->first.c_str() << " ("
 			        << (*it)->status().toString()
 			        << ")" << std::endl;
@@ -1374,7 +1570,7 @@ void AmpTool::handleRecord(Record *rec) {
 	}
 
 	if ( slot_it->second.empty() )
-		_processors.erase(slot_it);
+		processors.erase(slot_it);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -1416,6 +1612,8 @@ void AmpTool::acquisitionFinished() {
 
 	SEISCOMP_INFO("Closed stream");
 
+	stopWorkers();
+
 	_report << " + Data request: finished" << std::endl;
 
 	for ( ProcessorMap::iterator slot_it = _processors.begin();
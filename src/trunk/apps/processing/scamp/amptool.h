@@ -17,6 +17,7 @@
 #define __SEISCOMP_APPLICATIONS_AMPTOOL_H__
 
 #include <seiscomp3/client/streamapplication.h>
+#include <seiscomp3/client/queue.h>
 #include <seiscomp3/processing/amplitudeprocessor.h>
 #include <seiscomp3/datamodel/publicobjectcache.h>
 #include <seiscomp3/datamodel/eventparameters.h>
@@ -27,8 +28,10 @@
 #include <seiscomp3/logging/log.h>
 
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <map>
 #include <sstream>
+#include <vector>
 
 
 namespace Seiscomp {
@@ -99,6 +102,9 @@ class AmpTool : public Seiscomp::Client::StreamApplication {
 		void storeLocalAmplitude(const Seiscomp::Processing::AmplitudeProcessor *,
 		                         const Seiscomp::Processing::AmplitudeProcessor::Result &);
 
+		void publishAmplitude(const Seiscomp::Processing::AmplitudeProcessor *,
+		                      Seiscomp::DataModel::Amplitude *amp);
+
 		void removedFromCache(Seiscomp::DataModel::PublicObject *);
 
 		void printReport();
@@ -128,6 +134,44 @@ class AmpTool : public Seiscomp::Client::StreamApplication {
 		typedef std::map<std::string, Seiscomp::Util::KeyValuesPtr>           ParameterMap;
 		typedef std::map<std::string, StationRequest>                         RequestMap;
 
+		// A worker thread owns the processors of a subset of the
+		// stations during acquisition. Records are fed into its queue and
+		// a NULL record terminates it.
+		struct Worker {
+			Worker() : queue(1024), thread(NULL) {}
+
+			Seiscomp::Client::ThreadedQueue<Seiscomp::Record*> queue;
+			ProcessorMap   processors;
+			boost::thread *thread;
+		};
+
+		// An amplitude computed by a worker which is published by the
+		// main thread in processor order
+		struct PendingAmplitude {
+			size_t                                          index;
+			const Seiscomp::Processing::AmplitudeProcessor *proc;
+			Seiscomp::DataModel::AmplitudePtr               amp;
+			bool                                            local;
+
+			bool operator<(const PendingAmplitude &other) const {
+				return index < other.index;
+			}
+		};
+
+		typedef std::vector<Worker*>                                          Workers;
+		typedef std::map<std::string, Worker*>                                StreamWorkerMap;
+		typedef std::map<const Seiscomp::Processing::AmplitudeProcessor*, size_t> ProcessorIndex;
+		typedef std::vector<PendingAmplitude>                                 PendingAmplitudes;
+
+		void startWorkers();
+		void stopWorkers();
+		void processRecords(Worker *worker);
+		void handleRecord(ProcessorMap &processors, Seiscomp::Record *rec);
+		void queueAmplitude(const Seiscomp::Processing::AmplitudeProcessor *,
+		                    const Seiscomp::Processing::AmplitudeProcessor::Result &,
+		                    bool local);
+		void flushAmplitudes();
+
 		typedef std::map<std::string, Seiscomp::Processing::StreamPtr>        StreamMap;
 		typedef Seiscomp::DataModel::PublicObjectTimeSpanBuffer               Cache;
 		typedef Seiscomp::DataModel::EventParametersPtr                       EventParametersPtr;
@@ -137,6 +181,7 @@ class AmpTool : public Seiscomp::Client::StreamApplication {
 		double                     _fetchMissingAmplitudes;
 		double                     _minWeight;
 		std::string                _originID;
+		int                        _threads;
 		std::string                _strTimeWindowStartTime;
 		std::string                _strTimeWindowEndTime;
 
@@ -168,6 +213,13 @@ class AmpTool : public Seiscomp::Client::StreamApplication {
 		boost::mutex               _acquisitionMutex;
 
 		Seiscomp::Util::StopWatch  _acquisitionTimer;
+
+		// Parallel processing, only used if _threads > 1
+		Workers                    _workers;
+		StreamWorkerMap            _streamWorkers;
+		ProcessorIndex             _processorIndex;
+		PendingAmplitudes          _pendingAmplitudes;
+		boost::mutex               _resultMutex;
 		Seiscomp::Util::StopWatch  _noDataTimer;
 
 		Seiscomp::Logging::Channel *_errorChannel;
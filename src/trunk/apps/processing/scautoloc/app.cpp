@@ -293,6 +293,9 @@ bool App::initConfiguration() {
 	try { _config.pickLogFile = configGetString("autoloc.pickLog"); }
 	catch (...) { _config.pickLogFile = ""; }
 
+	try { _config.gridCacheFile = Environment::Instance()->absolutePath(configGetString("autoloc.gridCache")); }
+	catch (...) {}
+
 	try { _amplTypeSNR = configGetString("autoloc.amplTypeSNR"); } catch (...) {}
 	try { _amplTypeAbs = configGetString("autoloc.amplTypeAbs"); } catch (...) {}
 	try { _stationLocationFile = configGetString("autoloc.stationLocations"); } catch (...) {}
@@ -2796,6 +2796,7 @@ void Autoloc3::setConfig(const Config &config) {
 
 bool Autoloc3::setGridFile(const string &gridfile)
 {
+	_nucleator.setCacheFile(_config.gridCacheFile);
 	if ( ! _nucleator.setGridFile(gridfile))
 		return false;
 	_nucleator._config.maxRadiusFactor = _config.maxRadiusFactor;
@@ -197,6 +197,10 @@ class Autoloc3 {
 			// The station configuration file
 			std::string staConfFile;
 
+			// The file caching the travel time tables of the
+			// nucleator grid, empty if disabled
+			std::string gridCacheFile;
+
 			// misc. experimental options
 			bool aggressivePKP;
 			bool reportAllPhases;
@@ -164,6 +164,7 @@ void Autoloc3::Config::dump() const
 	SEISCOMP_INFO("publicationIntervalPickCount     %d",     publicationIntervalPickCount);
 	SEISCOMP_INFO("reportAllPhases                  %s",     reportAllPhases ? "true":"false");
 	SEISCOMP_INFO("pickLogFile                      %s",     pickLogFile.size() ? pickLogFile.c_str() : "(none)");
+	SEISCOMP_INFO("gridCacheFile                    %s",     gridCacheFile.size() ? gridCacheFile.c_str() : "(none)");
 	SEISCOMP_INFO("dynamicPickThresholdInterval     %g",     dynamicPickThresholdInterval);
 	SEISCOMP_INFO("offline                          %s",     offline ? "true":"false");
 	SEISCOMP_INFO("test                             %s",     test ? "true":"false");
@@ -15,6 +15,7 @@
 #define SEISCOMP_COMPONENT Autoloc
 #include <seiscomp3/logging/log.h>
 #include <seiscomp3/core/strings.h>
+#include <seiscomp3/seismology/ttt.h>
 
 #include <iostream>
 #include <fstream>
@@ -24,6 +25,8 @@
 #include <set>
 #include <list>
 #include <math.h>
+#include <stdint.h>
+#include <string.h>
 using namespace std;
 
 #include "util.h"
@@ -42,6 +45,96 @@ static std::string station_key (const Station *station)
 
 typedef std::set<PickCPtr> PickSet;
 
+
+// The station table cache file starts with a header consisting of
+// the magic, the version and a hash of the grid and the travel times.
+// It is followed by one record per station table. All values are
+// stored in native byte order as the file is a local cache only.
+static const char     cacheMagic[4] = { 'S', 'A', 'G', 'C' };
+static const uint32_t cacheVersion  = 2;
+
+// Version of the travel times stored in the station tables. It must be
+// increased whenever travelTimeP changes its choice of phases.
+static const uint32_t travelTimeVersion = 1;
+
+template <typename T>
+static void writeValue(std::ostream &os, const T &value)
+{
+	os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(std::istream &is, T &value)
+{
+	is.read(reinterpret_cast<char*>(&value), sizeof(T));
+	return is.good();
+}
+
+static void writeString(std::ostream &os, const std::string &str)
+{
+	writeValue(os, uint32_t(str.size()));
+	os.write(str.data(), str.size());
+}
+
+static bool readString(std::istream &is, std::string &str)
+{
+	uint32_t size;
+	if ( ! readValue(is, size) || size > 1024)
+		return false;
+	str.resize(size);
+	if (size > 0)
+		is.read(&str[0], size);
+	return is.good();
+}
+
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t size)
+{
+	const unsigned char *bytes = reinterpret_cast<const unsigned char*>(data);
+	for (size_t i=0; i<size; i++) {
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+// FNV-1a hash of the grid point coordinates and the identity of the
+// travel times. The latter consists of the model name, the version and
+// P travel times at reference distances and depths as the tables of a
+// model can be replaced without renaming it.
+static uint64_t gridHash(const Grid &grid)
+{
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (Grid::const_iterator it=grid.begin(); it!=grid.end(); ++it) {
+		double coords[3] = { (*it)->lat, (*it)->lon, (*it)->dep };
+		hash = fnv1a(hash, coords, sizeof(coords));
+	}
+
+	Seiscomp::TravelTimeTable ttt;
+	const std::string &model = ttt.model();
+	hash = fnv1a(hash, model.data(), model.size());
+	hash = fnv1a(hash, &travelTimeVersion, sizeof(travelTimeVersion));
+
+	const double depths[] = { 10, 300 };
+	const double distances[] = { 1, 30, 90, 150 };
+	for (size_t i=0; i<sizeof(depths)/sizeof(double); i++) {
+		for (size_t j=0; j<sizeof(distances)/sizeof(double); j++) {
+			TravelTime tt;
+			double time = -1;
+			try {
+				// Along the equator the longitude is the distance
+				if (travelTimeP(0, 0, depths[i], 0, distances[j], 0, distances[j], tt))
+					time = tt.time;
+			}
+			catch ( ... ) {}
+			hash = fnv1a(hash, &time, sizeof(time));
+		}
+	}
+
+	return hash;
+}
+
 void Nucleator::setStation(const Station *station)
 {
 	std::string key = station->net + "." + station->code;
@@ -72,7 +165,22 @@ bool GridSearch::init()
 
 bool GridSearch::setGridFile(const std::string &gridfile)
 {
-	return _readGrid(gridfile);
+	if ( ! _readGrid(gridfile))
+		return false;
+
+	_stationTables.clear();
+	_cachedTables.clear();
+
+	if (_cacheFile.empty())
+		return true;
+
+	return _readCache();
+}
+
+
+void GridSearch::setCacheFile(const std::string &cachefile)
+{
+	_cacheFile = cachefile;
 }
 
 
@@ -137,21 +245,13 @@ GridPoint::GridPoint(const Origin &origin)
 
 
 const Origin*
-GridPoint::feed(const Pick* pick)
+GridPoint::feed(const Pick* pick, const StationWrapper *wrapper)
 {
-	// find the station corresponding to the pick
-	const std::string key = station_key(pick->station());
-
-	std::map<std::string, StationWrapperCPtr>::const_iterator
-		xit = _wrappers.find(key);
-	if (xit==_wrappers.end())
-		// this grid cell may be out of range for that station
-		return NULL;
-	StationWrapperCPtr wrapper = (*xit).second;
 	if ( ! wrapper->station ) {
 		// TODO test in Nucleator::feed() and use logging
 		// TODO at this point probably an exception should be thrown
-		SEISCOMP_ERROR("Nucleator: station '%s' not found", key.c_str());
+		SEISCOMP_ERROR("Nucleator: station '%s' not found",
+			       station_key(pick->station()).c_str());
 		return NULL;
 		
 	}
@@ -264,7 +364,7 @@ GridPoint::feed(const Pick* pick)
 			continue;
 		stations.insert(key);
 
-		StationWrapperCPtr sw( _wrappers[key]);
+		StationWrapperCPtr sw = pp.wrapper;
 
 		Arrival arr(pick.get());
 		arr.residual = pp.projectedTime() - otime;
@@ -297,7 +397,7 @@ int GridPoint::cleanup(const Time& minTime)
 }
 
 
-bool GridPoint::setupStation(const Station *station)
+StationWrapper *GridPoint::wrapStation(const Station *station) const
 {
 	double delta=0, az=0, baz=0;
 	delazi(this, station, delta, az, baz);
@@ -306,17 +406,13 @@ bool GridPoint::setupStation(const Station *station)
 	// range for that station - this reduces the memory used by
 	// the grid
 	if ( delta > station->maxNucDist )
-		return false;
+		return NULL;
 
 	TravelTime tt;
 	if ( ! travelTimeP(lat, lon, dep, station->lat, station->lon, 0, delta, tt))
-		return false;
-
-	StationWrapperCPtr sw = new StationWrapper(station, tt.phase, delta, az, tt.time, tt.dtdd);
-	std::string key = station_key (sw->station);
-	_wrappers[key] = sw;
+		return NULL;
 
-	return true;
+	return new StationWrapper(station, tt.phase, delta, az, tt.time, tt.dtdd);
 }
 
 
@@ -527,12 +623,9 @@ bool GridSearch::feed(const Pick *pick)
 
 	// Has the station been configured already? If not, do it now.
 
-	bool stationSetupNeeded = false;
-	if (_configuredStations.find(net_sta) == _configuredStations.end()) {
-		_configuredStations.insert(net_sta);
-		stationSetupNeeded = true;
-		SEISCOMP_DEBUG_S("GridSearch: setting up station " + net_sta);
-	}
+	StationTableMap::const_iterator tit = _stationTables.find(net_sta);
+	const StationTable &table = tit != _stationTables.end() ?
+		tit->second : _setupStation(pick->station());
 
 	std::map<PickSet, OriginPtr> pickSetOriginMap;
 
@@ -546,15 +639,14 @@ bool GridSearch::feed(const Pick *pick)
 	if (pick->id == "20181211.023135.99-AIC-C1.MG02..BHZ")
 		track = true;
 
+	// Only the grid points within range of the station are visited.
 	double maxScore = 0;
-	for (Grid::iterator it=_grid.begin(); it!=_grid.end(); ++it) {
-
-		GridPoint *gp = it->get();
+	size_t count = table.gridIndex.size();
+	for (size_t i=0; i<count; i++) {
 
-		if (stationSetupNeeded)
-			gp->setupStation(pick->station());
+		GridPoint *gp = _grid[table.gridIndex[i]].get();
 
-		const Origin *origin = gp->feed(pick);
+		const Origin *origin = gp->feed(pick, table.wrappers[i].get());
 		if ( ! origin)
 			continue;
 
@@ -708,6 +800,193 @@ bool GridSearch::_readGrid(const std::string &gridfile)
 }
 
 
+const StationTable &GridSearch::_setupStation(const Station *station)
+{
+	const std::string key = station_key(station);
+	StationTable &table = _stationTables[key];
+
+	StationTableMap::iterator cit = _cachedTables.find(key);
+	if (cit != _cachedTables.end()) {
+		const StationTable &cached = cit->second;
+
+		// The cached table can only be used if the station
+		// parameters are still the same
+		if (cached.lat == station->lat && cached.lon == station->lon &&
+		    cached.maxNucDist == station->maxNucDist) {
+			SEISCOMP_DEBUG_S("GridSearch: setting up station " + key + " from cache");
+
+			table = cached;
+			for (size_t i=0; i<table.wrappers.size(); i++) {
+				const StationWrapper *w = table.wrappers[i].get();
+				table.wrappers[i] = new StationWrapper(station, w->phase, w->distance, w->azimuth, w->ttime, w->hslow);
+			}
+
+			_cachedTables.erase(cit);
+			return table;
+		}
+
+		_cachedTables.erase(cit);
+	}
+
+	SEISCOMP_DEBUG_S("GridSearch: setting up station " + key);
+
+	table.lat = station->lat;
+	table.lon = station->lon;
+	table.maxNucDist = station->maxNucDist;
+
+	for (size_t i=0; i<_grid.size(); i++) {
+		StationWrapperCPtr sw = _grid[i]->wrapStation(station);
+		if ( ! sw)
+			continue;
+
+		table.gridIndex.push_back(i);
+		table.wrappers.push_back(sw);
+	}
+
+	if ( ! _cacheFile.empty())
+		_writeCache(key, table);
+
+	return table;
+}
+
+
+bool GridSearch::_readCache()
+{
+	ifstream ifile(_cacheFile.c_str(), ios::in | ios::binary);
+	if ( ! ifile.good() ) {
+		SEISCOMP_DEBUG_S("Creating grid cache " + _cacheFile);
+		return _resetCache();
+	}
+
+	char magic[4];
+	uint32_t version;
+	uint64_t hash;
+
+	ifile.read(magic, 4);
+	if ( ! ifile.good() || memcmp(magic, cacheMagic, 4) != 0 ||
+	     ! readValue(ifile, version) || version != cacheVersion ||
+	     ! readValue(ifile, hash) || hash != gridHash(_grid) ) {
+		SEISCOMP_INFO_S("Grid cache " + _cacheFile + " is outdated, recreating it");
+		return _resetCache();
+	}
+
+	bool complete = false;
+	while ( true ) {
+		std::string key;
+		StationTable table;
+		uint32_t count;
+
+		if ( ! readString(ifile, key) ) {
+			// A clean end of file is only reached if not a
+			// single byte of the next record could be read
+			complete = ifile.eof() && ifile.gcount() == 0;
+			break;
+		}
+
+		if ( ! readValue(ifile, table.lat) ||
+		     ! readValue(ifile, table.lon) ||
+		     ! readValue(ifile, table.maxNucDist) ||
+		     ! readValue(ifile, count) || count > _grid.size() )
+			break;
+
+		table.gridIndex.reserve(count);
+		table.wrappers.reserve(count);
+
+		uint32_t i;
+		for (i=0; i<count; i++) {
+			uint32_t index;
+			float distance, azimuth, ttime, hslow;
+			std::string phase;
+
+			if ( ! readValue(ifile, index) || index >= _grid.size() ||
+			     ! readValue(ifile, distance) ||
+			     ! readValue(ifile, azimuth) ||
+			     ! readValue(ifile, ttime) ||
+			     ! readValue(ifile, hslow) ||
+			     ! readString(ifile, phase) )
+				break;
+
+			table.gridIndex.push_back(index);
+			table.wrappers.push_back(new StationWrapper(NULL, phase, distance, azimuth, ttime, hslow));
+		}
+
+		if (i < count)
+			break;
+
+		// later records supersede earlier ones
+		_cachedTables[key] = table;
+	}
+
+	ifile.close();
+
+	SEISCOMP_DEBUG("read %d station tables from grid cache",
+		       int(_cachedTables.size()));
+
+	if (complete)
+		return true;
+
+	// Rewrite the cache with all valid tables if it was truncated,
+	// e.g. by a crash while writing it
+	SEISCOMP_WARNING_S("Grid cache " + _cacheFile + " is corrupt, rewriting it");
+
+	StationTableMap tables;
+	tables.swap(_cachedTables);
+	if ( ! _resetCache() )
+		return false;
+
+	for (StationTableMap::const_iterator it=tables.begin(); it!=tables.end(); ++it)
+		_writeCache(it->first, it->second);
+
+	tables.swap(_cachedTables);
+	return true;
+}
+
+
+bool GridSearch::_resetCache()
+{
+	ofstream ofile(_cacheFile.c_str(), ios::out | ios::binary | ios::trunc);
+	if ( ! ofile.good() ) {
+		SEISCOMP_ERROR_S("Failed to create grid cache " + _cacheFile);
+		return false;
+	}
+
+	ofile.write(cacheMagic, 4);
+	writeValue(ofile, cacheVersion);
+	writeValue(ofile, gridHash(_grid));
+
+	return ofile.good();
+}
+
+
+bool GridSearch::_writeCache(const std::string &key, const StationTable &table)
+{
+	ofstream ofile(_cacheFile.c_str(), ios::out | ios::binary | ios::app);
+
+	writeString(ofile, key);
+	writeValue(ofile, table.lat);
+	writeValue(ofile, table.lon);
+	writeValue(ofile, table.maxNucDist);
+	writeValue(ofile, uint32_t(table.gridIndex.size()));
+
+	for (size_t i=0; i<table.gridIndex.size(); i++) {
+		const StationWrapper *w = table.wrappers[i].get();
+		writeValue(ofile, uint32_t(table.gridIndex[i]));
+		writeValue(ofile, w->distance);
+		writeValue(ofile, w->azimuth);
+		writeValue(ofile, w->ttime);
+		writeValue(ofile, w->hslow);
+		writeString(ofile, w->phase);
+	}
+
+	if ( ! ofile.good() ) {
+		SEISCOMP_WARNING_S("Failed to write station " + key + " to grid cache " + _cacheFile);
+		return false;
+	}
+
+	return true;
+}
+
+
 void GridSearch::setup()
 {
 //	_relocator.setStations(_stations);
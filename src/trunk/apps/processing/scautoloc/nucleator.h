@@ -53,8 +53,6 @@ class Nucleator
 		StationMap _stations;
 //		double _config_maxDistanceXXL;
 
-		std::set<std::string> _configuredStations;
-
 	public:
 		OriginVector _newOrigins;
 };
@@ -65,6 +63,52 @@ DEFINE_SMARTPOINTER(GridPoint);
 typedef std::vector<GridPointPtr> Grid;
 
 
+// From a GridPoint point of view, a station has a
+// distance, azimuth, traveltime etc. These are stored
+// in StationWrapper, together with the corresponding
+// StationPtr.
+DEFINE_SMARTPOINTER(StationWrapper);
+class StationWrapper  : public Seiscomp::Core::BaseObject {
+public:
+	StationWrapper(const Station *station, const std::string &phase, float distance, float azimuth, float ttime, float hslow)
+		:  station(station), distance(distance), azimuth(azimuth), ttime(ttime), hslow(hslow), phase(phase)  {}
+	StationWrapper(const StationWrapper &other) {
+		station     = other.station;
+		phase       = other.phase;
+		distance    = other.distance;
+		azimuth     = other.azimuth;
+		ttime       = other.ttime;
+		hslow       = other.hslow;
+//			vslow       = other.vslow;
+//			backazimuth = other.backazimuth;
+	}
+	// Since there will be of the order
+	// 10^5 ... 10^6 StationWrapper's,
+	// we need to use floats
+	const Station *station;
+	float distance, azimuth; //, backazimuth;
+	float ttime, hslow; //, vslow;
+	// to further save space, make this a
+	// pointer to a static phase list entry:
+	std::string phase;
+};
+
+// The travel time table of a station, i.e. the indices of all grid
+// points within the maximum nucleation distance of the station and the
+// corresponding StationWrapper's, both in grid order. A pick is only
+// fed into the grid points found in the table of its station.
+class StationTable {
+public:
+	StationTable() : lat(0), lon(0), maxNucDist(0) {}
+
+	// station parameters the table was computed for
+	double lat, lon, maxNucDist;
+
+	std::vector<size_t> gridIndex;
+	std::vector<StationWrapperCPtr> wrappers;
+};
+
+
 class GridSearch : public Nucleator
 {
 	public:
@@ -109,6 +153,10 @@ class GridSearch : public Nucleator
 		void setConfig(const Config &config) { _config = config; }
 		bool setGridFile(const std::string &gridfile);
 
+		// Set the file used to cache the station travel time tables
+		// across restarts. Must be called before setGridFile().
+		void setCacheFile(const std::string &cachefile);
+
 		void setLocatorProfile(const std::string &profile);
 
 	public:
@@ -131,51 +179,33 @@ class GridSearch : public Nucleator
 		virtual void setup();
 
 		// setup a single station - ideally "on the fly"
-		bool _setupStation(const Station *station);
+		const StationTable &_setupStation(const Station *station);
 
 	private:
 		bool _readGrid(const std::string &gridfile);
 
+		bool _readCache();
+		bool _resetCache();
+		bool _writeCache(const std::string &key, const StationTable &table);
+
 	private:
+		typedef std::map<std::string, StationTable> StationTableMap;
+
 		Grid    _grid;
 		Locator _relocator;
 
+		StationTableMap _stationTables;
+
+		// tables read from the cache file but not yet used
+		StationTableMap _cachedTables;
+		std::string _cacheFile;
+
 		bool _abort;
 
 	public: // FIXME
 		Config  _config;
 };
 
-// From a GridPoint point of view, a station has a
-// distance, azimuth, traveltime etc. These are stored
-// in StationWrapper, together with the corresponding
-// StationPtr.
-DEFINE_SMARTPOINTER(StationWrapper);
-class StationWrapper  : public Seiscomp::Core::BaseObject {
-public:
-	StationWrapper(const Station *station, const std::string &phase, float distance, float azimuth, float ttime, float hslow)
-		:  station(station), distance(distance), azimuth(azimuth), ttime(ttime), hslow(hslow), phase(phase)  {}
-	StationWrapper(const StationWrapper &other) {
-		station     = other.station;
-		phase       = other.phase;
-		distance    = other.distance;
-		azimuth     = other.azimuth;
-		ttime       = other.ttime;
-		hslow       = other.hslow;
-//			vslow       = other.vslow;
-//			backazimuth = other.backazimuth;
-	}
-	// Since there will be of the order
-	// 10^5 ... 10^6 StationWrapper's,
-	// we need to use floats
-	const Station *station;
-	float distance, azimuth; //, backazimuth;
-	float ttime, hslow; //, vslow;
-	// to further save space, make this a
-	// pointer to a static phase list entry:
-	std::string phase;
-};
-
 // A Pick projected in back time, corresponding
 // to the grid point location
 //DEFINE_SMARTPOINTER(ProjectedPick);
@@ -213,13 +243,13 @@ class GridPoint : public Hypocenter
 		// grid point based on an existing origin (to get the aftershocks)
 		GridPoint(const Origin &);
 		~GridPoint() {
-			_wrappers.clear();
 			_picks.clear();
 		}
 
 	public:
-		// feed a new pick and perhaps get a new origin
-		const Origin* feed(const Pick*);
+		// feed a new pick of the station wrapped by the StationWrapper
+		// and perhaps get a new origin
+		const Origin* feed(const Pick*, const StationWrapper*);
 
 		// remove all picks older than tmin
 		int cleanup(const Time& minTime);
@@ -227,7 +257,9 @@ class GridPoint : public Hypocenter
 	public:
 //		void setStations(const StationMap *stations);
 
-		bool setupStation(const Station *station);
+		// compute the StationWrapper of a station or return NULL if
+		// the grid point is out of range for that station
+		StationWrapper *wrapStation(const Station *station) const;
 
 	public: // private:
 		// config
@@ -240,7 +272,6 @@ class GridPoint : public Hypocenter
 		int _nminPrelim;
 
 	private:
-		std::map<std::string, StationWrapperCPtr> _wrappers;
 		std::multiset<ProjectedPick>          _picks;
 		OriginPtr _origin;
 };
@@ -52,6 +52,7 @@ Picker::Config::Config() {
 
 	defaultTimeCorrection = Core::TimeSpan(-0.8);
 	ringBufferSize = Core::TimeSpan(5.*60.);
+	processingThreads = 1;
 	leadTime = 60.;
 	initTime = 60.;
 
@@ -91,6 +92,8 @@ void Picker::Config::init(const Client::Application *app) {
 	catch (...) {}
 	try { ringBufferSize = app->configGetDouble("ringBufferSize"); }
 	catch (...) {}
+	try { processingThreads = app->configGetInt("threads"); }
+	catch (...) {}
 	try { leadTime = app->configGetDouble("leadTime"); }
 	catch (...) {}
 	try { initTime = app->configGetDouble("initTime"); }
@@ -203,6 +206,7 @@ void Picker::Config::dump() const {
 	printf("amplitudeMinOffset               %.2fs\n", amplitudeMinOffset);
 	printf("defaultTimeCorrection            %.2fs\n", defaultTimeCorrection);
 	printf("ringBufferSize                   %.0fs\n", ringBufferSize);
+	printf("threads                          %d\n",    processingThreads);
 	printf("leadTime                         %.0fs\n", leadTime);
 	printf("initTime                         %.0fs\n", initTime);
 	printf("pickerType                       %s\n",    pickerType.c_str());
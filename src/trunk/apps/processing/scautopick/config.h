@@ -116,6 +116,10 @@ class Config {
 		// The global record ringbuffer size in seconds.
 		double      ringBufferSize;
 
+		// The number of threads feeding the processors. The stations
+		// are distributed over the threads.
+		int         processingThreads;
+
 		// The timespan in seconds that will be substracted from
 		// NOW to acquire records.
 		double      leadTime;
@@ -201,6 +201,7 @@ void App::createCommandLineDescription() {
 	commandline().addOption("Settings", "filter", "The filter used for picking", &_config.defaultFilter, false);
 	commandline().addOption("Settings", "time-correction", "The time correction in seconds for a pick", &_config.defaultTimeCorrection);
 	commandline().addOption("Settings", "buffer-size", "The waveform ringbuffer size in seconds", &_config.ringBufferSize);
+	commandline().addOption("Settings", "threads", "The number of processing threads", &_config.processingThreads);
 	commandline().addOption("Settings", "before", "The timespan in seconds before now to start picking", &_config.leadTime);
 	commandline().addOption("Settings", "init-time", "The initialization (inactive) time after the first record arrived per trace", &_config.initTime);
 
@@ -239,6 +240,11 @@ bool App::validateParameters() {
 		return false;
 	}
 
+	if ( _config.processingThreads < 1 ) {
+		cerr << "The number of threads must be at least 1" << endl;
+		return false;
+	}
+
 	if ( _config.triggerDeadTime < 0 ) {
 		cerr << "The trigger dead-time must not be negative" << endl;
 		return false;
@@ -300,6 +306,7 @@ bool App::init() {
 	);
 
 	streamBuffer().setTimeSpan(_config.ringBufferSize);
+	setProcessingThreads(_config.processingThreads);
 
 	if ( commandline().hasOption("playback") )
 		_config.playback = true;
@@ -544,13 +551,17 @@ bool App::run() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void App::done() {
-	if ( _ep ) {
-		IO::XMLArchive ar;
-		ar.create("-");
-		ar.setFormattedOutput(true);
-		ar << _ep;
-		ar.close();
-		_ep = NULL;
+	{
+		boost::recursive_mutex::scoped_lock lock(callbackMutex());
+
+		if ( _ep ) {
+			IO::XMLArchive ar;
+			ar.create("-");
+			ar.setFormattedOutput(true);
+			ar << _ep;
+			ar.close();
+			_ep = NULL;
+		}
 	}
 
 	Processing::Application::done();
@@ -877,7 +888,7 @@ void App::handleNewStream(const Record *rec) {
 		if ( !initDetector(rec->streamID(), waveformStreamID(rec), rec->startTime()) ) {
 			SEISCOMP_ERROR("%s: initialization failed: abort operation",
 			               rec->streamID().c_str());
-			exit(1);
+			postNotification(ExitFailure);
 		}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -933,7 +944,7 @@ bool App::addFeatureExtractor(Seiscomp::DataModel::Pick *pick,
 	FXPtr proc = FXFactory::Create(_config.featureExtractionType.c_str());
 	if ( !proc ) {
 		SEISCOMP_WARNING("Could not create fx: %s", _config.featureExtractionType.c_str());
-		this->exit(1);
+		postNotification(ExitFailure);
 		return false;
 	}
 
@@ -1012,7 +1023,7 @@ void App::addSecondaryPicker(const Core::Time &onset, const Record *rec, const s
 	SecondaryPickerPtr proc = SecondaryPickerFactory::Create(_config.secondaryPickerType.c_str());
 	if ( proc == NULL ) {
 		SEISCOMP_WARNING("Could not create secondary picker: %s", _config.secondaryPickerType.c_str());
-		this->exit(1);
+		postNotification(ExitFailure);
 		return;
 	}
 
@@ -1212,6 +1223,8 @@ void App::emitTrigger(const Processing::Detector *pickProc,
 void App::emitPPick(const Processing::Picker *proc,
                     const Processing::Picker::Result &res)
 {
+	boost::recursive_mutex::scoped_lock lock(callbackMutex());
+
 	PickMap::iterator it = _lastPicks.find(res.record->streamID());
 	if ( it != _lastPicks.end() ) {
 		if ( it->second->time().value() == res.time ) {
@@ -1343,6 +1356,8 @@ void App::emitPPick(const Processing::Picker *proc,
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void App::emitSPick(const Processing::SecondaryPicker *proc,
                     const Processing::SecondaryPicker::Result &res) {
+	boost::recursive_mutex::scoped_lock lock(callbackMutex());
+
 	DataModel::PickPtr pick;
 	if ( hasCustomPublicIDPattern() ) {
 		pick = DataModel::Pick::Create();
@@ -1417,6 +1432,8 @@ void App::emitSPick(const Processing::SecondaryPicker *proc,
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void App::emitDetection(const Processing::Detector *proc, const Record *rec, const Core::Time& time) {
+	boost::recursive_mutex::scoped_lock lock(callbackMutex());
+
 	if ( !_config.pickerType.empty() ) {
 		emitTrigger(proc, rec, time);
 
@@ -1471,6 +1488,8 @@ void App::emitFXPick(Seiscomp::DataModel::PickPtr pick,
                      bool isPrimary,
                      const Processing::FX *proc,
 	                 const Processing::FX::Result &res) {
+	boost::recursive_mutex::scoped_lock lock(callbackMutex());
+
 	proc->finalizePick(pick.get());
 	sendPick(pick.get(), amp.get(), res.record, isPrimary);
 }
@@ -1502,33 +1521,31 @@ void App::sendPick(Seiscomp::DataModel::Pick *pick, DataModel::Amplitude *amp,
 	               pick->waveformID().locationCode().c_str(),
 	               pick->waveformID().channelCode().c_str(),
 	               pick->publicID().c_str());
-	Core::Time now = Core::Time::GMT();
-
-	logObject(_logPicks, now);
-	if ( amp )
-		logObject(_logAmps, now);
 
+	DataModel::NotifierMessagePtr m;
 	if ( connection() && !_config.test ) {
 		DataModel::NotifierPtr n = new DataModel::Notifier("EventParameters", DataModel::OP_ADD, pick);
-		DataModel::NotifierMessagePtr m = new DataModel::NotifierMessage;
+		m = new DataModel::NotifierMessage;
 		m->attach(n.get());
 
 		for ( size_t i = 0; i < pick->commentCount(); ++i ) {
 			n = new DataModel::Notifier(pick->publicID(), DataModel::OP_ADD, pick->comment(i));
 			m->attach(n.get());
 		}
+	}
 
-		connection()->send(m.get());
-		++_sentMessages;
+	postNotification(PickMessage, m.get());
 
-		// Send amplitude
-		if ( amp ) {
-			n = new DataModel::Notifier("EventParameters", DataModel::OP_ADD, amp);
+	// Send amplitude
+	if ( amp ) {
+		m = NULL;
+		if ( connection() && !_config.test ) {
+			DataModel::NotifierPtr n = new DataModel::Notifier("EventParameters", DataModel::OP_ADD, amp);
 			m = new DataModel::NotifierMessage;
 			m->attach(n.get());
-			connection()->send(_config.amplitudeGroup, m.get());
-			++_sentMessages;
 		}
+
+		postNotification(AmplitudeMessage, m.get());
 	}
 
 	if ( _ep ) {
@@ -1553,6 +1570,47 @@ void App::sendPick(Seiscomp::DataModel::Pick *pick, DataModel::Amplitude *amp,
 			}
 		}
 	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool App::dispatchNotification(int type, Core::BaseObject *obj) {
+	switch ( type ) {
+		case ExitFailure:
+			this->exit(1);
+			return true;
+		case PickMessage:
+		case AmplitudeMessage:
+			publish(type, DataModel::NotifierMessage::Cast(obj));
+			return true;
+		default:
+			break;
+	}
+
+	return Processing::Application::dispatchNotification(type, obj);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool App::publish(int type, DataModel::NotifierMessage *msg) {
+	bool sent = false;
+
+	logObject(type == PickMessage ? _logPicks : _logAmps, Core::Time::GMT());
+
+	if ( msg && connection() ) {
+		if ( type == PickMessage )
+			sent = connection()->send(msg);
+		else
+			sent = connection()->send(_config.amplitudeGroup, msg);
+
+		if ( sent ) ++_sentMessages;
+	}
 
 	// Request a sync token every n messages to not flood the message bus
 	// and to prevent a disconnect by the master
@@ -1563,6 +1621,8 @@ void App::sendPick(Seiscomp::DataModel::Pick *pick, DataModel::Amplitude *amp,
 		SEISCOMP_DEBUG("Synchronize with messaging");
 		requestSync();
 	}
+
+	return sent;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -1572,6 +1632,7 @@ void App::sendPick(Seiscomp::DataModel::Pick *pick, DataModel::Amplitude *amp,
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void App::emitAmplitude(const AmplitudeProcessor *ampProc,
                         const AmplitudeProcessor::Result &res) {
+	boost::recursive_mutex::scoped_lock lock(callbackMutex());
 
 	if ( _config.dumpRecords && _config.offline )
 		ampProc->writeData();
@@ -1654,31 +1715,27 @@ void App::emitAmplitude(const AmplitudeProcessor *ampProc,
 #endif
 
 	SEISCOMP_DEBUG("Emit amplitude %s, proc = 0x%lx, %s", amp->publicID().c_str(), (long int)ampProc, ampProc->type().c_str());
-	logObject(_logAmps, now);
 
+	DataModel::NotifierMessagePtr m;
 	if ( connection() && !_config.test ) {
-		DataModel::NotifierPtr n = new DataModel::Notifier("EventParameters", update?DataModel::OP_UPDATE:DataModel::OP_ADD, amp.get());
-		DataModel::NotifierMessagePtr m = new DataModel::NotifierMessage;
+		// The processing thread may update the amplitude while the main
+		// thread is still sending it
+		DataModel::AmplitudePtr sent = amp;
+		if ( processingThreads() > 1 )
+			sent = DataModel::Amplitude::Cast(amp->clone());
+
+		DataModel::NotifierPtr n = new DataModel::Notifier("EventParameters", update?DataModel::OP_UPDATE:DataModel::OP_ADD, sent.get());
+		m = new DataModel::NotifierMessage;
 		m->attach(n.get());
-		if ( !connection()->send(_config.amplitudeGroup, m.get()) && !update ) {
-			ampProc->setUserData(NULL);
-		}
-		else
-			++_sentMessages;
 	}
 
+	if ( processingThreads() > 1 )
+		postNotification(AmplitudeMessage, m.get());
+	else if ( !publish(AmplitudeMessage, m.get()) && m && !update )
+		ampProc->setUserData(NULL);
+
 	if ( _ep )
 		_ep->add(amp.get());
-
-	// Request a sync token every n messages to not flood the message bus
-	// and to prevent a disconnect by the master
-	if ( _sentMessages > MESSAGE_LIMIT ) {
-		_sentMessages = 0;
-		// Tell the record acquisition to request synchronization and to
-		// stop sending records until the sync is completed.
-		SEISCOMP_DEBUG("Synchronize with messaging");
-		requestSync();
-	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -52,6 +52,8 @@ class App : public Processing::Application {
 		bool run();
 		void done();
 
+		bool dispatchNotification(int type, Core::BaseObject *obj);
+
 		void addObject(const std::string& parentID, DataModel::Object* o);
 		void removeObject(const std::string& parentID, DataModel::Object* o);
 		void updateObject(const std::string& parentID, DataModel::Object* o);
@@ -116,8 +118,19 @@ class App : public Processing::Application {
 		              Seiscomp::DataModel::Amplitude *amp,
 		              const Record *rec, bool isPrimary);
 
+		// Logs and sends a message in the main thread and returns
+		// whether it has been sent
+		bool publish(int type, DataModel::NotifierMessage *msg);
+
 
 	private:
+		// Notifications of the processing threads to the main thread
+		enum NotificationType {
+			ExitFailure      = -1,
+			PickMessage      = -2,
+			AmplitudeMessage = -3
+		};
+
 		typedef std::map<std::string, Processing::StreamPtr> StreamMap;
 		typedef std::map<std::string, DataModel::PickPtr> PickMap;
 
@@ -28,20 +28,23 @@ using namespace Seiscomp::Client;
 
 
 EventInformation::EventInformation(Cache *c, Config *cfg_)
-: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false) {
+: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false)
+, pickRevision(0) {
 }
 
 
 EventInformation::EventInformation(Cache *c, Config *cfg_,
                                    DatabaseQuery *q, const string &eventID)
-: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false) {
+: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false)
+, pickRevision(0) {
 	load(q, eventID);
 }
 
 
 EventInformation::EventInformation(Cache *c, Config *cfg_,
                                    DatabaseQuery *q, EventPtr &event)
-: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false) {
+: cache(c), cfg(cfg_), created(false), aboutToBeRemoved(false), dirtyPickSet(false)
+, pickRevision(0) {
 	load(q, event);
 }
 
@@ -139,6 +142,7 @@ size_t EventInformation::matchingPicks(DataModel::DatabaseQuery *q,
 		}
 
 		dirtyPickSet = false;
+		++pickRevision;
 	}
 
 	typedef pair<PickAssociation::const_iterator, PickAssociation::const_iterator> PickRange;
@@ -231,6 +235,8 @@ bool EventInformation::associate(DataModel::Origin *o) {
 		}
 	}
 
+	++pickRevision;
+
 	return true;
 }
 
@@ -403,4 +409,5 @@ bool EventInformation::setEventOpComment(DataModel::JournalEntry *e, string &err
 void EventInformation::insertPick(Pick *p) {
 	string id = p->waveformID().networkCode() + "." + p->waveformID().stationCode();
 	picks.insert(PickAssociation::value_type(id, p));
+	++pickRevision;
 }
@@ -93,6 +93,8 @@ struct EventInformation : public Seiscomp::Core::BaseObject {
 
 	bool                                   aboutToBeRemoved;
 	bool                                   dirtyPickSet;
+	//! Incremented whenever pickIDs or picks change
+	size_t                                 pickRevision;
 };
 
 
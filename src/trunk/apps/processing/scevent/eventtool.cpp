@@ -171,7 +171,8 @@ IMPLEMENT_SC_CLASS_DERIVED(
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-EventTool::EventTool(int argc, char **argv) : Application(argc, argv) {
+EventTool::EventTool(int argc, char **argv)
+: Application(argc, argv), _referenceIndex(this) {
 	_fExpiry = 1.0; // one hour cache initially
 
 	setAutoApplyNotifierEnabled(true);
@@ -192,6 +193,8 @@ EventTool::EventTool(int argc, char **argv) : Application(argc, argv) {
 	_infoOutput = new Logging::FileRotatorOutput(Environment::Instance()->logFile("scevent-processing-info").c_str(),
 	                                             60*60*24, 30);
 	_infoOutput->subscribe(_infoChannel);
+
+	Object::RegisterObserver(&_referenceIndex);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -200,6 +203,8 @@ EventTool::EventTool(int argc, char **argv) : Application(argc, argv) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 EventTool::~EventTool() {
+	Object::UnregisterObserver(&_referenceIndex);
+
 	delete _infoChannel;
 	delete _infoOutput;
 }
@@ -801,6 +806,7 @@ void EventTool::cleanUpEventCache() {
 		if ( it->second->aboutToBeRemoved ) {
 			SEISCOMP_DEBUG("... remove event %s from cache",
 			               it->second->event->publicID().c_str());
+			_referenceIndex.remove(it->second.get());
 			_events.erase(it++);
 		}
 		else
@@ -2381,7 +2387,64 @@ EventInformationPtr EventTool::findMatchingEvent(Origin *origin) {
 	EventInformationPtr bestInfo = NULL;
 	EventMap::iterator it;
 
+	// Select the candidates that can match at all: events sharing at least
+	// one pick (or station if pick times are compared) with the origin and
+	// events within the configured time window. If no matching picks are
+	// required, every event is a candidate.
+	IDSet candidates;
+	bool allEvents = _config.minMatchingPicks == 0;
+
+	if ( !allEvents ) {
+		Time originTime = origin->time().value();
+
+		for ( it = _events.begin(); it != _events.end(); ++it ) {
+			EventInformation *info = it->second.get();
+			// Events without preferred origin never match
+			if ( !info->preferredOrigin ) continue;
+
+			// The pick set is going to be rebuilt, check it
+			if ( info->dirtyPickSet ) {
+				candidates.insert(it->first);
+				continue;
+			}
+
+			TimeSpan diffTime = info->preferredOrigin->time().value() - originTime;
+			if ( diffTime.abs() <= _config.maxTimeDiff )
+				candidates.insert(it->first);
+		}
+
+		updatePickIndex();
+
+		for ( size_t i = 0; i < origin->arrivalCount(); ++i ) {
+			Arrival *arr = origin->arrival(i);
+			if ( !arr ) continue;
+
+			PickIndex::iterator pit;
+
+			if ( _config.maxMatchingPicksTimeDiff < 0 )
+				pit = _pickIndex.find(arr->pickID());
+			else {
+				PickPtr pick = _cache.get<Pick>(arr->pickID());
+				if ( !pick ) continue;
+				pit = _pickIndex.find(pick->waveformID().networkCode() + "." +
+				                      pick->waveformID().stationCode());
+			}
+
+			if ( pit == _pickIndex.end() ) continue;
+			candidates.insert(pit->second.begin(), pit->second.end());
+		}
+
+		SEISCOMP_DEBUG("... %lu/%lu cached events are candidates for %s",
+		               (unsigned long)candidates.size(), (unsigned long)_events.size(),
+		               origin->publicID().c_str());
+	}
+
+	// Iterate in event order to select the same best match as if all
+	// events were compared
 	for ( it = _events.begin(); it != _events.end(); ++it ) {
+		if ( !allEvents && candidates.find(it->first) == candidates.end() )
+			continue;
+
 		MatchResult res = compare(it->second.get(), origin);
 		if ( res > bestResult ) {
 			bestResult = res;
@@ -2405,18 +2468,14 @@ EventInformationPtr EventTool::findMatchingEvent(Origin *origin) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 EventInformationPtr EventTool::findAssociatedEvent(DataModel::Origin *origin) {
-	EventMap::iterator it;
-
-	for ( it = _events.begin(); it != _events.end(); ++it ) {
-		if ( it->second->event->originReference(origin->publicID()) != NULL ) {
-			SEISCOMP_DEBUG("... feeding cache with event %s",
-			               it->second->event->publicID().c_str());
-			_cache.feed(it->second->event.get());
-			return it->second;
-		}
+	EventInformation *info = _referenceIndex.findOrigin(origin->publicID());
+	if ( info != NULL ) {
+		SEISCOMP_DEBUG("... feeding cache with event %s",
+		               info->event->publicID().c_str());
+		_cache.feed(info->event.get());
 	}
 
-	return NULL;
+	return info;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -2425,18 +2484,14 @@ EventInformationPtr EventTool::findAssociatedEvent(DataModel::Origin *origin) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 EventInformationPtr EventTool::findAssociatedEvent(DataModel::FocalMechanism *fm) {
-	EventMap::iterator it;
-
-	for ( it = _events.begin(); it != _events.end(); ++it ) {
-		if ( it->second->event->focalMechanismReference(fm->publicID()) != NULL ) {
-			SEISCOMP_DEBUG("... feeding cache with event %s",
-			               it->second->event->publicID().c_str());
-			_cache.feed(it->second->event.get());
-			return it->second;
-		}
+	EventInformation *info = _referenceIndex.findFocalMechanism(fm->publicID());
+	if ( info != NULL ) {
+		SEISCOMP_DEBUG("... feeding cache with event %s",
+		               info->event->publicID().c_str());
+		_cache.feed(info->event.get());
 	}
 
-	return NULL;
+	return info;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -2526,12 +2581,8 @@ Magnitude *EventTool::preferredMagnitude(Origin *origin) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Event *EventTool::getEventForOrigin(const std::string &originID) {
-	EventMap::iterator it;
-	for ( it = _events.begin(); it != _events.end(); ++it ) {
-		Event *evt = it->second->event.get();
-		if ( !evt ) continue;
-		if ( evt->originReference(originID) != NULL ) return evt;
-	}
+	EventInformation *info = _referenceIndex.findOrigin(originID);
+	if ( info != NULL ) return info->event.get();
 
 	return Event::Cast(query()->getEvent(originID));
 }
@@ -2542,12 +2593,8 @@ Event *EventTool::getEventForOrigin(const std::string &originID) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Event *EventTool::getEventForFocalMechanism(const std::string &fmID) {
-	EventMap::iterator it;
-	for ( it = _events.begin(); it != _events.end(); ++it ) {
-		Event *evt = it->second->event.get();
-		if ( !evt ) continue;
-		if ( evt->focalMechanismReference(fmID) != NULL ) return evt;
-	}
+	EventInformation *info = _referenceIndex.findFocalMechanism(fmID);
+	if ( info != NULL ) return info->event.get();
 
 	return Event::Cast(query()->getEventForFocalMechanism(fmID));
 }
@@ -2563,7 +2610,10 @@ void EventTool::cacheEvent(EventInformationPtr info) {
 	               info->event->publicID().c_str());
 
 	// Cache the complete event information
-	_events[info->event->publicID()] = info;
+	EventInformationPtr &entry = _events[info->event->publicID()];
+	if ( entry ) _referenceIndex.remove(entry.get());
+	entry = info;
+	_referenceIndex.add(info.get());
 	// Set the clean-up flag to false
 	info->aboutToBeRemoved = false;
 	// Add the event to the EventParameters
@@ -2612,6 +2662,7 @@ EventInformationPtr EventTool::cachedEvent(const std::string &eventID) {
 bool EventTool::removeCachedEvent(const std::string &eventID) {
 	EventMap::iterator it = _events.find(eventID);
 	if ( it != _events.end() ) {
+		_referenceIndex.remove(it->second.get());
 		_events.erase(it);
 		return true;
 	}
@@ -2622,6 +2673,225 @@ bool EventTool::removeCachedEvent(const std::string &eventID) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::updatePickIndex() {
+	bool byID = _config.maxMatchingPicksTimeDiff < 0;
+
+	EventMap::iterator it = _events.begin();
+	IndexedEvents::iterator iit = _indexedEvents.begin();
+
+	// Both maps are ordered by event ID, walk them in parallel
+	while ( it != _events.end() || iit != _indexedEvents.end() ) {
+		if ( it == _events.end() || (iit != _indexedEvents.end() && iit->first < it->first) ) {
+			// Event is not cached anymore
+			unindexPicks(iit);
+			_indexedEvents.erase(iit++);
+			continue;
+		}
+
+		if ( iit == _indexedEvents.end() || it->first < iit->first )
+			iit = _indexedEvents.insert(iit, IndexedEvents::value_type(it->first, IndexedPicks()));
+
+		IndexedPicks &entry = iit->second;
+		EventInformation *info = it->second.get();
+
+		if ( entry.info != info || entry.revision != info->pickRevision ) {
+			unindexPicks(iit);
+
+			if ( byID )
+				entry.keys.assign(info->pickIDs.begin(), info->pickIDs.end());
+			else {
+				EventInformation::PickAssociation::const_iterator pit;
+				for ( pit = info->picks.begin(); pit != info->picks.end();
+				      pit = info->picks.upper_bound(pit->first) )
+					entry.keys.push_back(pit->first);
+			}
+
+			for ( size_t i = 0; i < entry.keys.size(); ++i )
+				_pickIndex[entry.keys[i]].insert(iit->first);
+
+			entry.info = info;
+			entry.revision = info->pickRevision;
+		}
+
+		++it; ++iit;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::unindexPicks(IndexedEvents::iterator iit) {
+	std::vector<std::string> &keys = iit->second.keys;
+	for ( size_t i = 0; i < keys.size(); ++i ) {
+		PickIndex::iterator pit = _pickIndex.find(keys[i]);
+		if ( pit == _pickIndex.end() ) continue;
+		pit->second.erase(iit->first);
+		if ( pit->second.empty() ) _pickIndex.erase(pit);
+	}
+
+	keys.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::ReferenceIndex::add(EventInformation *info) {
+	Event *evt = info->event.get();
+	if ( evt == NULL ) return;
+
+	for ( size_t i = 0; i < evt->originReferenceCount(); ++i )
+		_origins.insert(ReferenceMap::value_type(evt->originReference(i)->originID(), info));
+
+	for ( size_t i = 0; i < evt->focalMechanismReferenceCount(); ++i )
+		_focalMechanisms.insert(ReferenceMap::value_type(evt->focalMechanismReference(i)->focalMechanismID(), info));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::ReferenceIndex::remove(EventInformation *info) {
+	Event *evt = info->event.get();
+	if ( evt == NULL ) return;
+
+	for ( size_t i = 0; i < evt->originReferenceCount(); ++i )
+		remove(_origins, evt->originReference(i)->originID(), info);
+
+	for ( size_t i = 0; i < evt->focalMechanismReferenceCount(); ++i )
+		remove(_focalMechanisms, evt->focalMechanismReference(i)->focalMechanismID(), info);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventInformation *
+EventTool::ReferenceIndex::findOrigin(const std::string &originID) const {
+	return find(_origins, originID);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventInformation *
+EventTool::ReferenceIndex::findFocalMechanism(const std::string &fmID) const {
+	return find(_focalMechanisms, fmID);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::ReferenceIndex::onObjectAdded(Object *parent, Object *child) {
+	OriginReference *oref = OriginReference::Cast(child);
+	if ( oref != NULL ) {
+		EventInformation *info = cachedEvent(parent);
+		if ( info != NULL )
+			_origins.insert(ReferenceMap::value_type(oref->originID(), info));
+		return;
+	}
+
+	FocalMechanismReference *fmref = FocalMechanismReference::Cast(child);
+	if ( fmref != NULL ) {
+		EventInformation *info = cachedEvent(parent);
+		if ( info != NULL )
+			_focalMechanisms.insert(ReferenceMap::value_type(fmref->focalMechanismID(), info));
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::ReferenceIndex::onObjectRemoved(Object *parent, Object *child) {
+	OriginReference *oref = OriginReference::Cast(child);
+	if ( oref != NULL ) {
+		EventInformation *info = cachedEvent(parent);
+		if ( info != NULL )
+			remove(_origins, oref->originID(), info);
+		return;
+	}
+
+	FocalMechanismReference *fmref = FocalMechanismReference::Cast(child);
+	if ( fmref != NULL ) {
+		EventInformation *info = cachedEvent(parent);
+		if ( info != NULL )
+			remove(_focalMechanisms, fmref->focalMechanismID(), info);
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventInformation *EventTool::ReferenceIndex::cachedEvent(Object *parent) const {
+	Event *evt = Event::Cast(parent);
+	if ( evt == NULL ) return NULL;
+
+	// Only events that are cached are indexed. Other event instances with
+	// the same ID are ignored.
+	EventMap::const_iterator it = _tool->_events.find(evt->publicID());
+	if ( it == _tool->_events.end() || it->second->event.get() != evt )
+		return NULL;
+
+	return it->second.get();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventInformation *
+EventTool::ReferenceIndex::find(const ReferenceMap &map, const std::string &id) const {
+	typedef std::pair<ReferenceMap::const_iterator, ReferenceMap::const_iterator> Range;
+	Range range = map.equal_range(id);
+	EventInformation *info = NULL;
+
+	// Return the event with the lowest ID if several events reference
+	// the same object to be consistent with the order of the event map
+	for ( ReferenceMap::const_iterator it = range.first; it != range.second; ++it ) {
+		if ( info == NULL || it->second->event->publicID() < info->event->publicID() )
+			info = it->second;
+	}
+
+	return info;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventTool::ReferenceIndex::remove(ReferenceMap &map, const std::string &id,
+                                       EventInformation *info) {
+	typedef std::pair<ReferenceMap::iterator, ReferenceMap::iterator> Range;
+	Range range = map.equal_range(id);
+
+	for ( ReferenceMap::iterator it = range.first; it != range.second; ++it ) {
+		if ( it->second == info ) {
+			map.erase(it);
+			return;
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void EventTool::choosePreferred(EventInformation *info, Origin *origin,
                                 DataModel::Magnitude *triggeredMag,
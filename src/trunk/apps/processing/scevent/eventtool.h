@@ -217,6 +217,55 @@ class EventTool : public Application {
 
 		typedef std::map<std::string, EventProcessorPtr> EventProcessors;
 
+		// Maps origin or focal mechanism IDs to the cached events
+		// referencing them
+		typedef std::multimap<std::string, EventInformation*> ReferenceMap;
+
+		// Keeps the reference maps up-to-date while references are added
+		// to or removed from cached events
+		class ReferenceIndex : public DataModel::Observer {
+			public:
+				ReferenceIndex(EventTool *tool) : _tool(tool) {}
+
+				void add(EventInformation *info);
+				void remove(EventInformation *info);
+
+				EventInformation *findOrigin(const std::string &originID) const;
+				EventInformation *findFocalMechanism(const std::string &fmID) const;
+
+			protected:
+				void onObjectAdded(DataModel::Object *parent, DataModel::Object *child);
+				void onObjectRemoved(DataModel::Object *parent, DataModel::Object *child);
+
+			private:
+				EventInformation *cachedEvent(DataModel::Object *parent) const;
+				EventInformation *find(const ReferenceMap &map, const std::string &id) const;
+				void remove(ReferenceMap &map, const std::string &id, EventInformation *info);
+
+			private:
+				EventTool    *_tool;
+				ReferenceMap  _origins;
+				ReferenceMap  _focalMechanisms;
+		};
+
+		// The picks (matching by ID) or stations (matching by pick time)
+		// an event has been indexed with
+		struct IndexedPicks {
+			IndexedPicks() : revision(0) {}
+
+			EventInformationPtr      info;
+			size_t                   revision;
+			std::vector<std::string> keys;
+		};
+
+		typedef std::map<std::string, IndexedPicks> IndexedEvents;
+		typedef std::map<std::string, IDSet> PickIndex;
+
+		//! Updates the pick index of all cached events whose pick sets
+		//! have changed since the last call
+		void updatePickIndex();
+		void unindexPicks(IndexedEvents::iterator it);
+
 		double                        _fExpiry;
 		Cache                         _cache;
 		bool                          _testMode;
@@ -231,6 +280,9 @@ class EventTool : public Application {
 		ScoreProcessorPtr             _score;
 
 		EventMap                      _events;
+		ReferenceIndex                _referenceIndex;
+		IndexedEvents                 _indexedEvents;
+		PickIndex                     _pickIndex;
 		DataModel::EventParametersPtr _ep;
 		DataModel::JournalingPtr      _journal;
 
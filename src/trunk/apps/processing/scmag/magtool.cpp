@@ -1939,8 +1939,6 @@ bool MagTool::feed(DataModel::Amplitude* ampl, bool update) {
 		if ( !computeStationMagnitude(ampl, origin, loc, del, dep, mags) )
 			continue;
 
-		bool updateSummary = false;
-
 		for ( MagnitudeList::const_iterator it = mags.begin(); it != mags.end(); ++it ) {
 			StaMagPtr stationMagnitude = getStationMagnitude(origin, wfid, it->proc->type(), it->value, update);
 			if ( stationMagnitude ) {
@@ -1948,24 +1946,51 @@ bool MagTool::feed(DataModel::Amplitude* ampl, bool update) {
 				stationMagnitude->setAmplitudeID(ampl->publicID());
 				stationMagnitude->setPassedQC(it->passedQC);
 
-				const string &mtype = stationMagnitude->type();
-				bool newInstance;
-				NetMagPtr netMag = getMagnitude(origin, mtype, &newInstance);
-				if ( netMag ) {
-					computeNetworkMagnitude(origin, mtype, netMag);
-					if ( ! newInstance ) netMag->update();
+				// The network magnitude is recomputed with the next flush
+				// to handle a burst of amplitudes for the same origin
+				// only once
+				_pendingMagnitudes[origin].insert(stationMagnitude->type());
+			}
+		}
+	}
 
-					SEISCOMP_INFO("feed(Amplitude): %s Magnitude '%s' for Origin '%s'",
-					              newInstance?"created":"updated", mtype.c_str(), origin->publicID().c_str());
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
-					dumpOrigin(origin);
-					updateSummary = true;
-				}
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MagTool::flush() {
+	if ( _pendingMagnitudes.empty() ) return false;
+
+	PendingMagnitudes pending;
+	pending.swap(_pendingMagnitudes);
+
+	for ( PendingMagnitudes::iterator it = pending.begin(); it != pending.end(); ++it ) {
+		DataModel::Origin *origin = it->first.get();
+		bool updateSummary = false;
+
+		for ( set<string>::iterator tit = it->second.begin(); tit != it->second.end(); ++tit ) {
+			const string &mtype = *tit;
+			bool newInstance;
+			NetMagPtr netMag = getMagnitude(origin, mtype, &newInstance);
+			if ( netMag ) {
+				computeNetworkMagnitude(origin, mtype, netMag);
+				if ( ! newInstance ) netMag->update();
+
+				SEISCOMP_INFO("flush: %s Magnitude '%s' for Origin '%s'",
+				              newInstance?"created":"updated", mtype.c_str(), origin->publicID().c_str());
+
+				updateSummary = true;
 			}
 		}
 
-		if ( updateSummary )
+		if ( updateSummary ) {
+			dumpOrigin(origin);
 			computeSummaryMagnitude(origin);
+		}
 	}
 
 	return true;
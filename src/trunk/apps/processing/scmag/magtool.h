@@ -75,8 +75,12 @@ class MagTool {
 		typedef std::vector<DataModel::OriginPtr> OriginList;
 		typedef std::map<std::string, OriginList> OriginMap;
 
+		// Origin - magnitude types to be recomputed with the next flush
+		typedef std::map<DataModel::OriginPtr, std::set<std::string> > PendingMagnitudes;
+
 		StaAmpMap  _ampl;
 		OriginMap  _orgs;
+		PendingMagnitudes _pendingMagnitudes;
 
 		DataModel::PublicObjectTimeSpanBuffer _objectCache;
 
@@ -111,6 +115,13 @@ class MagTool {
 		bool feed(DataModel::Pick*);
 		bool feed(DataModel::Amplitude*, bool update);
 
+		//! Station magnitudes are updated immediately when an amplitude
+		//! is fed but the affected network and summary magnitudes are
+		//! recomputed only once per origin with this function. It must be
+		//! called after a batch of amplitudes has been fed. Returns true
+		//! if any magnitude has been recomputed.
+		bool flush();
+
 
 	protected:
 		struct MagnitudeEntry {
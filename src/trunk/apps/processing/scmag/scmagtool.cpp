@@ -380,6 +380,8 @@ class MagToolApp : public Seiscomp::Client::Application {
 				for ( size_t i = 0; i < ep->amplitudeCount(); ++i )
 					_magtool.feed(ep->amplitude(i), false);
 
+				_magtool.flush();
+
 				for ( size_t i = 0; i < ep->originCount(); ++i ) {
 					OriginPtr org = ep->origin(i);
 					SEISCOMP_INFO("Processing origin %s", org->publicID().c_str());
@@ -419,6 +421,12 @@ class MagToolApp : public Seiscomp::Client::Application {
 			// will be called
 			Application::handleMessage(msg);
 
+			// Recompute the network magnitudes affected by the amplitudes
+			// of this message
+			Notifier::Enable();
+			_magtool.flush();
+			Notifier::Disable();
+
 			// All message handling is done so lets continue
 			if ( !_interval || _sendImmediately ) {
 				NotifierMessagePtr xmsg = Notifier::GetMessage();
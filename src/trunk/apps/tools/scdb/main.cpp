@@ -16,7 +16,7 @@
 #include <seiscomp3/logging/log.h>
 #include <seiscomp3/client/application.h>
 #include <seiscomp3/communication/servicemessage.h>
-#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
 #include <seiscomp3/utils/timer.h>
 
 
@@ -275,7 +275,7 @@ class DBTool : public Seiscomp::Client::Application {
 
 
 		bool importDatabase() {
-			XMLArchive ar;
+			XMLStreamReader ar;
 			if ( _importFile == "-" )
 				ar.open(std::cin.rdbuf());
 			else if ( !ar.open(_importFile.c_str()) ) {
@@ -294,8 +294,7 @@ class DBTool : public Seiscomp::Client::Application {
 			cout << "Parsing file '" << _importFile << "'..." << endl;
 		
 			Util::StopWatch timer;
-			DataModel::ObjectPtr doc;
-			ar >> doc;
+			DataModel::ObjectPtr doc = ar.read();
 			ar.close();
 		
 			if ( doc == NULL ) {
@@ -15,7 +15,7 @@
 #include <seiscomp3/logging/log.h>
 #include <seiscomp3/client/application.h>
 #include <seiscomp3/communication/servicemessage.h>
-#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
 #include <seiscomp3/utils/timer.h>
 
 #include <seiscomp3/datamodel/databasearchive.h>
@@ -609,7 +609,7 @@ class DispatchTool : public Seiscomp::Client::Application {
 		bool processInput() {
 			PublicObject::SetRegistrationEnabled(false);
 
-			IO::XMLArchive ar;
+			IO::XMLStreamReader ar;
 			if ( !ar.open(_inputFile.c_str()) ) {
 				cout << "Error: could not open input file '" << _inputFile << "'" << endl;
 				return false;
@@ -618,8 +618,7 @@ class DispatchTool : public Seiscomp::Client::Application {
 			cout << "Parsing file '" << _inputFile << "'..." << endl;
 
 			Util::StopWatch timer;
-			ObjectPtr doc;
-			ar >> doc;
+			ObjectPtr doc = ar.read();
 			ar.close();
 
 			PublicObject::SetRegistrationEnabled(true);
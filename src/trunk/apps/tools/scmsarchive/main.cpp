@@ -0,0 +1,20 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#include "scmsarchive.h"
+
+
+int main(int argc, char **argv) {
+	Seiscomp::Applications::MSArchive app(argc, argv);
+	return app();
+}
@@ -0,0 +1,882 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+#define SEISCOMP_COMPONENT SCMSARCHIVE
+
+#define MAX_THREADS 1000
+
+#include <seiscomp3/core/strings.h>
+#include <seiscomp3/core/typedarray.h>
+#include <seiscomp3/io/recordinput.h>
+#include <seiscomp3/io/recordstream.h>
+#include <seiscomp3/logging/log.h>
+#include <seiscomp3/utils/files.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <queue>
+#include <set>
+#include <unistd.h>
+
+#include "scmsarchive.h"
+
+
+using namespace std;
+
+
+namespace Seiscomp {
+namespace Applications {
+
+
+namespace {
+
+
+typedef MSArchive::Entry Entry;
+
+
+bool lessThan(const Entry *a, const Entry *b) {
+	if ( a->time != b->time ) return a->time < b->time;
+	int cmp = a->streamID.compare(b->streamID);
+	if ( cmp != 0 ) return cmp < 0;
+	return a->raw < b->raw;
+}
+
+
+bool equals(const Entry *a, const Entry *b) {
+	return a->time == b->time && a->streamID == b->streamID && a->raw == b->raw;
+}
+
+
+template <typename T>
+void writeValue(ostream &os, const T &v) {
+	os.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+
+template <typename T>
+bool readValue(istream &is, T &v) {
+	return is.read(reinterpret_cast<char*>(&v), sizeof(T)).good();
+}
+
+
+void writeString(ostream &os, const string &str) {
+	uint32_t len = (uint32_t)str.size();
+	writeValue(os, len);
+	os.write(str.data(), len);
+}
+
+
+bool readString(istream &is, string &str) {
+	uint32_t len;
+	if ( !readValue(is, len) ) return false;
+	str.resize(len);
+	return len == 0 || is.read(&str[0], len).good();
+}
+
+
+void writeTime(ostream &os, const Core::Time &t) {
+	int64_t secs = t.seconds();
+	int32_t usecs = t.microseconds();
+	writeValue(os, secs);
+	writeValue(os, usecs);
+}
+
+
+bool readTime(istream &is, Core::Time &t) {
+	int64_t secs;
+	int32_t usecs;
+	if ( !readValue(is, secs) || !readValue(is, usecs) ) return false;
+	t = Core::Time((long)secs, (long)usecs);
+	return true;
+}
+
+
+void writeEntry(ostream &os, const Entry *entry) {
+	writeString(os, entry->streamID);
+	writeTime(os, entry->time);
+	writeTime(os, entry->startTime);
+	writeString(os, entry->raw);
+}
+
+
+bool readEntry(istream &is, Entry &entry) {
+	return readString(is, entry.streamID) &&
+	       readTime(is, entry.time) &&
+	       readTime(is, entry.startTime) &&
+	       readString(is, entry.raw);
+}
+
+
+class MemoryCursor : public MSArchive::Cursor {
+	public:
+		MemoryCursor(const MSArchive::Entries &entries)
+		: _it(entries.begin()), _end(entries.end()) {}
+
+		const Entry *next() {
+			if ( _it == _end ) return NULL;
+			return *_it++;
+		}
+
+	private:
+		MSArchive::Entries::const_iterator _it;
+		MSArchive::Entries::const_iterator _end;
+};
+
+
+class FileCursor : public MSArchive::Cursor {
+	public:
+		FileCursor(const string &file, streamoff offset, size_t count)
+		: _file(file), _remaining(count) {
+			_is.open(file.c_str(), ios_base::in | ios_base::binary);
+			if ( !_is.is_open() || !_is.seekg(offset) ) {
+				SEISCOMP_ERROR("%s: failed to open run", file.c_str());
+				_remaining = 0;
+			}
+		}
+
+		const Entry *next() {
+			if ( _remaining == 0 ) return NULL;
+			--_remaining;
+			if ( !readEntry(_is, _entry) ) {
+				SEISCOMP_ERROR("%s: unexpected end of run", _file.c_str());
+				_remaining = 0;
+				return NULL;
+			}
+			return &_entry;
+		}
+
+	private:
+		string   _file;
+		ifstream _is;
+		size_t   _remaining;
+		Entry    _entry;
+};
+
+
+struct HeapItem {
+	HeapItem(const Entry *e, MSArchive::Cursor *c) : entry(e), cursor(c) {}
+
+	// std::priority_queue is a max heap, invert the order
+	bool operator<(const HeapItem &other) const {
+		return lessThan(other.entry, entry);
+	}
+
+	const Entry       *entry;
+	MSArchive::Cursor *cursor;
+};
+
+
+}
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+MSArchive::MSArchive(int argc, char **argv)
+: Seiscomp::Client::Application(argc, argv) {
+	setMessagingEnabled(false);
+	setDatabaseEnabled(false, false);
+	setDaemonEnabled(false);
+
+	const char *tmp = getenv("TMPDIR");
+	_tmpDir = tmp ? tmp : "/tmp";
+	_threads = 1;
+	_memoryLimit = 256;
+	_sortByEndTime = false;
+	_unique = false;
+	_bufferSize = 0;
+	_error = false;
+	_abort = false;
+	_recordsRead = _recordsWritten = _duplicates = _dropped = 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+MSArchive::~MSArchive() {
+	clearBuffer();
+	removeRuns();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::createCommandLineDescription() {
+	commandline().addGroup("Sort");
+	commandline().addOption("Sort", "time-window,t",
+	                        "Time window to process, records outside are "
+	                        "skipped. Format: start~end",
+	                        &_timeWindow);
+	commandline().addOption("Sort", "sort-by-end-time,E",
+	                        "Sort according to record end time; default is "
+	                        "start time");
+	commandline().addOption("Sort", "uniqueness,u",
+	                        "Skip duplicate records, e.g. records with equal "
+	                        "stream, time and content");
+	commandline().addOption("Sort", "memory,m",
+	                        "Memory in MB used to buffer records before a "
+	                        "sorted run is written to the temporary directory",
+	                        &_memoryLimit);
+	commandline().addOption("Sort", "tmp-dir",
+	                        "Directory for temporary run files",
+	                        &_tmpDir);
+	commandline().addOption("Sort", "threads",
+	                        "Number of threads sorting and merging streams in "
+	                        "parallel (SDS mode only)",
+	                        &_threads);
+
+	commandline().addGroup("Output");
+	commandline().addOption("Output", "archive,a",
+	                        "Root directory of a SDS archive to write the "
+	                        "records to. If not given the sorted records are "
+	                        "written to stdout.",
+	                        &_archive);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::printUsage() const {
+	cout << endl << "Description:" << endl;
+	cout << "  Read unsorted (and possibly multiplexed) MiniSEED files, sort "
+	        "the records" << endl
+	     << "  by time with bounded memory and write them to stdout or into "
+	        "a SDS archive." << endl
+	     << endl << "Synopsis:" << endl
+	     << "  scmsarchive [options] [files | < ] [ > ]" << endl;
+
+	Seiscomp::Client::Application::printUsage();
+
+	cout << "Examples:" << endl;
+	cout << "  cat f1.mseed f2.mseed | scmsarchive -u > sorted.mseed"
+	     << endl << endl
+	     << "  scmsarchive -u -m 1024 --threads 4 -a /data/sds day/*.mseed"
+	     << endl;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::validateParameters() {
+	if ( !Client::Application::validateParameters() ) return false;
+
+	_sortByEndTime = commandline().hasOption("sort-by-end-time");
+	_unique = commandline().hasOption("uniqueness");
+
+	if ( !_timeWindow.empty() ) {
+		vector<string> toks;
+		if ( Core::split(toks, _timeWindow.c_str(), "~") != 2 ||
+		     !Core::fromString(_startTime, Core::trim(toks[0])) ||
+		     !Core::fromString(_endTime, Core::trim(toks[1])) ) {
+			SEISCOMP_ERROR("invalid time window: %s", _timeWindow.c_str());
+			return false;
+		}
+	}
+
+	if ( _memoryLimit < 1 ) {
+		SEISCOMP_ERROR("invalid memory limit, minimum value: 1");
+		return false;
+	}
+
+	if ( _threads < 1 || _threads > MAX_THREADS ) {
+		SEISCOMP_ERROR("invalid number of threads, allowed range: [1,%i]",
+		               MAX_THREADS);
+		return false;
+	}
+
+	if ( !_archive.empty() && _archive[_archive.size()-1] != '/' )
+		_archive += '/';
+
+	if ( !Util::pathExists(_tmpDir) ) {
+		SEISCOMP_ERROR("temporary directory does not exist: %s", _tmpDir.c_str());
+		return false;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::init() {
+	if ( !Client::Application::init() ) return false;
+
+	_files = commandline().unrecognizedOptions();
+	if ( _files.empty() ) _files.push_back("-");
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::run() {
+	for ( size_t i = 0; i < _files.size(); ++i ) {
+		if ( _exitRequested ) return false;
+		if ( !readFile(_files[i]) ) return false;
+	}
+
+	SEISCOMP_INFO("read %lu records, %lu sorted runs written",
+	              (unsigned long)_recordsRead, (unsigned long)_runs.size());
+
+	if ( !merge() ) return false;
+
+	SEISCOMP_INFO("wrote %lu records, skipped %lu duplicates",
+	              (unsigned long)_recordsWritten, (unsigned long)_duplicates);
+
+	if ( _dropped )
+		SEISCOMP_WARNING("dropped %lu records with invalid stream ids",
+		                 (unsigned long)_dropped);
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::exit(int returnCode) {
+	// _exitRequested is not synchronized, the workers poll _abort instead
+	_abort = true;
+	Client::Application::exit(returnCode);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::readFile(const string &file) {
+	IO::RecordStreamPtr stream = IO::RecordStream::Create("file");
+	if ( !stream ) {
+		SEISCOMP_ERROR("failed to create a file record stream");
+		return false;
+	}
+
+	if ( !stream->setSource(file) ) {
+		SEISCOMP_ERROR("%s: failed to open", file.c_str());
+		return false;
+	}
+
+	SEISCOMP_DEBUG("reading %s", file.c_str());
+
+	// The data is only decoded on demand, we only need the raw bytes
+	IO::RecordInput input(stream.get(), Array::INT, Record::SAVE_RAW);
+	RecordPtr rec;
+	while ( (rec = input.next()) != NULL ) {
+		if ( _exitRequested ) return false;
+
+		const Array *raw = rec->raw();
+		if ( raw == NULL ) continue;
+
+		Entry *entry = new Entry;
+		try {
+			if ( _startTime.valid() && rec->endTime() < _startTime ) {
+				delete entry;
+				continue;
+			}
+
+			if ( _endTime.valid() && rec->startTime() > _endTime ) {
+				delete entry;
+				continue;
+			}
+
+			entry->streamID = rec->streamID();
+			entry->startTime = rec->startTime();
+			entry->time = _sortByEndTime ? rec->endTime() : rec->startTime();
+		}
+		catch ( exception &e ) {
+			SEISCOMP_WARNING("%s: invalid record: %s", file.c_str(), e.what());
+			delete entry;
+			continue;
+		}
+
+		entry->raw.assign(static_cast<const char*>(raw->data()),
+		                  raw->size() * raw->elementSize());
+
+		++_recordsRead;
+		if ( !add(entry) ) return false;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::add(Entry *entry) {
+	// In stdout mode all records go into one group to create a global
+	// time order
+	_buffer[_archive.empty() ? string() : entry->streamID].push_back(entry);
+	_bufferSize += entry->memorySize();
+
+	if ( _bufferSize < size_t(_memoryLimit) * 1024 * 1024 )
+		return true;
+
+	return spill();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::nextGroup(Groups::iterator &it) {
+	boost::mutex::scoped_lock lock(_mutex);
+	if ( _error || _nextSortGroup == _buffer.end() ) return false;
+	it = _nextSortGroup++;
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::sortGroups(int) {
+	Groups::iterator it;
+	while ( nextGroup(it) )
+		stable_sort(it->second.begin(), it->second.end(), lessThan);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::sortBuffer() {
+	_nextSortGroup = _buffer.begin();
+
+	int threads = min(_threads, (int)_buffer.size());
+	if ( threads > 1 ) {
+		vector<boost::thread*> workers;
+		for ( int i = 0; i < threads; ++i )
+			workers.push_back(new boost::thread(
+			                  boost::bind(&MSArchive::sortGroups, this, i+1)));
+		for ( size_t i = 0; i < workers.size(); ++i ) {
+			workers[i]->join();
+			delete workers[i];
+		}
+	}
+	else
+		sortGroups(1);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::spill() {
+	sortBuffer();
+
+	Run run;
+	run.file = _tmpDir + "/scmsarchive-" + Core::toString(getpid()) +
+	           "-" + Core::toString(_runs.size()) + ".run";
+
+	ofstream os(run.file.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+	if ( !os.is_open() ) {
+		SEISCOMP_ERROR("%s: failed to create run file", run.file.c_str());
+		return false;
+	}
+
+	// Register the file before writing to clean it up in any case
+	_runs.push_back(run);
+
+	SEISCOMP_DEBUG("writing run %s with %lu bytes of records",
+	               run.file.c_str(), (unsigned long)_bufferSize);
+
+	for ( Groups::iterator it = _buffer.begin(); it != _buffer.end(); ++it ) {
+		_runs.back().segments[it->first] = Segment(os.tellp(), it->second.size());
+		for ( size_t i = 0; i < it->second.size(); ++i )
+			writeEntry(os, it->second[i]);
+	}
+
+	if ( !os.good() ) {
+		SEISCOMP_ERROR("%s: failed to write run file", run.file.c_str());
+		return false;
+	}
+
+	clearBuffer();
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::merge() {
+	// The last buffer is not spilled but merged from memory
+	sortBuffer();
+
+	set<string> groups;
+	for ( Groups::iterator it = _buffer.begin(); it != _buffer.end(); ++it )
+		groups.insert(it->first);
+	for ( size_t i = 0; i < _runs.size(); ++i ) {
+		for ( SegmentIndex::iterator it = _runs[i].segments.begin();
+		      it != _runs[i].segments.end(); ++it )
+			groups.insert(it->first);
+	}
+
+	_groups.assign(groups.begin(), groups.end());
+	_nextMergeGroup = _groups.begin();
+
+	int threads = min(_threads, (int)_groups.size());
+	if ( threads > 1 ) {
+		vector<boost::thread*> workers;
+		for ( int i = 0; i < threads; ++i )
+			workers.push_back(new boost::thread(
+			                  boost::bind(&MSArchive::mergeGroups, this, i+1)));
+		for ( size_t i = 0; i < workers.size(); ++i ) {
+			workers[i]->join();
+			delete workers[i];
+		}
+	}
+	else
+		mergeGroups(1);
+
+	return !_error;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::nextGroup(vector<string>::const_iterator &it) {
+	boost::mutex::scoped_lock lock(_mutex);
+	if ( _error || _nextMergeGroup == _groups.end() ) return false;
+	it = _nextMergeGroup++;
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::mergeGroups(int) {
+	vector<string>::const_iterator it;
+	while ( nextGroup(it) ) {
+		if ( _abort || !mergeGroup(*it) ) {
+			boost::mutex::scoped_lock lock(_mutex);
+			_error = true;
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::mergeGroup(const string &group) {
+	vector<Cursor*> cursors;
+
+	Groups::const_iterator bit = _buffer.find(group);
+	if ( bit != _buffer.end() )
+		cursors.push_back(new MemoryCursor(bit->second));
+
+	for ( size_t i = 0; i < _runs.size(); ++i ) {
+		SegmentIndex::const_iterator sit = _runs[i].segments.find(group);
+		if ( sit == _runs[i].segments.end() ) continue;
+		cursors.push_back(new FileCursor(_runs[i].file, sit->second.offset,
+		                                 sit->second.count));
+	}
+
+	priority_queue<HeapItem> heap;
+	for ( size_t i = 0; i < cursors.size(); ++i ) {
+		const Entry *entry = cursors[i]->next();
+		if ( entry ) heap.push(HeapItem(entry, cursors[i]));
+	}
+
+	bool ok = true;
+	bool hasLast = false;
+	Entry last;
+	size_t written = 0, duplicates = 0;
+	OutputFile out;
+
+	while ( !heap.empty() ) {
+		HeapItem item = heap.top();
+		heap.pop();
+
+		// Duplicates are adjacent since the content is part of the order
+		if ( _unique && hasLast && equals(item.entry, &last) )
+			++duplicates;
+		else {
+			if ( !write(out, item.entry) ) {
+				ok = false;
+				break;
+			}
+
+			++written;
+
+			if ( _unique ) {
+				last = *item.entry;
+				hasLast = true;
+			}
+		}
+
+		const Entry *entry = item.cursor->next();
+		if ( entry ) heap.push(HeapItem(entry, item.cursor));
+	}
+
+	for ( size_t i = 0; i < cursors.size(); ++i )
+		delete cursors[i];
+
+	if ( !closeFile(out, ok) ) ok = false;
+	written -= out.skipped + out.dropped;
+	duplicates += out.skipped;
+
+	if ( _archive.empty() ) cout.flush();
+
+	boost::mutex::scoped_lock lock(_mutex);
+	_recordsWritten += written;
+	_duplicates += duplicates;
+	_dropped += out.dropped;
+
+	return ok;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::write(OutputFile &out, const Entry *entry) {
+	if ( _archive.empty() ) {
+		cout.write(entry->raw.data(), entry->raw.size());
+		return cout.good();
+	}
+
+	// Year/NET/STA/CHA.D/NET.STA.LOC.CHA.D.YEAR.DAY
+	vector<string> toks;
+	if ( Core::split(toks, entry->streamID.c_str(), ".", false) != 4 ) {
+		SEISCOMP_WARNING("invalid stream id: %s", entry->streamID.c_str());
+		++out.dropped;
+		return true;
+	}
+
+	string year = entry->startTime.toString("%Y");
+	string dir = _archive + year + "/" + toks[0] + "/" + toks[1] + "/" +
+	             toks[3] + ".D/";
+	string file = dir + entry->streamID + ".D." + year + "." +
+	              entry->startTime.toString("%j");
+
+	if ( file != out.file ) {
+		if ( !closeFile(out, true) ) return false;
+
+		if ( !Util::pathExists(dir) && !Util::createPath(dir) ) {
+			SEISCOMP_ERROR("failed to create directory: %s", dir.c_str());
+			return false;
+		}
+
+		if ( !openFile(out, file) ) return false;
+	}
+
+	// Interleave the existing records to keep the file sorted
+	for ( ; out.next < out.existing.size(); ++out.next ) {
+		const Entry *existing = out.existing[out.next];
+		if ( !lessThan(existing, entry) ) {
+			if ( equals(existing, entry) ) {
+				++out.skipped;
+				return true;
+			}
+			break;
+		}
+
+		out.stream.write(existing->raw.data(), existing->raw.size());
+	}
+
+	out.stream.write(entry->raw.data(), entry->raw.size());
+	return out.stream.good();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::openFile(OutputFile &out, const string &file) {
+	out.file = file;
+	out.tmpFile.clear();
+	out.next = 0;
+
+	if ( !Util::fileExists(file) ) {
+		out.stream.open(file.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+		if ( !out.stream.is_open() ) {
+			SEISCOMP_ERROR("failed to open file: %s", file.c_str());
+			return false;
+		}
+
+		return true;
+	}
+
+	// Appending would break the time order and duplicate records written
+	// by a previous run. The merged file is written next to the original
+	// and replaces it when complete.
+	if ( !readExisting(file, out.existing) ) return false;
+
+	out.tmpFile = file + "." + Core::toString(getpid()) + ".tmp";
+	out.stream.open(out.tmpFile.c_str(), ios_base::out | ios_base::binary | ios_base::trunc);
+	if ( !out.stream.is_open() ) {
+		SEISCOMP_ERROR("failed to open file: %s", out.tmpFile.c_str());
+		return false;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::closeFile(OutputFile &out, bool commit) {
+	bool ok = true;
+
+	if ( commit && out.stream.is_open() ) {
+		for ( ; out.next < out.existing.size(); ++out.next ) {
+			const Entry *existing = out.existing[out.next];
+			out.stream.write(existing->raw.data(), existing->raw.size());
+		}
+
+		out.stream.flush();
+		if ( !out.stream.good() ) {
+			SEISCOMP_ERROR("failed to write file: %s",
+			               out.tmpFile.empty() ? out.file.c_str() : out.tmpFile.c_str());
+			ok = false;
+		}
+	}
+
+	out.stream.close();
+	out.stream.clear();
+
+	if ( !out.tmpFile.empty() ) {
+		// On error the original file is left untouched
+		if ( !commit || !ok ) {
+			unlink(out.tmpFile.c_str());
+		}
+		else if ( rename(out.tmpFile.c_str(), out.file.c_str()) != 0 ) {
+			SEISCOMP_ERROR("failed to replace file %s: %s", out.file.c_str(),
+			               strerror(errno));
+			unlink(out.tmpFile.c_str());
+			ok = false;
+		}
+	}
+
+	for ( size_t i = 0; i < out.existing.size(); ++i )
+		delete out.existing[i];
+
+	out.existing.clear();
+	out.next = 0;
+	out.file.clear();
+	out.tmpFile.clear();
+
+	return ok;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool MSArchive::readExisting(const string &file, Entries &entries) {
+	IO::RecordStreamPtr stream = IO::RecordStream::Create("file");
+	if ( !stream || !stream->setSource(file) ) {
+		SEISCOMP_ERROR("%s: failed to open", file.c_str());
+		return false;
+	}
+
+	IO::RecordInput input(stream.get(), Array::INT, Record::SAVE_RAW);
+	RecordPtr rec;
+	while ( (rec = input.next()) != NULL ) {
+		const Array *raw = rec->raw();
+		if ( raw == NULL ) continue;
+
+		Entry *entry = new Entry;
+		try {
+			entry->streamID = rec->streamID();
+			entry->startTime = rec->startTime();
+			entry->time = _sortByEndTime ? rec->endTime() : rec->startTime();
+		}
+		catch ( exception &e ) {
+			// Do not drop archived data, leave the file untouched
+			SEISCOMP_ERROR("%s: invalid record: %s", file.c_str(), e.what());
+			delete entry;
+			return false;
+		}
+
+		entry->raw.assign(static_cast<const char*>(raw->data()),
+		                  raw->size() * raw->elementSize());
+		entries.push_back(entry);
+	}
+
+	stable_sort(entries.begin(), entries.end(), lessThan);
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::clearBuffer() {
+	for ( Groups::iterator it = _buffer.begin(); it != _buffer.end(); ++it ) {
+		for ( size_t i = 0; i < it->second.size(); ++i )
+			delete it->second[i];
+	}
+
+	_buffer.clear();
+	_bufferSize = 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void MSArchive::removeRuns() {
+	for ( size_t i = 0; i < _runs.size(); ++i )
+		unlink(_runs[i].file.c_str());
+	_runs.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+}
+}
@@ -0,0 +1,201 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+#ifndef __SEISCOMP_APPLICATIONS_SCMSARCHIVE_H__
+#define __SEISCOMP_APPLICATIONS_SCMSARCHIVE_H__
+
+#include <seiscomp3/client/application.h>
+#include <seiscomp3/core/datetime.h>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Applications {
+
+
+/**
+ * @brief Sorts miniSEED records with bounded memory.
+ *
+ * Records are read into a buffer of limited size. Each time the buffer is
+ * full its content is sorted and spilled to a temporary run file. Finally
+ * all runs are merged (k-way) and written either to stdout or into a SDS
+ * archive. In SDS mode records are grouped by stream and each group is
+ * sorted and merged independently by a pool of worker threads. Records of
+ * existing day files are merged with the new records, records already
+ * stored are not written again.
+ */
+class MSArchive : public Client::Application {
+	// ----------------------------------------------------------------------
+	//  X'truction
+	// ----------------------------------------------------------------------
+	public:
+		//! C'tor
+		MSArchive(int argc, char **argv);
+
+		//! Destructor
+		~MSArchive();
+
+
+	// ----------------------------------------------------------------------
+	//  Public types
+	// ----------------------------------------------------------------------
+	public:
+		//! A single raw record with its sort keys
+		struct Entry {
+			std::string streamID;
+			Core::Time  time;
+			Core::Time  startTime;
+			std::string raw;
+
+			size_t memorySize() const {
+				return sizeof(Entry) + streamID.size() + raw.size();
+			}
+		};
+
+		typedef std::vector<Entry*> Entries;
+
+		//! Reads entries one by one
+		class Cursor {
+			public:
+				virtual ~Cursor() {}
+				//! Returns the next entry or NULL if exhausted. The entry is
+				//! valid until the next call.
+				virtual const Entry *next() = 0;
+		};
+
+
+	// ----------------------------------------------------------------------
+	//  Protected types
+	// ----------------------------------------------------------------------
+	protected:
+		//! Location of a group inside a run file
+		struct Segment {
+			Segment() : offset(0), count(0) {}
+			Segment(std::streamoff o, size_t c) : offset(o), count(c) {}
+			std::streamoff offset;
+			size_t         count;
+		};
+
+		typedef std::map<std::string, Segment> SegmentIndex;
+
+		struct Run {
+			std::string  file;
+			SegmentIndex segments;
+		};
+
+		typedef std::map<std::string, Entries> Groups;
+
+		//! The SDS day file currently written by a worker
+		struct OutputFile {
+			OutputFile() : next(0), skipped(0), dropped(0) {}
+
+			std::string   file;
+			//! Set if existing records are merged, renamed to file on close
+			std::string   tmpFile;
+			std::ofstream stream;
+			//! Sorted records stored in file before it has been opened
+			Entries       existing;
+			size_t        next;
+			//! Number of new records already stored in file
+			size_t        skipped;
+			//! Number of records with an invalid stream ID
+			size_t        dropped;
+		};
+
+
+	// ----------------------------------------------------------------------
+	//  Protected functions
+	// ----------------------------------------------------------------------
+	protected:
+		void createCommandLineDescription();
+		bool validateParameters();
+		bool init();
+		bool run();
+
+		void exit(int returnCode);
+
+		void printUsage() const;
+
+	private:
+		bool readFile(const std::string &file);
+		bool add(Entry *entry);
+		bool spill();
+		void sortBuffer();
+		void sortGroups(int threadID);
+		bool merge();
+		void mergeGroups(int threadID);
+		bool mergeGroup(const std::string &group);
+
+		bool nextGroup(Groups::iterator &it);
+		bool nextGroup(std::vector<std::string>::const_iterator &it);
+
+		bool write(OutputFile &out, const Entry *entry);
+		bool openFile(OutputFile &out, const std::string &file);
+		bool closeFile(OutputFile &out, bool commit);
+		bool readExisting(const std::string &file, Entries &entries);
+
+		void clearBuffer();
+		void removeRuns();
+
+
+	// ----------------------------------------------------------------------
+	//  Implementation
+	// ----------------------------------------------------------------------
+	private:
+		// configuration parameters
+		std::string                     _archive;
+		std::string                     _tmpDir;
+		std::string                     _timeWindow;
+		int                             _threads;
+		int                             _memoryLimit;
+		bool                            _sortByEndTime;
+		bool                            _unique;
+
+		std::vector<std::string>        _files;
+		Core::Time                      _startTime;
+		Core::Time                      _endTime;
+
+		// in-memory buffer of the current run, grouped by stream in SDS
+		// mode or a single group otherwise
+		Groups                          _buffer;
+		size_t                          _bufferSize;
+		std::vector<Run>                _runs;
+
+		// state shared between worker threads
+		boost::mutex                    _mutex;
+		Groups::iterator                _nextSortGroup;
+		std::vector<std::string>        _groups;
+		std::vector<std::string>::const_iterator _nextMergeGroup;
+		bool                            _error;
+		// set by exit() which is also called from the signal handler
+		boost::atomic<bool>             _abort;
+
+		// statistics
+		size_t                          _recordsRead;
+		size_t                          _recordsWritten;
+		size_t                          _duplicates;
+		size_t                          _dropped;
+};
+
+
+}
+}
+
+
+#endif
@@ -16,6 +16,7 @@
 #include <seiscomp3/logging/log.h>
 #include <seiscomp3/client/application.h>
 #include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/io/exporter.h>
 #include <seiscomp3/datamodel/inventory.h>
 #include <seiscomp3/datamodel/config.h>
 #include <seiscomp3/datamodel/routing.h>
@@ -111,6 +112,7 @@ class EventDump : public Seiscomp::Client::Application {
 			commandline().addOption("Dump", "preferred-only,p", "when exporting events only the preferred origin and the preferred magnitude will be dumped");
 			commandline().addOption("Dump", "all-magnitudes,m", "if only the preferred origin is exported, all magnitudes for this origin will be dumped");
 			commandline().addOption("Dump", "formatted,f", "use formatted output");
+			commandline().addOption("Dump", "format", "output format: xml (default) or an exporter such as json, bson or bson-json", &_format, false);
 			commandline().addOption("Dump", "prepend-datasize", "prepend a line with the length of the XML string");
 			commandline().addOption("Dump", "output,o", "output file (default is stdout)", &_outputFile, false);
 		}
@@ -140,25 +142,74 @@ class EventDump : public Seiscomp::Client::Application {
 			ignoreArrivals        = commandline().hasOption("ignore-arrivals");
 			withFocalMechanisms   = commandline().hasOption("with-focal-mechanisms");
 
+			if ( !_format.empty() && _format != "xml" ) {
+				_exporter = Exporter::Create(_format.c_str());
+				if ( !_exporter ) {
+					cerr << "Unknown output format: " << _format << endl;
+					return false;
+				}
+			}
+
 			return true;
 		}
 
-		bool write(PublicObject *po) {
+		bool serialize(std::streambuf *buf, PublicObject *po) {
+			if ( _exporter ) {
+				_exporter->setFormattedOutput(commandline().hasOption("formatted"));
+				return _exporter->write(buf, po);
+			}
+
 			XMLArchive ar;
-			stringbuf buf;
-			if ( !ar.create(&buf) ) {
-				SEISCOMP_ERROR("Could not create output file '%s'", _outputFile.c_str());
+			if ( !ar.create(buf) )
 				return false;
-			}
 
 			ar.setFormattedOutput(commandline().hasOption("formatted"));
 
 			ar << po;
 			ar.close();
 
+			return true;
+		}
+
+		bool write(PublicObject *po) {
+			bool toFile = !_outputFile.empty() && _outputFile != "-";
+
+			// Without the data size the document is written directly to
+			// the output and streaming exporters do not need to hold it
+			// in memory
+			if ( !commandline().hasOption("prepend-datasize") ) {
+				ofstream file;
+
+				if ( toFile ) {
+					file.open(_outputFile.c_str(), ios::out | ios::trunc | ios::binary);
+					if ( !file.is_open() ) {
+						SEISCOMP_ERROR("Could not create file: %s", _outputFile.c_str());
+						return false;
+					}
+				}
+
+				if ( !serialize(toFile ? file.rdbuf() : cout.rdbuf(), po) ) {
+					SEISCOMP_ERROR("Could not write output");
+					return false;
+				}
+
+				if ( toFile )
+					file.close();
+				else
+					cout << flush;
+
+				return true;
+			}
+
+			stringbuf buf;
+			if ( !serialize(&buf, po) ) {
+				SEISCOMP_ERROR("Could not create output file '%s'", _outputFile.c_str());
+				return false;
+			}
+
 			string content = buf.str();
 
-			if ( !_outputFile.empty() && _outputFile != "-" ) {
+			if ( toFile ) {
 				ofstream file(_outputFile.c_str(), ios::out | ios::trunc);
 
 				if ( !file.is_open() ) {
@@ -166,18 +217,11 @@ class EventDump : public Seiscomp::Client::Application {
 					return false;
 				}
 
-				if ( commandline().hasOption("prepend-datasize") )
-					file << content.size() << endl << content;
-				else
-					file << content;
-
+				file << content.size() << endl << content;
 				file.close();
 			}
 			else {
-				if ( commandline().hasOption("prepend-datasize") )
-					cout << content.size() << endl << content << flush;
-				else
-					cout << content << flush;
+				cout << content.size() << endl << content << flush;
 				SEISCOMP_INFO("Flushing %lu bytes", (unsigned long)content.size());
 			}
 
@@ -881,6 +925,8 @@ class EventDump : public Seiscomp::Client::Application {
 		bool withFocalMechanisms;
 
 		string _outputFile;
+		string _format;
+		ExporterPtr _exporter;
 		string _originIDs;
 		string _eventIDs;
 
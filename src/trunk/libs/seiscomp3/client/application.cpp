@@ -36,6 +36,7 @@
 #include <seiscomp3/client/pluginregistry.h>
 #include <seiscomp3/client/inventory.h>
 #include <seiscomp3/client/configdb.h>
+#include <seiscomp3/client/snapshot.h>
 
 #include <seiscomp3/datamodel/config.h>
 #include <seiscomp3/datamodel/configmodule.h>
@@ -125,6 +126,18 @@ struct AppResolver : public Util::VariableResolver {
 
 
 
+// The output which logs asynchronously. The signal handlers terminate the
+// process without running the destructors and write the buffered messages
+// before.
+Logging::Output *asyncLogger = NULL;
+
+void disableAsyncLogging() {
+	if ( asyncLogger == NULL ) return;
+	asyncLogger->setAsyncEnabled(false);
+	asyncLogger = NULL;
+}
+
+
 /*
 void printTraces() {
     #ifndef MACOSX
@@ -245,12 +258,15 @@ void signalHandler(int signal) {
 			//SEISCOMP_ERROR("ABORT");
 			//SEISCOMP_ERROR("BACKTRACE:");
 			//crashHandler();
+			disableAsyncLogging();
 			exit(-1);
 
 		case SIGSEGV:
 			//SEISCOMP_ERROR("SEGFAULT");
 			if ( !signalCatched ) {
 				signalCatched = true;
+				// The output of the crash handler is logged synchronously
+				disableAsyncLogging();
 				//SEISCOMP_ERROR("BACKTRACE:");
 				crashHandler();
 			}
@@ -507,6 +523,7 @@ Application::Application(int argc, char** argv)
 	_enableInterpretNotifier = true;
 	_enableLoadCities = false;
 	_enableLoadRegions = false;
+	_enableSnapshots = false;
 	_enableStartStopMessages = false;
 	_enableAutoShutdown = false;
 	_customPublicIDPattern = false;
@@ -579,6 +596,7 @@ void Application::HandleSignals(bool termination, bool crash) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::prepare(int argc, char** argv) {
 	_logger = NULL;
+	_logAsyncBufferSize = 0;
 
 	_argc = argc;
 	_argv = new char*[argc];
@@ -1253,6 +1271,9 @@ void Application::printUsage() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::closeLogging() {
+	if ( asyncLogger == _logger )
+		asyncLogger = NULL;
+
 	if ( _logger ) {
 		delete _logger;
 		_logger = NULL;
@@ -1865,6 +1886,13 @@ bool Application::init() {
 		}
 	}
 
+	// The background thread of asynchronous logging would not survive
+	// the fork of a daemon and is started afterwards
+	if ( _logger && _logAsyncBufferSize > 0 ) {
+		_logger->setAsyncEnabled(true, _logAsyncBufferSize);
+		asyncLogger = _logger;
+	}
+
 	if ( _lockfile.length() > 0 ) {
 		int r = acquireLockfile(_lockfile);
 		if ( r < 0 ) {
@@ -2076,43 +2104,50 @@ void Application::handleEndAcquisition() {}
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Application::reloadInventory() {
-	if ( _enableLoadInventory ) {
-		if ( !_inventoryDB.empty() ) {
-			if ( !loadInventory(_inventoryDB) ) return false;
-		}
-		else if ( _database ) {
-			if ( _query ) {
-				SEISCOMP_INFO("Loading complete inventory");
-				showMessage("Loading inventory");
-				Inventory::Instance()->load(_query.get());
-				SEISCOMP_INFO("Finished loading complete inventory");
-			}
-			else {
-				SEISCOMP_ERROR("No database query object");
-				return false;
-			}
-		}
-
-		int filtered = Inventory::Instance()->filter(&_networkTypeFirewall,
-		                                             &_stationTypeFirewall);
-		if ( filtered > 0 )
-			SEISCOMP_INFO("Filtered %d stations by type", filtered);
-	}
-	else if ( _enableLoadStations ) {
-		if ( !_inventoryDB.empty() ) {
-			if ( !loadInventory(_inventoryDB) ) return false;
+	if ( _enableLoadInventory || _enableLoadStations ) {
+		// A given inventory source is always read completely
+		bool complete = _enableLoadInventory || !_inventoryDB.empty();
+		const char *snapshot = complete ? "inventory" : "stations";
+		std::string key = snapshotKey(_inventoryDB,
+		                              complete ? SnapshotCache::InventoryTables
+		                                       : SnapshotCache::StationTables);
+
+		DataModel::InventoryPtr inv;
+		if ( !key.empty() )
+			inv = DataModel::Inventory::Cast(SnapshotCache(_snapshotDirectory).load(snapshot, key));
+
+		if ( inv ) {
+			SEISCOMP_INFO("Loaded inventory from snapshot");
+			Inventory::Instance()->setInventory(inv.get());
 		}
-		else if ( _database ) {
-			if ( _query ) {
-				SEISCOMP_INFO("Loading inventory (stations only)");
-				showMessage("Loading stations");
-				Inventory::Instance()->loadStations(_query.get());
-				SEISCOMP_INFO("Finished loading inventory (stations only)");
+		else {
+			if ( !_inventoryDB.empty() ) {
+				if ( !loadInventory(_inventoryDB) ) return false;
 			}
-			else {
-				SEISCOMP_ERROR("No database query object");
-				return false;
+			else if ( _database ) {
+				if ( _query ) {
+					if ( _enableLoadInventory ) {
+						SEISCOMP_INFO("Loading complete inventory");
+						showMessage("Loading inventory");
+						Inventory::Instance()->load(_query.get());
+						SEISCOMP_INFO("Finished loading complete inventory");
+					}
+					else {
+						SEISCOMP_INFO("Loading inventory (stations only)");
+						showMessage("Loading stations");
+						Inventory::Instance()->loadStations(_query.get());
+						SEISCOMP_INFO("Finished loading inventory (stations only)");
+					}
+				}
+				else {
+					SEISCOMP_ERROR("No database query object");
+					return false;
+				}
 			}
+
+			// Save the snapshot before stations are filtered
+			if ( !key.empty() && Inventory::Instance()->inventory() )
+				SnapshotCache(_snapshotDirectory).save(snapshot, key, Inventory::Instance()->inventory());
 		}
 
 		int filtered = Inventory::Instance()->filter(&_networkTypeFirewall,
@@ -2134,27 +2169,44 @@ bool Application::reloadBindings() {
 
 	if ( _enableLoadConfigModule ) {
 		std::set<std::string> params;
+		std::string snapshot = "config";
+		if ( _configDB.empty() && !_configModuleName.empty() )
+			snapshot += "-" + _configModuleName;
+		std::string key = snapshotKey(_configDB, SnapshotCache::ConfigTables);
 
-		if ( !_configDB.empty() ) {
-			if ( !loadConfig(_configDB) ) return false;
+		DataModel::ConfigPtr config;
+		if ( !key.empty() )
+			config = DataModel::Config::Cast(SnapshotCache(_snapshotDirectory).load(snapshot, key));
+
+		if ( config ) {
+			SEISCOMP_INFO("Loaded configuration module from snapshot");
+			ConfigDB::Instance()->setConfig(config.get());
 		}
-		else if ( _database ) {
-			if ( _query ) {
-				SEISCOMP_INFO("Loading configuration module");
-				showMessage("Reading station config");
-				if ( !_configModuleName.empty() )
-					ConfigDB::Instance()->load(query(), _configModuleName, Core::None, Core::None, Core::None, params);
-				else
-					ConfigDB::Instance()->load(query(), Core::None, Core::None, Core::None, Core::None, params);
-				SEISCOMP_INFO("Finished loading configuration module");
+		else {
+			if ( !_configDB.empty() ) {
+				if ( !loadConfig(_configDB) ) return false;
 			}
-			else {
-				SEISCOMP_ERROR("No database query object");
-				return false;
+			else if ( _database ) {
+				if ( _query ) {
+					SEISCOMP_INFO("Loading configuration module");
+					showMessage("Reading station config");
+					if ( !_configModuleName.empty() )
+						ConfigDB::Instance()->load(query(), _configModuleName, Core::None, Core::None, Core::None, params);
+					else
+						ConfigDB::Instance()->load(query(), Core::None, Core::None, Core::None, Core::None, params);
+					SEISCOMP_INFO("Finished loading configuration module");
+				}
+				else {
+					SEISCOMP_ERROR("No database query object");
+					return false;
+				}
 			}
+
+			if ( !key.empty() )
+				SnapshotCache(_snapshotDirectory).save(snapshot, key, ConfigDB::Instance()->config());
 		}
 
-		DataModel::Config* config = ConfigDB::Instance()->config();
+		config = ConfigDB::Instance()->config();
 		for ( size_t i = 0; i < config->configModuleCount(); ++i ) {
 			if ( config->configModule(i)->name() == _configModuleName ) {
 				_configModule = config->configModule(i);
@@ -2631,6 +2683,10 @@ bool Application::initConfiguration() {
 	}
 	catch ( ... ) {}
 
+	try { _enableSnapshots = configGetBool("snapshots.enable"); } catch ( ... ) {}
+	try { _snapshotDirectory = configGetPath("snapshots.directory"); }
+	catch ( ... ) { _snapshotDirectory = Environment::Instance()->absolutePath("@ROOTDIR@/var/cache"); }
+
 	try { _enableLoadCities = configGetBool("loadCities"); } catch ( ... ) {}
 	try { _enableLoadRegions = configGetBool("loadRegions"); } catch ( ... ) {}
 
@@ -2666,6 +2722,11 @@ bool Application::initLogging() {
 	try { logRotateArchiveSize = configGetInt("logging.file.rotator.archiveSize"); } catch (...) {}
 	try { logRotateMaxFileSize = configGetInt("logging.file.rotator.maxFileSize"); } catch (...) {}
 
+	bool asyncLogging = false;
+	int asyncBufferSize = 1024;
+	try { asyncLogging = configGetBool("logging.async"); } catch (...) {}
+	try { asyncBufferSize = configGetInt("logging.async.bufferSize"); } catch (...) {}
+
 	bool enableLogging = _verbosity > 0;
 	bool syslog = false;
 
@@ -2740,6 +2801,8 @@ bool Application::initLogging() {
 			_logger->setUTCEnabled(_logUTC);
 			_logger->logComponent(_logComponent < 0 ? !_logToStdout : _logComponent);
 			_logger->logContext(_logContext);
+			if ( asyncLogging && asyncBufferSize > 0 )
+				_logAsyncBufferSize = asyncBufferSize;
 			if ( !_logComponents.empty() ) {
 				for ( ComponentList::iterator it = _logComponents.begin();
 				      it != _logComponents.end(); ++it ) {
@@ -3153,6 +3216,30 @@ bool Application::loadInventory(const std::string &inventoryDB) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::string Application::snapshotKey(const std::string &source,
+                                     const char **tables) {
+	if ( !_enableSnapshots ) return std::string();
+
+	if ( source.empty() )
+		return SnapshotCache::DatabaseKey(_database.get(), _db, tables);
+
+	if ( source.find("://") == string::npos )
+		return SnapshotCache::FileKey(source);
+
+	if ( source.find("file://") == 0 )
+		return SnapshotCache::FileKey(source.substr(7));
+
+	IO::DatabaseInterfacePtr db = IO::DatabaseInterface::Open(source.c_str());
+	if ( !db ) return std::string();
+
+	return SnapshotCache::DatabaseKey(db.get(), source, tables);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::logObject(ObjectMonitor::Log *log, const Core::Time &timestamp,
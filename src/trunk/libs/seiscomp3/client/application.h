@@ -839,6 +839,10 @@ class SC_SYSTEM_CLIENT_API Application : public Seiscomp::Core::InterruptibleObj
 		bool loadConfig(const std::string &configDB);
 		bool loadInventory(const std::string &inventoryDB);
 
+		//! Returns the key of the content of an inventory or config source
+		//! or an empty string if snapshots are disabled
+		std::string snapshotKey(const std::string &source, const char **tables);
+
 		void startMessageThread();
 		void runMessageThread();
 
@@ -874,6 +878,8 @@ class SC_SYSTEM_CLIENT_API Application : public Seiscomp::Core::InterruptibleObj
 		Util::StringFirewall _stationTypeFirewall;
 
 		Logging::Output* _logger;
+		//! Buffer size of asynchronous logging or 0 if disabled
+		int _logAsyncBufferSize;
 		DataModel::DatabaseQueryPtr _query;
 
 		std::string _configModuleName;
@@ -894,6 +900,7 @@ class SC_SYSTEM_CLIENT_API Application : public Seiscomp::Core::InterruptibleObj
 		bool _enableInterpretNotifier;
 		bool _enableLoadCities;
 		bool _enableLoadRegions;
+		bool _enableSnapshots;
 
 		unsigned int _retryCount;
 
@@ -936,6 +943,7 @@ class SC_SYSTEM_CLIENT_API Application : public Seiscomp::Core::InterruptibleObj
 		std::string _inventoryDB;
 		std::string _configDB;
 		std::string _cityDB;
+		std::string _snapshotDirectory;
 
 		std::string _dbType;
 		std::string _dbParameters;
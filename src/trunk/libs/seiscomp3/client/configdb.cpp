@@ -256,6 +256,11 @@ void ConfigDB::load(const char *xml) {
 }
 
 
+void ConfigDB::setConfig(Seiscomp::DataModel::Config *config) {
+	_config = config;
+}
+
+
 Seiscomp::DataModel::Config* ConfigDB::config() {
 	return _config.get();
 }
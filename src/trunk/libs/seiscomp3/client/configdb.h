@@ -46,6 +46,9 @@ class SC_SYSTEM_CLIENT_API ConfigDB {
 
 		void load(const char *xml);
 
+		//! Replaces the configuration, e.g. with a snapshot
+		void setConfig(Seiscomp::DataModel::Config *config);
+
 		Seiscomp::DataModel::Config* config();
 
 	private:
@@ -27,6 +27,52 @@ namespace Client {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+class Inventory::IndexObserver : public DataModel::Observer {
+	public:
+		IndexObserver(Inventory *inventory) : _inventory(inventory) {}
+
+	public:
+		void onObjectAdded(DataModel::Object *parent, DataModel::Object *child) {
+			check(parent, child);
+		}
+
+		void onObjectRemoved(DataModel::Object *parent, DataModel::Object *child) {
+			check(parent, child);
+		}
+
+		void onObjectModified(DataModel::Object *object) {
+			check(object->parent(), object);
+		}
+
+	private:
+		void check(DataModel::Object *parent, DataModel::Object *object) {
+			// Only objects with codes or epochs affect the index
+			if ( DataModel::Network::Cast(object) == NULL &&
+			     DataModel::Station::Cast(object) == NULL &&
+			     DataModel::SensorLocation::Cast(object) == NULL &&
+			     DataModel::Stream::Cast(object) == NULL )
+				return;
+
+			// Ignore objects of other inventories, e.g. copies which
+			// are merged or compared
+			while ( parent != NULL && parent->parent() != NULL )
+				parent = parent->parent();
+
+			if ( parent == NULL || parent != _inventory->_inventory.get() )
+				return;
+
+			_inventory->invalidateIndex();
+		}
+
+	private:
+		Inventory *_inventory;
+};
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Inventory Inventory::_instance;
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -55,7 +101,7 @@ StationLocation::StationLocation(double lat, double lon, double elv)
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-Inventory::Inventory() {
+Inventory::Inventory() : _indexValid(false) {
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -80,6 +126,8 @@ void Inventory::load(const char *filename) {
 
 	ar >> _inventory;
 	ar.close();
+
+	resetIndex();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -288,6 +336,8 @@ void Inventory::loadStations(DataModel::DatabaseReader* reader) {
 	if ( reader == NULL ) return;
 
 	_inventory = new DataModel::Inventory();
+	resetIndex();
+
 	DataModel::DatabaseIterator it;
 
 	// Read networks
@@ -492,6 +542,7 @@ int Inventory::filter(const Util::StringFirewall *networkTypeFW,
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Inventory::setInventory(DataModel::Inventory *inv) {
 	_inventory = inv;
+	resetIndex();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -524,7 +575,9 @@ DataModel::Station* Inventory::getStation(const std::string &networkCode,
                                           const std::string &stationCode,
                                           const Core::Time &time,
                                           DataModel::InventoryError *error) const {
-	return DataModel::getStation(_inventory.get(), networkCode, stationCode, time, error);
+	boost::mutex::scoped_lock lock(_indexMutex);
+	updateIndex();
+	return _index.getStation(networkCode, stationCode, time, error);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -538,8 +591,10 @@ Inventory::getSensorLocation(const std::string &networkCode,
                              const std::string &locationCode,
                              const Core::Time &time,
                              DataModel::InventoryError *error) const {
-	return DataModel::getSensorLocation(_inventory.get(), networkCode, stationCode,
-	                                    locationCode, time, error);
+	boost::mutex::scoped_lock lock(_indexMutex);
+	updateIndex();
+	return _index.getSensorLocation(networkCode, stationCode, locationCode,
+	                                time, error);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -578,8 +633,10 @@ Inventory::getStream(const std::string &networkCode,
                      const std::string &channelCode,
                      const Core::Time &time,
                      DataModel::InventoryError *error) const {
-	return DataModel::getStream(_inventory.get(), networkCode, stationCode,
-	                            locationCode, channelCode, time, error);
+	boost::mutex::scoped_lock lock(_indexMutex);
+	updateIndex();
+	return _index.getStream(networkCode, stationCode, locationCode,
+	                        channelCode, time, error);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -635,7 +692,11 @@ int Inventory::getAllStations(StationList& stationList,
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 DataModel::Station* Inventory::getStation(const DataModel::Pick* pick) const {
-	return DataModel::getStation(_inventory.get(), pick);
+	if ( pick == NULL ) return NULL;
+
+	return getStation(pick->waveformID().networkCode(),
+	                  pick->waveformID().stationCode(),
+	                  pick->time().value());
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -644,7 +705,12 @@ DataModel::Station* Inventory::getStation(const DataModel::Pick* pick) const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 DataModel::SensorLocation* Inventory::getSensorLocation(const DataModel::Pick *pick) const {
-	return DataModel::getSensorLocation(_inventory.get(), pick);
+	if ( pick == NULL ) return NULL;
+
+	return getSensorLocation(pick->waveformID().networkCode(),
+	                         pick->waveformID().stationCode(),
+	                         pick->waveformID().locationCode(),
+	                         pick->time().value());
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -653,7 +719,13 @@ DataModel::SensorLocation* Inventory::getSensorLocation(const DataModel::Pick *p
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 DataModel::Stream* Inventory::getStream(const DataModel::Pick *pick) const {
-	return DataModel::getStream(_inventory.get(), pick);
+	if ( pick == NULL ) return NULL;
+
+	return getStream(pick->waveformID().networkCode(),
+	                 pick->waveformID().stationCode(),
+	                 pick->waveformID().locationCode(),
+	                 pick->waveformID().channelCode(),
+	                 pick->time().value());
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -708,6 +780,45 @@ DataModel::Inventory* Inventory::inventory() {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Inventory::invalidateIndex() {
+	boost::mutex::scoped_lock lock(_indexMutex);
+	_indexValid = false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Inventory::resetIndex() {
+	// The observer list of the data model is not thread-safe. Register
+	// the observer when the inventory is set up rather than with the
+	// first lookup which might be issued from any thread.
+	if ( _indexObserver == NULL ) {
+		_indexObserver = new IndexObserver(this);
+		DataModel::Object::RegisterObserver(_indexObserver.get());
+	}
+
+	invalidateIndex();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Inventory::updateIndex() const {
+	if ( _indexValid && _index.inventory() == _inventory.get() ) return;
+
+	_index.build(_inventory.get());
+	_indexValid = true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 }
 }
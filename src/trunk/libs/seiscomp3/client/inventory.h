@@ -19,9 +19,11 @@
 #include <seiscomp3/datamodel/pick.h>
 #include <seiscomp3/datamodel/databasereader.h>
 #include <seiscomp3/datamodel/utils.h>
+#include <seiscomp3/datamodel/inventoryindex.h>
 #include <seiscomp3/utils/stringfirewall.h>
 #include <seiscomp3/client.h>
 
+#include <boost/thread/mutex.hpp>
 #include <map>
 #include <set>
 
@@ -131,13 +133,40 @@ class SC_SYSTEM_CLIENT_API Inventory {
 
 		DataModel::Inventory* inventory();
 
+		//! Station, sensor location and stream lookups use an index which
+		//! is rebuilt with the next lookup after the inventory has been
+		//! changed. Changes through the data model, e.g. by applying
+		//! notifiers, are tracked automatically. This method needs only
+		//! to be called if attributes of the inventory objects have been
+		//! changed directly without calling update().
+		void invalidateIndex();
+
+
+	// ----------------------------------------------------------------------
+	//  Private interface
+	// ----------------------------------------------------------------------
+	private:
+		class IndexObserver;
+		friend class IndexObserver;
+
+		//! Marks the index as outdated and starts tracking changes of
+		//! the inventory
+		void resetIndex();
+
+		//! Rebuilds the index if required. The index mutex must be locked.
+		void updateIndex() const;
+
 
 	// ----------------------------------------------------------------------
 	//  Private members
 	// ----------------------------------------------------------------------
 	private:
-		DataModel::InventoryPtr _inventory;
-		static Inventory        _instance;
+		DataModel::InventoryPtr           _inventory;
+		mutable DataModel::InventoryIndex _index;
+		mutable bool                      _indexValid;
+		mutable boost::mutex              _indexMutex;
+		DataModel::ObserverPtr            _indexObserver;
+		static Inventory                  _instance;
 };
 
 
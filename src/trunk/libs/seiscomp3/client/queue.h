@@ -57,6 +57,9 @@ class ThreadedQueue : private boost::noncopyable {
 
 		bool canPush() const;
 		bool push(T v);
+		//! Appends an element without blocking. Returns false if the
+		//! queue is full or closed.
+		bool tryPush(T v);
 
 		bool canPop() const;
 		T pop();
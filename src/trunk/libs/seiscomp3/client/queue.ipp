@@ -131,6 +131,23 @@ bool ThreadedQueue<T>::push(T v) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+template <typename T>
+bool ThreadedQueue<T>::tryPush(T v) {
+	lock lk(_monitor);
+	if ( _closed || _buffered == _buffer.size() )
+		return false;
+	_buffer[_end] = v;
+	_end = (_end+1) % _buffer.size();
+	++_buffered;
+	_notEmpty.notify_all();
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 template <typename T>
 bool ThreadedQueue<T>::canPop() const {
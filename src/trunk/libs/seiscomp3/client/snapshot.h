@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_CLIENT_SNAPSHOT_H__
+#define __SEISCOMP_CLIENT_SNAPSHOT_H__
+
+
+#include <seiscomp3/core/baseobject.h>
+#include <seiscomp3/io/database.h>
+#include <seiscomp3/client.h>
+
+#include <string>
+
+
+namespace Seiscomp {
+namespace Client {
+
+
+/**
+ * \brief Stores binary snapshots of data model objects on disk.
+ *
+ * Loading the inventory or the bindings from the database or from XML
+ * can take a long time for large networks. A snapshot holds the object
+ * tree serialized with VBinaryArchive together with a key describing the
+ * content of the source, e.g. the number of rows and the latest
+ * modification time of the inventory tables. As long as the key of the
+ * source does not change the object is restored from the snapshot which
+ * is memory mapped for reading.
+ *
+ * Snapshots are written to a temporary file which is renamed afterwards,
+ * so several applications can share a directory.
+ *
+ * \code
+ * SnapshotCache cache("/home/sysop/seiscomp3/var/cache");
+ * std::string key = SnapshotCache::DatabaseKey(db, uri, SnapshotCache::InventoryTables);
+ * DataModel::InventoryPtr inv = DataModel::Inventory::Cast(cache.load("inventory", key));
+ * if ( inv == NULL ) {
+ *     inv = query->loadInventory();
+ *     cache.save("inventory", key, inv.get());
+ * }
+ * \endcode
+ */
+class SC_SYSTEM_CLIENT_API SnapshotCache {
+	// ----------------------------------------------------------------------
+	//  Public types
+	// ----------------------------------------------------------------------
+	public:
+		//! The version of the file format
+		static const int FormatVersion;
+
+		//! NULL terminated lists of the tables read by
+		//! Client::Inventory::load and ConfigDB::load
+		static const char *InventoryTables[];
+		static const char *StationTables[];
+		static const char *ConfigTables[];
+
+
+	// ----------------------------------------------------------------------
+	//  X'truction
+	// ----------------------------------------------------------------------
+	public:
+		SnapshotCache(const std::string &directory);
+
+
+	// ----------------------------------------------------------------------
+	//  Public interface
+	// ----------------------------------------------------------------------
+	public:
+		const std::string &directory() const;
+
+		//! Returns the path of the snapshot with the given name
+		std::string path(const std::string &name) const;
+
+		/**
+		 * @brief Restores an object from a snapshot
+		 * @param name The name of the snapshot
+		 * @param key The current key of the source
+		 * @return The object or NULL if the snapshot does not exist, its
+		 *         key differs or it cannot be read
+		 */
+		Core::BaseObjectPtr load(const std::string &name, const std::string &key) const;
+
+		//! Writes a snapshot of an object
+		bool save(const std::string &name, const std::string &key,
+		          Core::BaseObject *obj) const;
+
+		//! Removes a snapshot
+		bool remove(const std::string &name) const;
+
+		/**
+		 * @brief Returns the key of the content of tables in a database.
+		 *
+		 * The key is built from the database URI without credentials, the
+		 * number of rows and the latest value of _last_modified of each
+		 * table. It changes with every insert, update or delete but
+		 * requires only one aggregate query per table which is answered
+		 * much faster than reading the rows.
+		 *
+		 * _last_modified has a resolution of one second. If a table was
+		 * modified within the current second of the database clock a
+		 * further modification in the same second might not change the
+		 * key. No key is returned in that case.
+		 * @param db The database connection
+		 * @param uri The URI db has been opened with
+		 * @param tables The tables to query
+		 * @return The key or an empty string if a query failed or a table
+		 *         has been modified too recently
+		 */
+		static std::string DatabaseKey(IO::DatabaseInterface *db,
+		                               const std::string &uri,
+		                               const char **tables);
+
+		//! Returns the key of a file built from its size and its
+		//! modification time or an empty string if it does not exist
+		static std::string FileKey(const std::string &filename);
+
+
+	// ----------------------------------------------------------------------
+	//  Private members
+	// ----------------------------------------------------------------------
+	private:
+		std::string _directory;
+};
+
+
+}
+}
+
+
+#endif
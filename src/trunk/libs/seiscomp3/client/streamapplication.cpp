@@ -399,6 +399,7 @@ bool StreamApplication::storeRecord(Record *rec) {
 	bool r = _queue.push(rec);
 	if ( _requestSync ) {
 		_requestSync = false;
+		flushStoredRecords();
 		sendNotification(Notification::Sync);
 	}
 	else {
@@ -411,6 +412,30 @@ bool StreamApplication::storeRecord(Record *rec) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StreamApplication::synchronizeAcquisition() {
+	_recordLock.lock();
+	if ( _requestSync ) {
+		_requestSync = false;
+		flushStoredRecords();
+		sendNotification(Notification::Sync);
+	}
+	else {
+		_recordLock.unlock();
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StreamApplication::flushStoredRecords() {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void StreamApplication::requestSync() {
 	_requestSync = true;
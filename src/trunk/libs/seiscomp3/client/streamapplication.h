@@ -107,6 +107,19 @@ class SC_SYSTEM_CLIENT_API StreamApplication : public Application {
 		//! queue which gets read by the main thread
 		virtual bool storeRecord(Record *rec);
 
+		//! Sends a sync request if requested with requestSync and blocks
+		//! the acquisition until the sync has been completed. This
+		//! must be called from the acquisition thread by implementations
+		//! of storeRecord which do not call the default implementation.
+		void synchronizeAcquisition();
+
+		//! This method gets called from the acquisition thread before a
+		//! requested sync is sent. Implementations which process stored
+		//! records outside the main thread must wait until all records
+		//! stored so far have been processed. The default implementation
+		//! does nothing.
+		virtual void flushStoredRecords();
+
 		virtual void handleRecord(Record *rec) = 0;
 
 		//! Logs the received records for the last period
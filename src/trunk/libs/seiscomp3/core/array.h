@@ -24,6 +24,10 @@ DEFINE_SMARTPOINTER(Array);
 
 /**
  * Generic abstract base class of certain array types.
+ *
+ * Arrays are not synchronized. An array can be read by several threads at
+ * the same time, e.g. the data of a shared Record, as long as no thread
+ * modifies it.
  */
 class SC_SYSTEM_CORE_API Array : public Seiscomp::Core::BaseObject {
 	DECLARE_SC_CLASS(Array);
@@ -20,7 +20,7 @@
 namespace Seiscomp {
 namespace Core {
 
-volatile unsigned int BaseObject::_objectCount = 0;
+boost::atomic<unsigned int> BaseObject::_objectCount(0);
 
 IMPLEMENT_CLASSFACTORY(BaseObject, SC_SYSTEM_CORE_API);
 IMPLEMENT_ROOT_RTTI(BaseObject, "BaseObject")
@@ -36,7 +36,7 @@ template class SC_SYSTEM_CORE_API Generic::Archive<Seiscomp::Core::BaseObject>;
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BaseObject::BaseObject() : _referenceCount(0) {
-	++_objectCount;
+	_objectCount.fetch_add(1, boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -54,7 +54,7 @@ BaseObject::BaseObject() : _referenceCount(0) {
 	}
 	*/
 BaseObject::BaseObject(const BaseObject&) : _referenceCount(0) {
-    ++_objectCount;
+    _objectCount.fetch_add(1, boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -64,7 +64,7 @@ BaseObject::BaseObject(const BaseObject&) : _referenceCount(0) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 BaseObject::~BaseObject() {
 	//SEISCOMP_DEBUG("~BaseObject called");
-	--_objectCount;
+	_objectCount.fetch_sub(1, boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -33,6 +33,8 @@ namespace Core {
 #include <seiscomp3/core/factory.h>
 #include <seiscomp3/core.h>
 
+#include <boost/atomic.hpp>
+
 
 using Seiscomp::Core::intrusive_ptr_add_ref;
 using Seiscomp::Core::intrusive_ptr_release;
@@ -198,6 +200,13 @@ class SC_SYSTEM_CORE_API BaseObject {
 	// ----------------------------------------------------------------------
 	//  Reference counting
 	// ----------------------------------------------------------------------
+	/**
+	 * The reference counter is updated atomically. Smart pointers to the
+	 * same object can thus be copied and released concurrently in different
+	 * threads and the object is deleted exactly once. This does not make
+	 * the object itself thread-safe: an object may be read by several
+	 * threads only if none of them modifies it.
+	 */
 	public:
 		//! Increment the reference counter
 		void incrementReferenceCount() const;
@@ -224,8 +233,8 @@ class SC_SYSTEM_CORE_API BaseObject {
 	//  Implementation
 	// ----------------------------------------------------------------------
 	private:
-		mutable volatile unsigned int _referenceCount;
-		static  volatile unsigned int _objectCount;
+		mutable boost::atomic<unsigned int> _referenceCount;
+		static  boost::atomic<unsigned int> _objectCount;
 };
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -12,7 +12,7 @@
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 inline void BaseObject::incrementReferenceCount() const {
-	++_referenceCount;
+	_referenceCount.fetch_add(1, boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -21,8 +21,12 @@ inline void BaseObject::incrementReferenceCount() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 inline void BaseObject::decrementReferenceCount() const {
-	if ( --_referenceCount == 0 )
+	// Release the changes made through this reference and acquire all
+	// others before the object is deleted
+	if ( _referenceCount.fetch_sub(1, boost::memory_order_release) == 1 ) {
+		boost::atomic_thread_fence(boost::memory_order_acquire);
 		delete this;
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -31,7 +35,7 @@ inline void BaseObject::decrementReferenceCount() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 inline unsigned int BaseObject::referenceCount() const {
-	return _referenceCount;
+	return _referenceCount.load(boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -40,6 +44,6 @@ inline unsigned int BaseObject::referenceCount() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 inline unsigned int BaseObject::ObjectCount() {
-	return _objectCount;
+	return _objectCount.load(boost::memory_order_relaxed);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -173,6 +173,178 @@ inline void normalize(T &sec, U &usec) {
 	}
 }
 
+
+// Formats and parsers for the standard time formats which do not depend
+// on the locale and do not allocate. The calendar conversions are
+// Howard Hinnant's days_from_civil and civil_from_days.
+enum ISOFormat {
+	ISOPrecise,    // %FT%T.%fZ
+	ISOSeconds,    // %FT%TZ
+	SQL            // %F %T
+};
+
+
+const int ISOMaxLength = 27;
+
+
+inline long daysFromCivil(long y, long m, long d) {
+	y -= m <= 2;
+	long era = (y >= 0 ? y : y-399) / 400;
+	long yoe = y - era * 400;
+	long doy = (153*(m + (m > 2 ? -3 : 9)) + 2)/5 + d-1;
+	long doe = yoe * 365 + yoe/4 - yoe/100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+
+inline void civilFromDays(long z, long &y, long &m, long &d) {
+	z += 719468;
+	long era = (z >= 0 ? z : z - 146096) / 146097;
+	long doe = z - era * 146097;
+	long yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+	long doy = doe - (365*yoe + yoe/4 - yoe/100);
+	long mp = (5*doy + 2)/153;
+	d = doy - (153*mp+2)/5 + 1;
+	m = mp + (mp < 10 ? 3 : -9);
+	y = yoe + era * 400 + (m <= 2);
+}
+
+
+inline bool isFormat(const char *fmt, ISOFormat &format) {
+	if ( !strcmp(fmt, "%FT%T.%fZ") )
+		format = ISOPrecise;
+	else if ( !strcmp(fmt, "%FT%TZ") )
+		format = ISOSeconds;
+	else if ( !strcmp(fmt, "%F %T") || !strcmp(fmt, "%Y-%m-%d %H:%M:%S") )
+		format = SQL;
+	else
+		return false;
+	return true;
+}
+
+
+inline char *writeDigits(char *out, long value, int digits) {
+	for ( int i = digits-1; i >= 0; --i ) {
+		out[i] = '0' + value % 10;
+		value /= 10;
+	}
+	return out + digits;
+}
+
+
+/**
+ * Writes secs and usecs in the given format to out which must hold at
+ * least ISOMaxLength+1 characters. Returns the number of characters
+ * written or -1 if the year is not representable with four digits in
+ * which case the generic implementation must be used.
+ */
+int formatTime(char *out, time_t secs, long usecs, ISOFormat format) {
+	while ( usecs < 0 ) {
+		secs -= 1;
+		usecs += MICROS;
+	}
+
+	long days = (long)(secs / 86400);
+	long rem = (long)(secs % 86400);
+	if ( rem < 0 ) {
+		rem += 86400;
+		--days;
+	}
+
+	long year, month, day;
+	civilFromDays(days, year, month, day);
+	if ( year < 1000 || year > 9999 ) return -1;
+
+	char *p = writeDigits(out, year, 4);
+	*p++ = '-';
+	p = writeDigits(p, month, 2);
+	*p++ = '-';
+	p = writeDigits(p, day, 2);
+	*p++ = format == SQL ? ' ' : 'T';
+	p = writeDigits(p, rem / 3600, 2);
+	*p++ = ':';
+	p = writeDigits(p, rem / 60 % 60, 2);
+	*p++ = ':';
+	p = writeDigits(p, rem % 60, 2);
+
+	if ( format == ISOPrecise ) {
+		*p++ = '.';
+		// The same as %f: trailing zeros are removed and no fraction
+		// is written as four zeros
+		if ( usecs > 0 ) {
+			int digits = 6;
+			while ( usecs % 10 == 0 ) {
+				usecs /= 10;
+				--digits;
+			}
+			p = writeDigits(p, usecs, digits);
+		}
+		else {
+			memcpy(p, "0000", 4);
+			p += 4;
+		}
+	}
+
+	if ( format != SQL )
+		*p++ = 'Z';
+
+	*p = '\0';
+	return (int)(p - out);
+}
+
+
+inline bool readDigits(const char *&in, int digits, long &value) {
+	value = 0;
+	for ( int i = 0; i < digits; ++i, ++in ) {
+		if ( *in < '0' || *in > '9' ) return false;
+		value = value * 10 + (*in - '0');
+	}
+	return true;
+}
+
+
+/**
+ * Parses str in the given format. Only the canonical representation with
+ * zero padded fields is accepted, anything else has to be handled by the
+ * generic implementation. Trailing characters are ignored as strptime
+ * does.
+ */
+bool parseTime(const char *str, ISOFormat format, long &secs, long &usecs) {
+	long year, month, day, hour, minute, second;
+
+	if ( !readDigits(str, 4, year) || *str++ != '-' ||
+	     !readDigits(str, 2, month) || *str++ != '-' ||
+	     !readDigits(str, 2, day) || *str++ != (format == SQL ? ' ' : 'T') ||
+	     !readDigits(str, 2, hour) || *str++ != ':' ||
+	     !readDigits(str, 2, minute) || *str++ != ':' ||
+	     !readDigits(str, 2, second) )
+		return false;
+
+	// The ranges accepted by strptime. Days beyond the end of the month
+	// roll over into the next month as with timegm.
+	if ( month < 1 || month > 12 || day < 1 || day > 31 ||
+	     hour > 23 || minute > 59 || second > 61 )
+		return false;
+
+	usecs = 0;
+
+	if ( format == ISOPrecise ) {
+		if ( *str++ != '.' ) return false;
+		int digits = 0;
+		for ( ; *str >= '0' && *str <= '9'; ++str, ++digits ) {
+			if ( digits < 6 ) usecs = usecs * 10 + (*str - '0');
+		}
+		for ( ; digits < 6; ++digits )
+			usecs *= 10;
+	}
+
+	if ( format != SQL && *str != 'Z' )
+		return false;
+
+	secs = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+	return true;
+}
+
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -884,6 +1056,12 @@ std::string Time::toString(const char* fmt) const {
 	char data[BUFFER_SIZE];
 	char predata[BUFFER_SIZE];
 
+	ISOFormat format;
+	if ( isFormat(fmt, format) ) {
+		int len = formatTime(data, (time_t)_timeval.tv_sec, _timeval.tv_usec, format);
+		if ( len >= 0 ) return std::string(data, len);
+	}
+
 	time_t secs = (time_t)_timeval.tv_sec, usecs = _timeval.tv_usec;
 	while ( usecs < 0 ) {
 		secs -= 1;
@@ -979,8 +1157,55 @@ std::string Time::iso() const {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Time::iso(char *buffer, size_t size) const {
+	char data[ISOMaxLength+1];
+	int len = formatTime(data, (time_t)_timeval.tv_sec, _timeval.tv_usec, ISOPrecise);
+	if ( len < 0 ) {
+		std::string str = iso();
+		if ( str.size() >= size ) return 0;
+		memcpy(buffer, str.c_str(), str.size()+1);
+		return str.size();
+	}
+
+	if ( (size_t)len >= size ) return 0;
+	memcpy(buffer, data, len+1);
+	return len;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Time::fromISO(const char *str) {
+	long secs, usecs;
+	if ( parseTime(str, ISOPrecise, secs, usecs) ||
+	     parseTime(str, ISOSeconds, secs, usecs) ) {
+		_timeval.tv_sec = secs;
+		_timeval.tv_usec = usecs;
+		return true;
+	}
+
+	return fromString(str, "%FT%T.%fZ") || fromString(str, "%FT%TZ");
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Time::fromString(const char* str, const char* fmt) {
+	ISOFormat format;
+	if ( isFormat(fmt, format) ) {
+		long secs, usecs;
+		if ( parseTime(str, format, secs, usecs) ) {
+			_timeval.tv_sec = secs;
+			_timeval.tv_usec = usecs;
+			return true;
+		}
+	}
+
 	struct tm t;
 	char data[BUFFER_SIZE];
 	char tmpFmt[BUFFER_SIZE];
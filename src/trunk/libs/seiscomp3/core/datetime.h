@@ -226,6 +226,8 @@ class SC_SYSTEM_CORE_API Time : public TimeSpan {
 		               specifier is replaced by the fraction of the seconds.
 		               Example:
 		               toString("%FT%T.%fZ") = "1970-01-01T00:00:00.0000Z"
+		               The formats "%FT%T.%fZ", "%FT%TZ" and "%F %T" are
+		               converted without strftime.
 		    @return A formatted string
 		 */
 		std::string toString(const char* fmt) const;
@@ -236,10 +238,34 @@ class SC_SYSTEM_CORE_API Time : public TimeSpan {
 		 */
 		std::string iso() const;
 
+		/**
+		 * Writes the time in the same format as iso() to a buffer. The
+		 * conversion does not depend on the locale and does not
+		 * allocate memory. 32 characters are sufficient for all times.
+		 * @param buffer The output buffer
+		 * @param size The size of the buffer
+		 * @return The number of characters written excluding the
+		 *         terminating null character or 0 if the buffer is
+		 *         too small
+		 */
+		size_t iso(char *buffer, size_t size) const;
+
+		/**
+		 * Converts an ISO string as written by iso() with or without
+		 * the fraction of the seconds. This is the same as
+		 * fromString(str, "%FT%T.%fZ") with a fallback to
+		 * fromString(str, "%FT%TZ").
+		 * @param str The string representation of the time
+		 * @return The conversion result
+		 */
+		bool fromISO(const char *str);
+
 		/** Converts a string into a time representation.
 		    @param str The string representation of the time
 		    @param fmt The format string containing the conversion
-		               specification (-> toString)
+		               specification (-> toString). Zero padded
+		               strings in the formats "%FT%T.%fZ", "%FT%TZ"
+		               and "%F %T" are converted without strptime.
 		    @return The conversion result
 		 */
 		bool fromString(const char* str, const char* fmt);
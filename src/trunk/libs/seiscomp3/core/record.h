@@ -35,6 +35,20 @@ class BitSet;
 
 DEFINE_SMARTPOINTER(Record);
 
+/**
+ * \brief Base class of all waveform records.
+ *
+ * Thread-safety: a record which is not modified anymore can be shared
+ * between threads without copying it, e.g. to hand a record received by
+ * the acquisition thread to several processors running in parallel.
+ * RecordPtr instances to the same record can be copied and released in any
+ * thread. All const methods can then be called concurrently with the
+ * exception of data() and saveSpace(): implementations such as MSeedRecord
+ * decode the samples on the first call of data() and saveSpace() frees
+ * them again. data() must therefore be called once before the record is
+ * shared and saveSpace() must not be called afterwards. Processors which
+ * need to modify the samples have to work on a copy of data().
+ */
 class SC_SYSTEM_CORE_API Record : public Seiscomp::Core::BaseObject {
 	DECLARE_SC_CLASS(Record)
 	DECLARE_SERIALIZATION;
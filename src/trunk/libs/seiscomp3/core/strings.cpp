@@ -35,7 +35,6 @@ namespace Core {
 namespace {
 
 const char *timeFormatPrecise = "%FT%T.%fZ";
-const char *timeFormat2 = "%FT%TZ";
 
 }
 
@@ -284,12 +283,7 @@ SC_SYSTEM_CORE_API bool fromString(bool& value, const std::string& str) {
 
 
 bool fromString(Time& value, const std::string& str) {
-	if ( !value.fromString(str.c_str(), timeFormatPrecise) ) {
-		if ( !value.fromString(str.c_str(), timeFormat2) )
-			return false;
-	}
-
-	return true;
+	return value.fromISO(str.c_str());
 }
 
 
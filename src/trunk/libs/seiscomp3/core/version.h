@@ -28,7 +28,7 @@ namespace Core {
 
 
 /* SC_API_VERSION is (major << 16) + (minor << 8) + patch. */
-#define SC_API_VERSION 0x0D0000
+#define SC_API_VERSION 0x0E0000
 
 #define SC_API_VERSION_MAJOR(v) (v >> 16)
 #define SC_API_VERSION_MINOR(v) ((v >> 8) & 0xff)
@@ -38,6 +38,55 @@ namespace Core {
 /******************************************************************************
  API Changelog
  ******************************************************************************
+ "14.0.0"   0x0E0000
+   - Changed Seiscomp::Core::BaseObject reference counter to boost::atomic
+   - Changed vtable and class layout of Seiscomp::Logging::Output (virtual flush,
+     asynchronous logging)
+   - Changed vtable of Seiscomp::Client::StreamApplication (virtual
+     flushStoredRecords)
+   - Changed class layout of Seiscomp::Client::Inventory (inventory index)
+   - Changed class layout of Seiscomp::Processing::Application (worker threads)
+   - Changed class layout of Seiscomp::DataModel::DiffMerge (content hashes)
+   - Added Seiscomp::Gui::RecordFilterJob
+   - Added Seiscomp::Gui::RecordWidget::setAsynchronousFilteringEnabled
+   - Added Seiscomp::Gui::RecordWidget::isAsynchronousFilteringEnabled
+   - Added Seiscomp::Gui::RecordWidget::isFilterPending
+   - Added Seiscomp::Gui::MapsDesc::asyncLoading
+   - Added Seiscomp::Gui::Map::TileStore::postLoaded
+   - Added Seiscomp::Gui::Map::TextureCache::endPaint
+   - Added Seiscomp::Gui::Map::TextureCache::setPrefetchEnabled
+   - Added Seiscomp::Gui::Map::TextureCache::isPrefetchEnabled
+   - Added Seiscomp::TTT::Grid
+   - Added Seiscomp::Processing::PreprocessingCache
+   - Added Seiscomp::Processing::AmplitudeProcessor::deconvolutionStage
+   - Added Seiscomp::Processing::Application::setProcessingThreads
+   - Added Seiscomp::Processing::Application::callbackMutex
+   - Added Seiscomp::Processing::Application::postNotification
+   - Added Seiscomp::Client::ThreadedQueue::tryPush
+   - Added Seiscomp::Client::StreamApplication::synchronizeAcquisition
+   - Added virtual Seiscomp::Client::StreamApplication::flushStoredRecords
+   - Added Seiscomp::LocSAT::relocate(origin, startLocations)
+   - Added Seiscomp::LocSAT::scanDepth
+   - Added Seiscomp::TTT::locsatMutex
+   - Added Seiscomp::DataModel::InventoryIndex
+   - Added Seiscomp::Client::Inventory::invalidateIndex
+   - Added Seiscomp::IO::XMLStreamReader
+   - Added Seiscomp::Logging::Output::setAsyncEnabled
+   - Added Seiscomp::Logging::Output::isAsyncEnabled
+   - Added Seiscomp::Logging::Output::droppedMessages
+   - Added Seiscomp::Logging::Output::isAsyncActive
+   - Added virtual Seiscomp::Logging::Output::flush
+   - Added Seiscomp::DataModel::StringDictionary
+   - Added Seiscomp::DataModel::EventParametersColumns
+   - Added Seiscomp::Client::SnapshotCache
+   - Added Seiscomp::Client::ConfigDB::setConfig
+   - Added Seiscomp::Core::Time::iso(char*, size_t)
+   - Added Seiscomp::Core::Time::fromISO
+   - Added Seiscomp::IO::BSONArchive::setStreaming
+   - Added Seiscomp::IO::BSONArchive::good
+   - Added Seiscomp::DataModel::Diff2::equalContent
+   - Added Seiscomp::DataModel::equalContent
+
  "13.0.0"   0x0D0000
    - Added virtual Seiscomp::IO::Database::escape
    - Renamed Seiscomp::Array::bytes() to elementSize()
@@ -22,9 +22,12 @@
 #include <seiscomp3/datamodel/creationinfo.h>
 #include <seiscomp3/datamodel/eventparameters.h>
 #include <seiscomp3/datamodel/realarray.h>
+#include <seiscomp3/datamodel/version.h>
 #include <seiscomp3/datamodel/diff.h>
+#include <seiscomp3/core/io.h>
 
 #include <sstream>
+#include <string.h>
 
 using namespace std;
 
@@ -186,6 +189,180 @@ bool compare(const Core::BaseObject *o1, const Core::BaseObject *o2,
 }
 
 
+const uint64_t HashSeed = 0x9e3779b97f4a7c15ULL;
+
+
+inline uint64_t mix(uint64_t h) {
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+
+inline uint64_t hashBytes(const void *data, size_t len, uint64_t h = 0xcbf29ce484222325ULL) {
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	for ( size_t i = 0; i < len; ++i ) {
+		h ^= bytes[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+
+/**
+ * Computes the content hashes of an object and all its children in one
+ * pass. It is written to like any other archive, hence every attribute
+ * is visited by the generated serialization code without reading the
+ * values through the meta interface which throws for unset optional
+ * attributes.
+ *
+ * The attributes of an object are hashed in order. The hashes of child
+ * objects are summed up since the diff does not depend on the order of
+ * array elements. An object which cannot be compared by its hash, e.g.
+ * because of a NaN value which does never compare equal, gets the hash 0
+ * as do all its parents.
+ */
+class HashArchive : public Core::Archive {
+	public:
+		HashArchive(Diff2::ContentHashes &hashes)
+		: _hashes(hashes), _name("") {
+			setVersion(Core::Version(Version::Major, Version::Minor));
+			Core::Archive::create(NULL);
+			_frames.push_back(Frame());
+		}
+
+		void close() {}
+
+	public:
+		void read(int&) {}
+		void read(float&) {}
+		void read(double&) {}
+		void read(std::complex<float>&) {}
+		void read(std::complex<double>&) {}
+		void read(bool&) {}
+		void read(std::vector<char>&) {}
+		void read(std::vector<int>&) {}
+		void read(std::vector<float>&) {}
+		void read(std::vector<double>&) {}
+		void read(std::vector<std::complex<double> >&) {}
+		void read(std::vector<std::string>&) {}
+		void read(std::vector<Core::Time>&) {}
+		void read(std::string&) {}
+		void read(time_t&) {}
+		void read(Core::Time&) {}
+
+	public:
+		void write(int value) { add(&value, sizeof(value)); }
+		void write(float value) { write(double(value)); }
+		void write(double value) {
+			if ( value != value ) _frames.back().comparable = false;
+			// Equal to 0.0 but with a different bit pattern
+			if ( value == 0 ) value = 0;
+			add(&value, sizeof(value));
+		}
+		void write(std::complex<float> &value) {
+			std::complex<double> tmp(value);
+			write(tmp);
+		}
+		void write(std::complex<double> &value) {
+			write(value.real());
+			write(value.imag());
+		}
+		void write(bool value) { add(&value, sizeof(value)); }
+		void write(std::vector<char> &value) { addVector(value); }
+		void write(std::vector<int> &value) { addVector(value); }
+		void write(std::vector<float> &value) {
+			for ( size_t i = 0; i < value.size(); ++i ) write(value[i]);
+		}
+		void write(std::vector<double> &value) {
+			for ( size_t i = 0; i < value.size(); ++i ) write(value[i]);
+		}
+		void write(std::vector<std::complex<double> > &value) {
+			for ( size_t i = 0; i < value.size(); ++i ) write(value[i]);
+		}
+		void write(std::vector<std::string> &value) {
+			for ( size_t i = 0; i < value.size(); ++i ) write(value[i]);
+		}
+		void write(std::string &value) { add(value.data(), value.size()); }
+		void write(std::vector<Core::Time> &value) {
+			for ( size_t i = 0; i < value.size(); ++i ) write(value[i]);
+		}
+		void write(time_t value) { add(&value, sizeof(value)); }
+		void write(Core::Time &value) {
+			long v[2] = { value.seconds(), value.microseconds() };
+			add(v, sizeof(v));
+		}
+
+	protected:
+		bool locateObjectByName(const char *name, const char *, bool) {
+			_name = name != NULL ? name : "";
+			return true;
+		}
+
+		bool locateNextObjectByName(const char *name, const char *targetClass) {
+			return locateObjectByName(name, targetClass, false);
+		}
+
+		void writeSequence(int size) { add(&size, sizeof(size)); }
+
+		std::string determineClassName() { return ""; }
+		void setClassName(const char *) {}
+
+		void serialize(RootType *object) {
+			const char *name = _name;
+			_frames.push_back(Frame());
+			Core::Archive::serialize(object);
+			Frame frame = _frames.back();
+			_frames.pop_back();
+
+			uint64_t h = 0;
+			if ( frame.comparable ) {
+				const char *className = object->className();
+				h = mix(hashBytes(className, strlen(className), frame.attributes) ^ mix(frame.children));
+				// 0 is reserved for objects which cannot be compared
+				if ( h == 0 ) h = 1;
+			}
+			else
+				_frames.back().comparable = false;
+
+			_hashes[object] = h;
+			// The name distinguishes e.g. the latitude and longitude
+			// quantities of an origin
+			_frames.back().children += mix(hashBytes(name, strlen(name)) + h);
+		}
+
+	private:
+		struct Frame {
+			Frame() : attributes(HashSeed), children(0), comparable(true) {}
+			uint64_t attributes;
+			uint64_t children;
+			bool     comparable;
+		};
+
+		void add(const void *data, size_t len) {
+			Frame &frame = _frames.back();
+			frame.attributes = mix(hashBytes(_name, strlen(_name), frame.attributes) ^
+			                       hashBytes(data, len));
+		}
+
+		template <typename T>
+		void addVector(const std::vector<T> &value) {
+			if ( value.empty() )
+				add(NULL, 0);
+			else
+				add(&value[0], value.size()*sizeof(T));
+		}
+
+	private:
+		Diff2::ContentHashes &_hashes;
+		std::vector<Frame>    _frames;
+		const char           *_name;
+};
+
+
 } // anonymous
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -193,7 +370,7 @@ bool compare(const Core::BaseObject *o1, const Core::BaseObject *o2,
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-Diff2::Diff2() {}
+Diff2::Diff2() : _depth(0) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -206,6 +383,61 @@ Diff2::~Diff2() {}
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Diff2::DiffScope::DiffScope(Diff2 *d) : diff(d) {
+	++diff->_depth;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Diff2::DiffScope::~DiffScope() {
+	// The objects may be modified after the diff
+	if ( --diff->_depth == 0 ) diff->_hashes.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool equalContent(Diff2::ContentHashes &hashes, const Object *o1, const Object *o2) {
+	const Object *objects[2] = { o1, o2 };
+	uint64_t values[2];
+
+	for ( int i = 0; i < 2; ++i ) {
+		Diff2::ContentHashes::const_iterator it = hashes.find(objects[i]);
+		if ( it == hashes.end() ) {
+			// Hashes all children of the object as well
+			Object *obj = const_cast<Object*>(objects[i]);
+			HashArchive ar(hashes);
+			ar << obj;
+
+			it = hashes.find(objects[i]);
+			if ( it == hashes.end() ) return false;
+		}
+
+		values[i] = it->second;
+	}
+
+	return values[0] != 0 && values[0] == values[1];
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Diff2::equalContent(const Object *o1, const Object *o2) {
+	return DataModel::equalContent(_hashes, o1, o2);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Diff2::LogNode::write(ostream &os, int padding, int indent,
                            bool ignoreFirstPad) const {
@@ -236,6 +468,7 @@ void Diff2::diff(Object* o1, Object* o2,
 	// Both objects empty, nothing to compare here
 	if ( !o1 && !o2 ) return;
 
+	DiffScope scope(this);
 	size_t ns = notifiers.size();
 
 	// Filter object
@@ -260,6 +493,12 @@ void Diff2::diff(Object* o1, Object* o2,
 		return;
 	}
 
+	// Equal subtrees do not produce notifiers. They are only walked if
+	// the log should list their properties.
+	if ( (!parentLogNode || parentLogNode->level() == LogNode::OPERATIONS) &&
+	     equalContent(o1, o2) )
+		return;
+
 	// UPDATE?
 	bool updateAdded = false;
 	LogNodePtr logNode;
@@ -547,6 +786,7 @@ void Diff3::diff(Object *o1, Object *o2,
 	// Both objects empty, nothing to compare here
 	if ( !o1 && !o2 ) return;
 
+	DiffScope scope(this);
 	size_t ns = notifiers.size();
 
 	// Filter object
@@ -571,6 +811,12 @@ void Diff3::diff(Object *o1, Object *o2,
 		return;
 	}
 
+	// Equal subtrees do not produce notifiers. They are only walked if
+	// the log should list their properties.
+	if ( (!parentLogNode || parentLogNode->level() == LogNode::OPERATIONS) &&
+	     equalContent(o1, o2) )
+		return;
+
 	// UPDATE?
 	bool updateAdded = false;
 	LogNodePtr logNode;
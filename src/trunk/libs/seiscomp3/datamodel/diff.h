@@ -23,8 +23,10 @@
 #include <seiscomp3/datamodel/notifier.h>
 #include <seiscomp3/datamodel/object.h>
 
+#include <boost/unordered_map.hpp>
 #include <vector>
 #include <map>
+#include <stdint.h>
 
 
 namespace Seiscomp {
@@ -87,6 +89,7 @@ class Diff2 {
 
 		typedef std::vector<Seiscomp::DataModel::NotifierPtr> Notifiers;
 		typedef std::map<std::string, const Core::MetaProperty*> PropertyIndex;
+		typedef boost::unordered_map<const Core::BaseObject*, uint64_t> ContentHashes;
 
 
 	public:
@@ -107,9 +110,44 @@ class Diff2 {
 		                    Notifiers::const_iterator end);
 
 		virtual bool blocked(const Core::BaseObject *o, LogNode *node, bool local);
+
+		/**
+		 * @brief Checks whether two objects including all their children
+		 *        are equal.
+		 *
+		 * The content hashes of all objects of a tree are computed the
+		 * first time an object of the tree is checked and cached until
+		 * the outermost diff call returns. Subtrees which are equal do not
+		 * need to be walked as they do not produce any notifier.
+		 */
+		bool equalContent(const Object *o1, const Object *o2);
+
+		//! Tracks the nesting of diff calls and clears the content hashes
+		//! when the outermost call returns
+		struct DiffScope {
+			DiffScope(Diff2 *diff);
+			~DiffScope();
+			Diff2 *diff;
+		};
+
+	private:
+		ContentHashes _hashes;
+		int           _depth;
 };
 
 
+/**
+ * @brief Checks whether two objects including all their children are equal
+ *        by comparing their content hashes.
+ *
+ * The hashes of both trees are computed on demand and stored in hashes.
+ * The hashes must be cleared if one of the objects is modified afterwards.
+ * @see Diff2::equalContent
+ */
+SC_SYSTEM_CORE_API
+bool equalContent(Diff2::ContentHashes &hashes, const Object *o1, const Object *o2);
+
+
 class Diff3 : public Diff2 {
 	public:
 		void diff(Seiscomp::DataModel::Object *o1, Seiscomp::DataModel::Object *o2,
@@ -0,0 +1,626 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#include <seiscomp3/datamodel/eventparameterscolumns.h>
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/datamodel/databasequery.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
+
+#include <limits>
+#include <math.h>
+
+
+namespace Seiscomp {
+namespace DataModel {
+
+
+namespace {
+
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+
+std::string streamID(const WaveformStreamID &id) {
+	std::string key;
+	key.reserve(id.networkCode().size() + id.stationCode().size() +
+	            id.locationCode().size() + id.channelCode().size() + 3);
+	key += id.networkCode();
+	key += '.';
+	key += id.stationCode();
+	key += '.';
+	key += id.locationCode();
+	key += '.';
+	key += id.channelCode();
+	return key;
+}
+
+
+StringDictionary::Index insertID(StringDictionary &dict, const std::string &id) {
+	return id.empty() ? StringDictionary::None : dict.insert(id);
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const StringDictionary::Index StringDictionary::None = ~StringDictionary::Index(0);
+const size_t EventParametersColumns::NoRow = ~size_t(0);
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StringDictionary::Index StringDictionary::insert(const std::string &value) {
+	std::pair<Indexes::iterator, bool> res =
+		_indexes.insert(Indexes::value_type(value, (Index)_values.size()));
+
+	if ( res.second )
+		_values.push_back(&res.first->first);
+
+	return res.first->second;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+StringDictionary::Index StringDictionary::find(const std::string &value) const {
+	Indexes::const_iterator it = _indexes.find(value);
+	return it != _indexes.end() ? it->second : None;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void StringDictionary::clear() {
+	_values.clear();
+	_indexes.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::EventParametersColumns() {
+	clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventParametersColumns::clear() {
+	_picks = Picks();
+	_origins = Origins();
+	_arrivals = Arrivals();
+	_magnitudes = Magnitudes();
+	_events = Events();
+
+	_origins.firstArrival.push_back(0);
+	_origins.firstMagnitude.push_back(0);
+
+	_pickIDs.clear();
+	_originIDs.clear();
+	_magnitudeIDs.clear();
+	_eventIDs.clear();
+	_streamIDs.clear();
+	_phases.clear();
+	_magnitudeTypes.clear();
+
+	_pickRows.clear();
+	_originRows.clear();
+	_magnitudeRows.clear();
+	_eventRows.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventParametersColumns::add(const EventParameters *ep) {
+	if ( ep == NULL ) return;
+
+	for ( size_t i = 0; i < ep->pickCount(); ++i )
+		addPick(ep->pick(i));
+
+	for ( size_t i = 0; i < ep->originCount(); ++i )
+		addOrigin(ep->origin(i));
+
+	for ( size_t i = 0; i < ep->eventCount(); ++i )
+		addEvent(ep->event(i));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool EventParametersColumns::add(const Object *obj) {
+	const Pick *pick = Pick::ConstCast(obj);
+	if ( pick != NULL ) return addPick(pick);
+
+	const Origin *origin = Origin::ConstCast(obj);
+	if ( origin != NULL ) return addOrigin(origin);
+
+	const Event *event = Event::ConstCast(obj);
+	if ( event != NULL ) return addEvent(event);
+
+	return false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::read(IO::XMLStreamReader &reader) {
+	size_t count = 0;
+	ObjectPtr obj;
+
+	// Only one object of the document is held in memory at a time
+	while ( (obj = reader.next()) != NULL ) {
+		if ( add(obj.get()) ) ++count;
+	}
+
+	return count;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::read(DatabaseQuery *query,
+                                    const Core::Time &startTime,
+                                    const Core::Time &endTime) {
+	if ( query == NULL ) return 0;
+
+	size_t count = 0;
+	DatabaseIterator it;
+
+	for ( it = query->getPicks(startTime, endTime); *it; ++it ) {
+		if ( add(*it) ) ++count;
+	}
+	it.close();
+
+	// The result set has to be closed before origins can be queried
+	std::vector<EventPtr> events;
+	for ( it = query->getEvents(startTime, endTime); *it; ++it ) {
+		Event *event = Event::Cast(*it);
+		if ( event != NULL ) events.push_back(event);
+	}
+	it.close();
+
+	for ( size_t i = 0; i < events.size(); ++i ) {
+		Event *event = events[i].get();
+		if ( addEvent(event) ) ++count;
+
+		if ( event->preferredOriginID().empty() ||
+		     originRow(event->preferredOriginID()) != NoRow )
+			continue;
+
+		OriginPtr origin = Origin::Cast(query->getObject(Origin::TypeInfo(),
+		                                                 event->preferredOriginID()));
+		if ( origin == NULL ) continue;
+
+		if ( origin->arrivalCount() == 0 )
+			query->loadArrivals(origin.get());
+		if ( origin->magnitudeCount() == 0 )
+			query->loadMagnitudes(origin.get());
+
+		if ( addOrigin(origin.get()) ) ++count;
+	}
+
+	return count;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool EventParametersColumns::addPick(const Pick *pick) {
+	Index id = _pickIDs.insert(pick->publicID());
+	if ( row(_pickRows, id) != NoRow ) return false;
+
+	setRow(_pickRows, id, _picks.size());
+
+	_picks.publicID.push_back(id);
+	_picks.time.push_back((double)pick->time().value());
+	_picks.streamID.push_back(_streamIDs.insert(streamID(pick->waveformID())));
+
+	Index phase = StringDictionary::None;
+	try { phase = _phases.insert(pick->phaseHint().code()); } catch ( ... ) {}
+	_picks.phaseHint.push_back(phase);
+
+	signed char mode = -1;
+	try { mode = (signed char)pick->evaluationMode(); } catch ( ... ) {}
+	_picks.evaluationMode.push_back(mode);
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool EventParametersColumns::addOrigin(const Origin *origin) {
+	Index id = _originIDs.insert(origin->publicID());
+	if ( row(_originRows, id) != NoRow ) return false;
+
+	size_t originRow = _origins.size();
+	setRow(_originRows, id, originRow);
+
+	_origins.publicID.push_back(id);
+	_origins.time.push_back((double)origin->time().value());
+	_origins.latitude.push_back(origin->latitude().value());
+	_origins.longitude.push_back(origin->longitude().value());
+
+	double depth = NaN;
+	try { depth = origin->depth().value(); } catch ( ... ) {}
+	_origins.depth.push_back(depth);
+
+	signed char mode = -1;
+	try { mode = (signed char)origin->evaluationMode(); } catch ( ... ) {}
+	_origins.evaluationMode.push_back(mode);
+
+	for ( size_t i = 0; i < origin->arrivalCount(); ++i ) {
+		const Arrival *arrival = origin->arrival(i);
+
+		_arrivals.origin.push_back(originRow);
+		_arrivals.pickID.push_back(insertID(_pickIDs, arrival->pickID()));
+		_arrivals.phase.push_back(_phases.insert(arrival->phase().code()));
+
+		double value = NaN;
+		try { value = arrival->distance(); } catch ( ... ) {}
+		_arrivals.distance.push_back(value);
+
+		value = NaN;
+		try { value = arrival->azimuth(); } catch ( ... ) {}
+		_arrivals.azimuth.push_back(value);
+
+		value = NaN;
+		try { value = arrival->timeResidual(); } catch ( ... ) {}
+		_arrivals.timeResidual.push_back(value);
+
+		value = NaN;
+		try { value = arrival->weight(); } catch ( ... ) {}
+		_arrivals.weight.push_back(value);
+	}
+
+	for ( size_t i = 0; i < origin->magnitudeCount(); ++i ) {
+		const Magnitude *mag = origin->magnitude(i);
+
+		Index magID = _magnitudeIDs.insert(mag->publicID());
+		if ( row(_magnitudeRows, magID) != NoRow ) continue;
+		setRow(_magnitudeRows, magID, _magnitudes.size());
+
+		_magnitudes.origin.push_back(originRow);
+		_magnitudes.publicID.push_back(magID);
+		_magnitudes.type.push_back(_magnitudeTypes.insert(mag->type()));
+		_magnitudes.value.push_back(mag->magnitude().value());
+
+		int stationCount = -1;
+		try { stationCount = mag->stationCount(); } catch ( ... ) {}
+		_magnitudes.stationCount.push_back(stationCount);
+	}
+
+	_origins.firstArrival.push_back(_arrivals.size());
+	_origins.firstMagnitude.push_back(_magnitudes.size());
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool EventParametersColumns::addEvent(const Event *event) {
+	Index id = _eventIDs.insert(event->publicID());
+	if ( row(_eventRows, id) != NoRow ) return false;
+
+	setRow(_eventRows, id, _events.size());
+
+	_events.publicID.push_back(id);
+	_events.preferredOriginID.push_back(insertID(_originIDs, event->preferredOriginID()));
+	_events.preferredMagnitudeID.push_back(insertID(_magnitudeIDs, event->preferredMagnitudeID()));
+
+	signed char type = -1;
+	try { type = (signed char)event->type(); } catch ( ... ) {}
+	_events.type.push_back(type);
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::row(const std::vector<size_t> &rows, Index index) {
+	return index < rows.size() ? rows[index] : NoRow;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void EventParametersColumns::setRow(std::vector<size_t> &rows, Index index,
+                                    size_t row) {
+	if ( index >= rows.size() )
+		rows.resize(index + 1, NoRow);
+	rows[index] = row;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::pickRow(Index publicID) const {
+	return row(_pickRows, publicID);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::originRow(Index publicID) const {
+	return row(_originRows, publicID);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::magnitudeRow(Index publicID) const {
+	return row(_magnitudeRows, publicID);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::pickRow(const std::string &publicID) const {
+	return row(_pickRows, _pickIDs.find(publicID));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::originRow(const std::string &publicID) const {
+	return row(_originRows, _originIDs.find(publicID));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::magnitudeRow(const std::string &publicID) const {
+	return row(_magnitudeRows, _magnitudeIDs.find(publicID));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t EventParametersColumns::eventRow(const std::string &publicID) const {
+	return row(_eventRows, _eventIDs.find(publicID));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::Rows
+EventParametersColumns::selectPicks(const Core::Time &startTime,
+                                    const Core::Time &endTime,
+                                    const std::string &streamID) const {
+	Rows rows;
+	double start = (double)startTime, end = (double)endTime;
+
+	if ( streamID.empty() ) {
+		for ( size_t i = 0; i < _picks.size(); ++i ) {
+			double t = _picks.time[i];
+			if ( t >= start && t < end ) rows.push_back(i);
+		}
+
+		return rows;
+	}
+
+	Index stream = _streamIDs.find(streamID);
+	if ( stream == StringDictionary::None ) return rows;
+
+	for ( size_t i = 0; i < _picks.size(); ++i ) {
+		if ( _picks.streamID[i] != stream ) continue;
+		double t = _picks.time[i];
+		if ( t >= start && t < end ) rows.push_back(i);
+	}
+
+	return rows;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::Rows
+EventParametersColumns::selectOrigins(const Core::Time &startTime,
+                                      const Core::Time &endTime,
+                                      double minLat, double maxLat,
+                                      double minLon, double maxLon) const {
+	Rows rows;
+	double start = (double)startTime, end = (double)endTime;
+	bool crossesDateLine = minLon > maxLon;
+
+	for ( size_t i = 0; i < _origins.size(); ++i ) {
+		double t = _origins.time[i];
+		if ( t < start || t >= end ) continue;
+
+		double lat = _origins.latitude[i];
+		if ( lat < minLat || lat > maxLat ) continue;
+
+		double lon = _origins.longitude[i];
+		if ( crossesDateLine ) {
+			if ( lon < minLon && lon > maxLon ) continue;
+		}
+		else if ( lon < minLon || lon > maxLon )
+			continue;
+
+		rows.push_back(i);
+	}
+
+	return rows;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::Rows
+EventParametersColumns::selectEvents(const Core::Time &startTime,
+                                     const Core::Time &endTime) const {
+	Rows rows;
+	double start = (double)startTime, end = (double)endTime;
+
+	for ( size_t i = 0; i < _events.size(); ++i ) {
+		size_t origin = originRow(_events.preferredOriginID[i]);
+		if ( origin == NoRow ) continue;
+
+		double t = _origins.time[origin];
+		if ( t >= start && t < end ) rows.push_back(i);
+	}
+
+	return rows;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::Rows
+EventParametersColumns::selectEvents(const Core::Time &startTime,
+                                     const Core::Time &endTime,
+                                     double minMagnitude) const {
+	Rows rows = selectEvents(startTime, endTime);
+	size_t count = 0;
+
+	for ( size_t i = 0; i < rows.size(); ++i ) {
+		size_t mag = magnitudeRow(_events.preferredMagnitudeID[rows[i]]);
+		if ( mag == NoRow || _magnitudes.value[mag] < minMagnitude ) continue;
+		rows[count++] = rows[i];
+	}
+
+	rows.resize(count);
+	return rows;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::vector<size_t> EventParametersColumns::countPicksPerStream() const {
+	std::vector<size_t> counts(_streamIDs.size(), 0);
+	for ( size_t i = 0; i < _picks.size(); ++i )
+		++counts[_picks.streamID[i]];
+	return counts;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::vector<size_t> EventParametersColumns::countArrivalsPerPhase() const {
+	std::vector<size_t> counts(_phases.size(), 0);
+	for ( size_t i = 0; i < _arrivals.size(); ++i )
+		++counts[_arrivals.phase[i]];
+	return counts;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+EventParametersColumns::Statistics
+EventParametersColumns::timeResiduals(const std::string &phase) const {
+	Statistics stats;
+
+	Index phaseIndex = StringDictionary::None;
+	if ( !phase.empty() ) {
+		phaseIndex = _phases.find(phase);
+		if ( phaseIndex == StringDictionary::None ) return stats;
+	}
+
+	double sum = 0, sumSquares = 0;
+
+	for ( size_t i = 0; i < _arrivals.size(); ++i ) {
+		if ( phaseIndex != StringDictionary::None && _arrivals.phase[i] != phaseIndex )
+			continue;
+
+		double res = _arrivals.timeResidual[i];
+		if ( isnan(res) ) continue;
+
+		if ( stats.count == 0 )
+			stats.min = stats.max = res;
+		else if ( res < stats.min )
+			stats.min = res;
+		else if ( res > stats.max )
+			stats.max = res;
+
+		sum += res;
+		sumSquares += res*res;
+		++stats.count;
+	}
+
+	if ( stats.count > 0 ) {
+		stats.mean = sum / stats.count;
+		stats.rms = sqrt(sumSquares / stats.count);
+	}
+
+	return stats;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+}
+}
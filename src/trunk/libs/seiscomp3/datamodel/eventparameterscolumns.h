@@ -0,0 +1,355 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_DATAMODEL_EVENTPARAMETERSCOLUMNS_H__
+#define __SEISCOMP_DATAMODEL_EVENTPARAMETERSCOLUMNS_H__
+
+
+#include <seiscomp3/core/datetime.h>
+#include <seiscomp3/core.h>
+
+#include <boost/unordered_map.hpp>
+#include <string>
+#include <vector>
+
+
+namespace Seiscomp {
+
+namespace IO {
+
+class XMLStreamReader;
+
+}
+
+namespace DataModel {
+
+
+class DatabaseQuery;
+class EventParameters;
+class Object;
+class Pick;
+class Origin;
+class Event;
+
+
+/**
+ * \brief Maps strings to consecutive indexes starting with 0.
+ *
+ * Each string is stored only once regardless how often it is inserted.
+ */
+class SC_SYSTEM_CORE_API StringDictionary {
+	// ----------------------------------------------------------------------
+	//  Public types
+	// ----------------------------------------------------------------------
+	public:
+		typedef unsigned int Index;
+
+		//! The index of values not contained in the dictionary
+		static const Index None;
+
+
+	// ----------------------------------------------------------------------
+	//  Public interface
+	// ----------------------------------------------------------------------
+	public:
+		//! Returns the index of value and adds it if it does not exist
+		Index insert(const std::string &value);
+
+		//! Returns the index of value or None
+		Index find(const std::string &value) const;
+
+		const std::string &value(Index index) const { return *_values[index]; }
+
+		size_t size() const { return _values.size(); }
+
+		void clear();
+
+
+	// ----------------------------------------------------------------------
+	//  Implementation
+	// ----------------------------------------------------------------------
+	private:
+		typedef boost::unordered_map<std::string, Index> Indexes;
+
+		// The values point to the keys of the map which are not moved
+		// when the map grows
+		Indexes                          _indexes;
+		std::vector<const std::string*>  _values;
+};
+
+
+/**
+ * \brief A read-only columnar representation of event parameters
+ *
+ * Picks, origins, arrivals, magnitudes and events are stored as one array
+ * per attribute instead of one object per instance. Stream IDs, phase codes
+ * and magnitude types are stored as indexes into dictionaries and publicIDs
+ * as indexes into a dictionary per class. Unset floating point values are
+ * stored as NaN, unset enumerations and counts as -1 and unset indexes as
+ * StringDictionary::None. That reduces the memory needed to hold millions
+ * of picks and arrivals to a fraction and allows to filter and aggregate
+ * them with linear scans.
+ *
+ * The arrivals and magnitudes of an origin are stored consecutively.
+ * Picks, origins and events may be added in any order, references
+ * between them are resolved with pickRow, originRow and magnitudeRow.
+ *
+ * \code
+ * IO::XMLStreamReader reader;
+ * reader.open("bulletin.xml");
+ * EventParametersColumns columns;
+ * columns.read(reader);
+ * std::vector<size_t> counts = columns.countPicksPerStream();
+ * for ( size_t i = 0; i < counts.size(); ++i )
+ *     std::cout << columns.streamIDs().value(i) << " " << counts[i] << std::endl;
+ * \endcode
+ */
+class SC_SYSTEM_CORE_API EventParametersColumns {
+	// ----------------------------------------------------------------------
+	//  Public types
+	// ----------------------------------------------------------------------
+	public:
+		typedef StringDictionary::Index Index;
+		typedef std::vector<size_t> Rows;
+
+		struct Picks {
+			//! Index into pickIDs()
+			std::vector<Index>        publicID;
+			//! Seconds since 1970-01-01
+			std::vector<double>       time;
+			//! Index into streamIDs(), NET.STA.LOC.CHA
+			std::vector<Index>        streamID;
+			//! Index into phases()
+			std::vector<Index>        phaseHint;
+			std::vector<signed char>  evaluationMode;
+
+			size_t size() const { return publicID.size(); }
+		};
+
+		struct Origins {
+			//! Index into originIDs()
+			std::vector<Index>        publicID;
+			std::vector<double>       time;
+			std::vector<double>       latitude;
+			std::vector<double>       longitude;
+			std::vector<double>       depth;
+			std::vector<signed char>  evaluationMode;
+			//! The arrivals of origin i are the rows [firstArrival[i],
+			//! firstArrival[i+1]). The vector holds size()+1 elements.
+			std::vector<size_t>       firstArrival;
+			//! The same as firstArrival for magnitudes
+			std::vector<size_t>       firstMagnitude;
+
+			size_t size() const { return publicID.size(); }
+		};
+
+		struct Arrivals {
+			//! Row of the origin
+			std::vector<size_t>       origin;
+			//! Index into pickIDs()
+			std::vector<Index>        pickID;
+			//! Index into phases()
+			std::vector<Index>        phase;
+			std::vector<double>       distance;
+			std::vector<double>       azimuth;
+			std::vector<double>       timeResidual;
+			std::vector<double>       weight;
+
+			size_t size() const { return origin.size(); }
+		};
+
+		struct Magnitudes {
+			//! Row of the origin
+			std::vector<size_t>       origin;
+			//! Index into magnitudeIDs()
+			std::vector<Index>        publicID;
+			//! Index into magnitudeTypes()
+			std::vector<Index>        type;
+			std::vector<double>       value;
+			std::vector<int>          stationCount;
+
+			size_t size() const { return origin.size(); }
+		};
+
+		struct Events {
+			//! Index into eventIDs()
+			std::vector<Index>        publicID;
+			//! Index into originIDs()
+			std::vector<Index>        preferredOriginID;
+			//! Index into magnitudeIDs()
+			std::vector<Index>        preferredMagnitudeID;
+			std::vector<signed char>  type;
+
+			size_t size() const { return publicID.size(); }
+		};
+
+		struct Statistics {
+			Statistics() : count(0), mean(0), rms(0), min(0), max(0) {}
+
+			size_t count;
+			double mean;
+			double rms;
+			double min;
+			double max;
+		};
+
+		//! The row returned for objects which are not contained
+		static const size_t NoRow;
+
+
+	// ----------------------------------------------------------------------
+	//  X'truction
+	// ----------------------------------------------------------------------
+	public:
+		EventParametersColumns();
+
+
+	// ----------------------------------------------------------------------
+	//  Building
+	// ----------------------------------------------------------------------
+	public:
+		void clear();
+
+		//! Adds all picks, origins and events of ep
+		void add(const EventParameters *ep);
+
+		/**
+		 * @brief Adds a pick, an origin including its arrivals and
+		 *        magnitudes or an event.
+		 * @return false if the object is of another type or if an
+		 *         object with the same publicID has been added already
+		 */
+		bool add(const Object *obj);
+
+		/**
+		 * @brief Adds all objects returned by XMLStreamReader::next()
+		 * @return The number of objects added
+		 */
+		size_t read(IO::XMLStreamReader &reader);
+
+		/**
+		 * @brief Adds the picks and events of a time window from a database
+		 *        including the preferred origins of the events and
+		 *        their arrivals and magnitudes.
+		 * @return The number of objects added
+		 */
+		size_t read(DatabaseQuery *query, const Core::Time &startTime,
+		            const Core::Time &endTime);
+
+
+	// ----------------------------------------------------------------------
+	//  Columns
+	// ----------------------------------------------------------------------
+	public:
+		const Picks &picks() const { return _picks; }
+		const Origins &origins() const { return _origins; }
+		const Arrivals &arrivals() const { return _arrivals; }
+		const Magnitudes &magnitudes() const { return _magnitudes; }
+		const Events &events() const { return _events; }
+
+		const StringDictionary &pickIDs() const { return _pickIDs; }
+		const StringDictionary &originIDs() const { return _originIDs; }
+		const StringDictionary &magnitudeIDs() const { return _magnitudeIDs; }
+		const StringDictionary &eventIDs() const { return _eventIDs; }
+		const StringDictionary &streamIDs() const { return _streamIDs; }
+		const StringDictionary &phases() const { return _phases; }
+		const StringDictionary &magnitudeTypes() const { return _magnitudeTypes; }
+
+		//! Returns the row of an object given the index of its publicID or
+		//! NoRow if the object has not been added
+		size_t pickRow(Index publicID) const;
+		size_t originRow(Index publicID) const;
+		size_t magnitudeRow(Index publicID) const;
+
+		size_t pickRow(const std::string &publicID) const;
+		size_t originRow(const std::string &publicID) const;
+		size_t magnitudeRow(const std::string &publicID) const;
+		size_t eventRow(const std::string &publicID) const;
+
+
+	// ----------------------------------------------------------------------
+	//  Filtering and aggregation
+	// ----------------------------------------------------------------------
+	public:
+		//! Returns the picks within [startTime, endTime) optionally
+		//! limited to a stream
+		Rows selectPicks(const Core::Time &startTime, const Core::Time &endTime,
+		                 const std::string &streamID = "") const;
+
+		//! Returns the origins within [startTime, endTime) and the given
+		//! region. minLon > maxLon selects a region crossing the date line.
+		Rows selectOrigins(const Core::Time &startTime, const Core::Time &endTime,
+		                   double minLat = -90, double maxLat = 90,
+		                   double minLon = -180, double maxLon = 180) const;
+
+		//! Returns the events whose preferred origin is within
+		//! [startTime, endTime)
+		Rows selectEvents(const Core::Time &startTime, const Core::Time &endTime) const;
+
+		//! Returns the events whose preferred origin is within
+		//! [startTime, endTime) and whose preferred magnitude is at
+		//! least minMagnitude
+		Rows selectEvents(const Core::Time &startTime, const Core::Time &endTime,
+		                  double minMagnitude) const;
+
+		//! Returns the number of picks per index of streamIDs()
+		std::vector<size_t> countPicksPerStream() const;
+
+		//! Returns the number of arrivals per index of phases()
+		std::vector<size_t> countArrivalsPerPhase() const;
+
+		//! Returns the statistics of the time residuals of all arrivals
+		//! with the given phase code or all arrivals if phase is empty
+		Statistics timeResiduals(const std::string &phase = "") const;
+
+
+	// ----------------------------------------------------------------------
+	//  Implementation
+	// ----------------------------------------------------------------------
+	private:
+		bool addPick(const Pick *pick);
+		bool addOrigin(const Origin *origin);
+		bool addEvent(const Event *event);
+
+		static size_t row(const std::vector<size_t> &rows, Index index);
+		static void setRow(std::vector<size_t> &rows, Index index, size_t row);
+
+
+	private:
+		Picks             _picks;
+		Origins           _origins;
+		Arrivals          _arrivals;
+		Magnitudes        _magnitudes;
+		Events            _events;
+
+		StringDictionary  _pickIDs;
+		StringDictionary  _originIDs;
+		StringDictionary  _magnitudeIDs;
+		StringDictionary  _eventIDs;
+		StringDictionary  _streamIDs;
+		StringDictionary  _phases;
+		StringDictionary  _magnitudeTypes;
+
+		// Rows per publicID index
+		std::vector<size_t> _pickRows;
+		std::vector<size_t> _originRows;
+		std::vector<size_t> _magnitudeRows;
+		std::vector<size_t> _eventRows;
+};
+
+
+}
+}
+
+
+#endif
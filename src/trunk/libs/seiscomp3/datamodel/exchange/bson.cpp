@@ -59,10 +59,12 @@ ExporterBSON::ExporterBSON() {}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool ExporterBSON::put(std::streambuf* buf, Core::BaseObject *obj) {
 	IO::BSONArchive ar;
+	ar.setStreaming(true);
 	if ( !ar.create(buf) )
 		return false;
 	ar << obj;
-	return true;
+	ar.close();
+	return ar.good();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -79,11 +81,13 @@ ExporterBSONJSON::ExporterBSONJSON() {}
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool ExporterBSONJSON::put(std::streambuf* buf, Core::BaseObject *obj) {
 	IO::BSONArchive ar;
+	ar.setStreaming(true);
+	ar.setJSON(true);
 	if ( !ar.create(buf) )
 		return false;
-	ar.setJSON(true);
 	ar << obj;
-	return true;
+	ar.close();
+	return ar.good();
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
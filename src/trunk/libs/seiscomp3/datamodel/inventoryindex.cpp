@@ -0,0 +1,292 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#include <seiscomp3/datamodel/inventoryindex.h>
+#include <seiscomp3/datamodel/inventory.h>
+
+
+namespace Seiscomp {
+namespace DataModel {
+
+
+namespace {
+
+
+std::string makeKey(const std::string &net, const std::string &sta) {
+	std::string key;
+	key.reserve(net.size() + sta.size() + 1);
+	key += net;
+	key += '.';
+	key += sta;
+	return key;
+}
+
+
+std::string makeKey(const std::string &net, const std::string &sta,
+                    const std::string &loc) {
+	std::string key;
+	key.reserve(net.size() + sta.size() + loc.size() + 2);
+	key += net;
+	key += '.';
+	key += sta;
+	key += '.';
+	key += loc;
+	return key;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool InventoryIndex::Epoch::contains(const Core::Time &time) const {
+	if ( start > time ) return false;
+	if ( !hasEnd ) return true;
+	return endIncluded ? time <= end : time < end;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void InventoryIndex::Epochs::add(const Epoch &epoch) {
+	// A binary search returns the same epoch as a linear search for the
+	// first match only if no two epochs overlap
+	if ( !items.empty() ) {
+		const Epoch &last = items.back();
+		if ( !last.hasEnd )
+			sorted = false;
+		else if ( last.endIncluded ? !(last.end < epoch.start) : epoch.start < last.end )
+			sorted = false;
+	}
+
+	items.push_back(epoch);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Object *InventoryIndex::Epochs::find(const Core::Time &time) const {
+	if ( sorted ) {
+		// Find the last epoch starting at or before time
+		size_t lo = 0, hi = items.size();
+		while ( lo < hi ) {
+			size_t mid = (lo + hi) / 2;
+			if ( time < items[mid].start )
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+
+		if ( lo > 0 && items[lo-1].contains(time) )
+			return items[lo-1].object;
+
+		return NULL;
+	}
+
+	for ( size_t i = 0; i < items.size(); ++i ) {
+		if ( items[i].contains(time) )
+			return items[i].object;
+	}
+
+	return NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+InventoryIndex::InventoryIndex() : _inventory(NULL) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+InventoryIndex::InventoryIndex(const Inventory *inventory) : _inventory(NULL) {
+	build(inventory);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void InventoryIndex::build(const Inventory *inventory) {
+	clear();
+
+	_inventory = inventory;
+	if ( _inventory == NULL ) return;
+
+	for ( size_t i = 0; i < inventory->networkCount(); ++i ) {
+		Network *network = inventory->network(i);
+
+		Epoch networkEpoch;
+		networkEpoch.start = network->start();
+		networkEpoch.endIncluded = true;
+		try {
+			networkEpoch.end = network->end();
+			networkEpoch.hasEnd = true;
+		}
+		catch ( ... ) {
+			networkEpoch.hasEnd = false;
+		}
+
+		for ( size_t j = 0; j < network->stationCount(); ++j ) {
+			Station *station = network->station(j);
+
+			// A station is only found within the epoch of its network as
+			// well, so index the intersection of both
+			Epoch epoch = networkEpoch;
+			epoch.object = station;
+			if ( station->start() > epoch.start )
+				epoch.start = station->start();
+
+			try {
+				const Core::Time &end = station->end();
+				if ( !epoch.hasEnd || end < epoch.end ) {
+					epoch.end = end;
+					epoch.hasEnd = true;
+				}
+			}
+			catch ( ... ) {}
+
+			if ( !epoch.hasEnd || !(epoch.end < epoch.start) )
+				_stations[makeKey(network->code(), station->code())].add(epoch);
+
+			// Sensor locations are looked up regardless of the station
+			// and network epochs
+			for ( size_t k = 0; k < station->sensorLocationCount(); ++k ) {
+				SensorLocation *loc = station->sensorLocation(k);
+
+				Epoch locEpoch;
+				locEpoch.object = loc;
+				locEpoch.start = loc->start();
+				locEpoch.endIncluded = false;
+				try {
+					locEpoch.end = loc->end();
+					locEpoch.hasEnd = true;
+				}
+				catch ( ... ) {
+					locEpoch.hasEnd = false;
+				}
+
+				_sensorLocations[makeKey(network->code(), station->code(), loc->code())].add(locEpoch);
+			}
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void InventoryIndex::clear() {
+	_inventory = NULL;
+	_stations.clear();
+	_sensorLocations.clear();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Station *InventoryIndex::getStation(const std::string &networkCode,
+                                    const std::string &stationCode,
+                                    const Core::Time &time,
+                                    InventoryError *error) const {
+	EpochMap::const_iterator it = _stations.find(makeKey(networkCode, stationCode));
+	if ( it != _stations.end() ) {
+		Object *obj = it->second.find(time);
+		if ( obj != NULL ) return static_cast<Station*>(obj);
+	}
+
+	// Let the linear search figure out the reason
+	if ( error != NULL )
+		DataModel::getStation(_inventory, networkCode, stationCode, time, error);
+
+	return NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+SensorLocation *InventoryIndex::getSensorLocation(const std::string &networkCode,
+                                                  const std::string &stationCode,
+                                                  const std::string &locationCode,
+                                                  const Core::Time &time,
+                                                  InventoryError *error) const {
+	EpochMap::const_iterator it = _sensorLocations.find(makeKey(networkCode, stationCode, locationCode));
+	if ( it != _sensorLocations.end() ) {
+		Object *obj = it->second.find(time);
+		if ( obj != NULL ) return static_cast<SensorLocation*>(obj);
+	}
+
+	if ( error != NULL )
+		DataModel::getSensorLocation(_inventory, networkCode, stationCode,
+		                             locationCode, time, error);
+
+	return NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Stream *InventoryIndex::getStream(const std::string &networkCode,
+                                  const std::string &stationCode,
+                                  const std::string &locationCode,
+                                  const std::string &channelCode,
+                                  const Core::Time &time,
+                                  InventoryError *error) const {
+	SensorLocation *loc = getSensorLocation(networkCode, stationCode, locationCode, time);
+	if ( loc != NULL ) {
+		// A sensor location epoch holds only a few streams
+		for ( size_t i = 0; i < loc->streamCount(); ++i ) {
+			Stream *stream = loc->stream(i);
+			if ( stream->code() != channelCode ) continue;
+
+			try {
+				if ( stream->end() <= time ) continue;
+			}
+			catch (...) {}
+
+			if ( stream->start() > time ) continue;
+
+			return stream;
+		}
+	}
+
+	if ( error != NULL )
+		DataModel::getStream(_inventory, networkCode, stationCode,
+		                     locationCode, channelCode, time, error);
+
+	return NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+}
+}
@@ -0,0 +1,132 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_DATAMODEL_INVENTORYINDEX_H__
+#define __SEISCOMP_DATAMODEL_INVENTORYINDEX_H__
+
+
+#include <seiscomp3/core/datetime.h>
+#include <seiscomp3/datamodel/utils.h>
+#include <seiscomp3/core.h>
+
+#include <boost/unordered_map.hpp>
+#include <string>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace DataModel {
+
+
+class Inventory;
+class Station;
+class SensorLocation;
+class Stream;
+
+
+/**
+ * @brief A lookup index for stations and sensor locations of an inventory.
+ *
+ * The index is built once from an inventory and maps the codes of a
+ * station and a sensor location to all their epochs. The lookup functions
+ * return exactly the same objects as getStation, getSensorLocation and
+ * getStream of datamodel/utils.h. Epochs of a code which do not overlap are
+ * searched with a binary search.
+ *
+ * The index holds plain pointers to the inventory objects. It has to be
+ * rebuilt or cleared whenever the inventory changes.
+ */
+class SC_SYSTEM_CORE_API InventoryIndex {
+	// ----------------------------------------------------------------------
+	//  X'truction
+	// ----------------------------------------------------------------------
+	public:
+		InventoryIndex();
+		InventoryIndex(const Inventory *inventory);
+
+
+	// ----------------------------------------------------------------------
+	//  Public interface
+	// ----------------------------------------------------------------------
+	public:
+		//! Rebuilds the index for the given inventory
+		void build(const Inventory *inventory);
+		void clear();
+
+		//! Returns the indexed inventory or NULL
+		const Inventory *inventory() const { return _inventory; }
+
+		Station* getStation(const std::string &networkCode,
+		                    const std::string &stationCode,
+		                    const Core::Time &,
+		                    InventoryError *error = NULL) const;
+
+		SensorLocation* getSensorLocation(const std::string &networkCode,
+		                                  const std::string &stationCode,
+		                                  const std::string &locationCode,
+		                                  const Core::Time &,
+		                                  InventoryError *error = NULL) const;
+
+		Stream* getStream(const std::string &networkCode,
+		                  const std::string &stationCode,
+		                  const std::string &locationCode,
+		                  const std::string &channelCode,
+		                  const Core::Time &,
+		                  InventoryError *error = NULL) const;
+
+
+	// ----------------------------------------------------------------------
+	//  Private types
+	// ----------------------------------------------------------------------
+	private:
+		struct Epoch {
+			Core::Time  start;
+			Core::Time  end;
+			bool        hasEnd;
+			// Whether end belongs to the epoch
+			bool        endIncluded;
+			Object      *object;
+
+			bool contains(const Core::Time &time) const;
+		};
+
+		struct Epochs {
+			Epochs() : sorted(true) {}
+
+			// Epochs in the order of the inventory
+			std::vector<Epoch> items;
+			// Whether the epochs are sorted by time and do not overlap
+			bool               sorted;
+
+			void add(const Epoch &);
+			Object *find(const Core::Time &time) const;
+		};
+
+		typedef boost::unordered_map<std::string, Epochs> EpochMap;
+
+
+	// ----------------------------------------------------------------------
+	//  Private members
+	// ----------------------------------------------------------------------
+	private:
+		const Inventory *_inventory;
+		EpochMap         _stations;
+		EpochMap         _sensorLocations;
+};
+
+
+}
+}
+
+
+#endif
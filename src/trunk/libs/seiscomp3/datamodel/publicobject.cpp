@@ -153,9 +153,9 @@ bool PublicObject::registerMe() {
 
 	boost::mutex::scoped_lock lk(cacheMutex);
 
-	PublicObjectMap::iterator it = _publicObjects.find(_publicID);
-	if ( it == _publicObjects.end() ) {
-		_publicObjects[_publicID] = this;
+	// Insert only if the publicID is not yet registered, that saves a
+	// second lookup
+	if ( _publicObjects.insert(PublicObjectMap::value_type(_publicID, this)).second ) {
 		_registered = true;
 		return true;
 	}
@@ -887,6 +887,10 @@ void DiffMerge::diffRecursive(Object* o1, Object* o2, const std::string& o1Paren
 		return;
 	}
 
+	// Equal subtrees do not produce notifiers. They are only walked if
+	// the comparison is logged.
+	if ( !_currentNode && equalContent(_hashes, o1, o2) ) return;
+
 	LogNodePtr l_currentNode = _currentNode;
 	if ( _currentNode )
 		_currentNode = _currentNode->add(new LogNode(o1));
@@ -1008,8 +1012,11 @@ bool DiffMerge::diff(Object* o1, Object* o2, std::vector<NotifierPtr>& diffList)
 	// Set the logger
 	_currentNode = newNode;
 
-	// Recursively diff both objects
+	// Recursively diff both objects. The objects may have been modified
+	// since the last diff, e.g. if it threw, so the hashes are not reused.
+	_hashes.clear();
 	diffRecursive(o1, o2, parentID, diffList);
+	_hashes.clear();
 	
 	// Restore the logger
 	_currentNode = newNode;
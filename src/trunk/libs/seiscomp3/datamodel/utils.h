@@ -21,6 +21,7 @@
 #include <seiscomp3/datamodel/object.h>
 #include <seiscomp3/datamodel/types.h>
 #include <seiscomp3/datamodel/creationinfo.h>
+#include <seiscomp3/datamodel/diff.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -439,8 +440,9 @@ class SC_SYSTEM_CORE_API DiffMerge {
 
 
 	private:
-		LogNodePtr _currentNode;
-		int        _logLevel;
+		LogNodePtr            _currentNode;
+		int                   _logLevel;
+		Diff2::ContentHashes  _hashes;
 };
 
 
@@ -55,6 +55,280 @@ ssize_t streamBufReadCallback2(void* context, void* buffer, size_t len) {
 	return streamBufReadCallback(context, (unsigned char *) buffer, len);
 }
 
+
+/**
+ * Writes BSON elements or their JSON representation as created by
+ * bson_as_json directly to a stream buffer. Open documents and arrays are
+ * kept on a stack of frames, frame 0 is the root document. Elements are
+ * appended to the frame at a given level after all frames above have
+ * been closed.
+ *
+ * The length of a BSON document is written in front of it but only known
+ * when the document is closed. The output is therefore collected in a
+ * buffer which is flushed when it exceeds FlushThreshold if the stream
+ * buffer is seekable. Length prefixes of documents that have already been
+ * flushed are patched by seeking back. JSON output is flushed regardless.
+ */
+class StreamWriter {
+	public:
+		StreamWriter(std::streambuf *buf, bool json)
+		: _buf(buf), _json(json), _good(true), _offset(0) {
+			try {
+				_origin = _buf->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
+			}
+			catch ( std::exception & ) {
+				// Filtering stream buffers throw if not seekable
+				_origin = std::streampos(std::streamoff(-1));
+			}
+
+			_seekable = _origin != std::streampos(std::streamoff(-1));
+			_data.reserve(FlushThreshold + 4096);
+
+			Frame root;
+			root.start = 0;
+			root.array = false;
+			root.count = 0;
+			_frames.push_back(root);
+
+			if ( _json )
+				put("{ ", 2);
+			else
+				putLE<int32_t>(0);
+		}
+
+	public:
+		size_t depth() const { return _frames.size(); }
+		bool good() const { return _good; }
+
+		void beginDocument(size_t level, const char *key) {
+			beginFrame(level, BSON_TYPE_DOCUMENT, key);
+		}
+
+		void beginArray(size_t level, const char *key) {
+			beginFrame(level, BSON_TYPE_ARRAY, key);
+		}
+
+		//! Closes all frames above level
+		void close(size_t level) {
+			while ( _frames.size() > level+1 )
+				endFrame();
+		}
+
+		//! Closes all frames and flushes the remaining output
+		void finish() {
+			while ( !_frames.empty() )
+				endFrame();
+			flush();
+		}
+
+		void appendUtf8(size_t level, const char *key, const char *value, size_t len) {
+			element(level, BSON_TYPE_UTF8, key);
+			if ( _json )
+				putEscaped(value, len);
+			else {
+				putLE<int32_t>(len+1);
+				put(value, len);
+				putByte(0);
+			}
+		}
+
+		void appendInt32(size_t level, const char *key, int32_t value) {
+			element(level, BSON_TYPE_INT32, key);
+			if ( _json )
+				putFormatted("%lld", value);
+			else
+				putLE<int32_t>(value);
+		}
+
+		void appendInt64(size_t level, const char *key, int64_t value) {
+			element(level, BSON_TYPE_INT64, key);
+			if ( _json )
+				putFormatted("%lld", (long long)value);
+			else
+				putLE<int64_t>(value);
+		}
+
+		void appendDouble(size_t level, const char *key, double value) {
+			element(level, BSON_TYPE_DOUBLE, key);
+			if ( _json ) {
+				char tmp[64];
+				int len = snprintf(tmp, sizeof(tmp), "%.20g", value);
+				put(tmp, len);
+				// Distinguish 3.0 from 3 as libbson does
+				if ( strspn(tmp, "0123456789-") == (size_t)len )
+					put(".0", 2);
+			}
+			else {
+				uint64_t bits;
+				memcpy(&bits, &value, sizeof(bits));
+				putLE<uint64_t>(bits);
+			}
+		}
+
+		void appendBool(size_t level, const char *key, bool value) {
+			element(level, BSON_TYPE_BOOL, key);
+			if ( _json )
+				put(value ? "true" : "false", value ? 4 : 5);
+			else
+				putByte(value ? 1 : 0);
+		}
+
+		void appendNull(size_t level, const char *key) {
+			element(level, BSON_TYPE_NULL, key);
+			if ( _json )
+				put("null", 4);
+		}
+
+		void appendDateTime(size_t level, const char *key, int64_t msecs) {
+			element(level, BSON_TYPE_DATE_TIME, key);
+			if ( _json )
+				putFormatted("{ \"$date\" : %lld }", (long long)msecs);
+			else
+				putLE<int64_t>(msecs);
+		}
+
+	private:
+		struct Frame {
+			std::streamoff start;
+			bool           array;
+			int            count;
+		};
+
+		static const size_t FlushThreshold = 65536;
+
+		std::streamoff position() const {
+			return _offset + (std::streamoff)_data.size();
+		}
+
+		void element(size_t level, bson_type_t type, const char *key) {
+			close(level);
+
+			Frame &frame = _frames.back();
+			if ( _json ) {
+				if ( frame.count > 0 ) put(", ", 2);
+				if ( !frame.array ) {
+					putEscaped(key, strlen(key));
+					put(" : ", 3);
+				}
+			}
+			else {
+				putByte((char)type);
+				put(key, strlen(key)+1);
+			}
+
+			++frame.count;
+		}
+
+		void beginFrame(size_t level, bson_type_t type, const char *key) {
+			element(level, type, key);
+
+			Frame frame;
+			frame.start = position();
+			frame.array = type == BSON_TYPE_ARRAY;
+			frame.count = 0;
+			_frames.push_back(frame);
+
+			if ( _json )
+				put(frame.array ? "[ " : "{ ", 2);
+			else
+				putLE<int32_t>(0);
+		}
+
+		void endFrame() {
+			Frame frame = _frames.back();
+			_frames.pop_back();
+
+			if ( _json ) {
+				// An empty root document is written as "{ }"
+				if ( _frames.empty() && frame.count == 0 )
+					put("}", 1);
+				else
+					put(frame.array ? " ]" : " }", 2);
+			}
+			else {
+				putByte(0);
+				patch(frame.start, (int32_t)(position() - frame.start));
+			}
+		}
+
+		void put(const char *data, size_t len) {
+			_data.append(data, len);
+			if ( _data.size() >= FlushThreshold && (_json || _seekable) )
+				flush();
+		}
+
+		void putByte(char c) {
+			_data += c;
+		}
+
+		template <typename T>
+		void putLE(T value) {
+			char bytes[sizeof(T)];
+			uint64_t v = (uint64_t)value;
+			for ( size_t i = 0; i < sizeof(T); ++i, v >>= 8 )
+				bytes[i] = (char)(v & 0xff);
+			put(bytes, sizeof(T));
+		}
+
+		void putFormatted(const char *fmt, long long value) {
+			char tmp[64];
+			int len = snprintf(tmp, sizeof(tmp), fmt, value);
+			put(tmp, len);
+		}
+
+		void putEscaped(const char *str, size_t len) {
+			char *escaped = bson_utf8_escape_for_json(str, len);
+			if ( escaped == NULL ) {
+				// Invalid UTF-8, bson_as_json would fail as a whole
+				_good = false;
+				put("null", 4);
+				return;
+			}
+
+			put("\"", 1);
+			put(escaped, strlen(escaped));
+			put("\"", 1);
+			bson_free(escaped);
+		}
+
+		void patch(std::streamoff pos, int32_t value) {
+			char bytes[4];
+			for ( int i = 0; i < 4; ++i )
+				bytes[i] = (char)((uint32_t)value >> (i*8));
+
+			int flushed = 0;
+			if ( pos < _offset ) {
+				// Rewrite the bytes already passed to the stream buffer
+				flushed = (int)std::min(std::streamoff(4), _offset - pos);
+				if ( _buf->pubseekpos(_origin + pos, std::ios_base::out) == std::streampos(std::streamoff(-1))
+				  || _buf->sputn(bytes, flushed) != flushed
+				  || _buf->pubseekpos(_origin + _offset, std::ios_base::out) == std::streampos(std::streamoff(-1)) )
+					_good = false;
+			}
+
+			for ( int i = flushed; i < 4; ++i )
+				_data[pos + i - _offset] = bytes[i];
+		}
+
+		void flush() {
+			if ( _data.empty() ) return;
+			if ( _buf->sputn(_data.data(), _data.size()) != (std::streamsize)_data.size() )
+				_good = false;
+			_offset += _data.size();
+			_data.clear();
+		}
+
+	private:
+		std::streambuf    *_buf;
+		bool               _json;
+		bool               _good;
+		bool               _seekable;
+		std::streampos     _origin;
+		std::streamoff     _offset;
+		std::string        _data;
+		std::vector<Frame> _frames;
+};
+
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -71,6 +345,10 @@ class BSONArchive::BSONImpl : public Core::BaseObject {
 			bsonReader = NULL;
 			jsonReader = NULL;
 			links = NULL;
+			writer = NULL;
+			filter = NULL;
+			level = 0;
+			sequence = false;
 		}
 
 		const bson_t       *root;
@@ -85,6 +363,12 @@ class BSONArchive::BSONImpl : public Core::BaseObject {
 		bson_iter_t         iterChildren;
 
 		std::list<std::pair<std::string, bson_t*> > *links;
+
+		// Streaming output
+		StreamWriter       *writer;
+		boost::iostreams::filtering_ostreambuf *filter;
+		size_t              level;
+		bool                sequence;
 };
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -100,6 +384,8 @@ BSONArchive::BSONArchive() : Seiscomp::Core::Archive() {
 	_deleteOnClose = false;
 	_compression = false;
 	_json = false;
+	_streaming = false;
+	_good = true;
 	_forceWriteVersion = -1;
 
 	_impl = new BSONImpl;
@@ -118,6 +404,8 @@ BSONArchive::BSONArchive(std::streambuf* buf, bool isReading, int forceWriteVers
 	_deleteOnClose = false;
 	_compression = false;
 	_json = false;
+	_streaming = false;
+	_good = true;
 	_forceWriteVersion = forceWriteVersion;
 
 	_impl = new BSONImpl;
@@ -329,6 +617,8 @@ bool BSONArchive::create(bool writeVersion) {
 	if ( !Seiscomp::Core::Archive::create(NULL) )
 		return false;
 
+	_good = true;
+
 	if ( writeVersion ) {
 		if ( _forceWriteVersion >= 0 )
 			setVersion(Core::Version(_forceWriteVersion));
@@ -338,10 +628,29 @@ bool BSONArchive::create(bool writeVersion) {
 	else
 		setVersion(Core::Version(0,0));
 
+	std::string version = Core::toString(versionMajor()) + "." + Core::toString(versionMinor());
+
+	if ( _streaming && _buf != NULL ) {
+		std::streambuf *buf = _buf;
+
+		if ( _compression ) {
+			_impl->filter = new boost::iostreams::filtering_ostreambuf;
+			_impl->filter->push(boost::iostreams::zlib_compressor());
+			_impl->filter->push(*_buf);
+			buf = _impl->filter;
+		}
+
+		_impl->writer = new StreamWriter(buf, _json);
+		_impl->level = 0;
+		_impl->sequence = false;
+		_impl->writer->appendUtf8(0, "version", version.c_str(), version.size());
+		return true;
+	}
+
 	_impl->current = bson_new();
 	_impl->links = new std::list<std::pair<std::string, bson_t*> >;
 
-	bson_append_utf8(_impl->current, "version", -1, (Seiscomp::Core::toString(versionMajor()) + "." + Seiscomp::Core::toString(versionMinor())).c_str(), -1);
+	bson_append_utf8(_impl->current, "version", -1, version.c_str(), -1);
 
 	return true;
 }
@@ -366,6 +675,26 @@ void BSONArchive::close() {
 			_impl->bsonReader = NULL;
 		}
 	}
+	else if ( _impl->writer != NULL ) {
+		_impl->writer->finish();
+		if ( !_impl->writer->good() )
+			_good = false;
+
+		delete _impl->writer;
+		_impl->writer = NULL;
+
+		// Flushes the compressor
+		if ( _impl->filter != NULL ) {
+			delete _impl->filter;
+			_impl->filter = NULL;
+		}
+
+		if ( _buf->pubsync() == -1 )
+			_good = false;
+
+		if ( !_good )
+			SEISCOMP_ERROR("Failed to write BSON stream");
+	}
 	else {
 		if ( _impl->links != NULL ) {
 			while ( _impl->links->size() > 0 ) {
@@ -392,11 +721,13 @@ void BSONArchive::close() {
 			if ( _json ) {
 				size_t len;
 				char* str = bson_as_json(_impl->current, &len);
-				buf->sputn(str, len);
+				if ( str == NULL || buf->sputn(str, len) != (std::streamsize)len )
+					_good = false;
 				bson_free(str);
 			}
 			else {
-				buf->sputn((const char *) bson_get_data(_impl->current), _impl->current->len);
+				if ( buf->sputn((const char *) bson_get_data(_impl->current), _impl->current->len) != (std::streamsize)_impl->current->len )
+					_good = false;
 			}
 		}
 
@@ -435,6 +766,24 @@ void BSONArchive::setJSON(bool enable) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void BSONArchive::setStreaming(bool enable) {
+	_streaming = enable;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool BSONArchive::good() const {
+	return _good;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::read(time_t& value) {
 	switch ( bson_iter_type (&_impl->iter) ) {
@@ -792,7 +1141,10 @@ void BSONArchive::read(std::vector<std::complex<double> >& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(time_t value) {
-	bson_append_time_t(_impl->current, _attribName.c_str(), -1, value);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendDateTime(_impl->level, _attribName.c_str(), (int64_t)value * 1000);
+	else
+		bson_append_time_t(_impl->current, _attribName.c_str(), -1, value);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -801,7 +1153,15 @@ void BSONArchive::write(time_t value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(Seiscomp::Core::Time& value) {
-	if ( value.valid() || (hint() & XML_MANDATORY) )
+	if ( _impl->writer != NULL ) {
+		if ( value.valid() || (hint() & XML_MANDATORY) ) {
+			std::string str = Core::toString(value);
+			_impl->writer->appendUtf8(_impl->level, _attribName.c_str(), str.c_str(), str.size());
+		}
+		else
+			_impl->writer->appendNull(_impl->level, _attribName.c_str());
+	}
+	else if ( value.valid() || (hint() & XML_MANDATORY) )
 		bson_append_utf8(_impl->current, _attribName.c_str(), -1, Core::toString(value).c_str(), -1);
 	else
 		bson_append_null(_impl->current, _attribName.c_str(), -1);
@@ -813,10 +1173,18 @@ void BSONArchive::write(Seiscomp::Core::Time& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(int value) {
-	if ( (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) )
-		bson_append_int32(_impl->current, _attribName.c_str(), -1, value);
-	else
-		bson_append_int64(_impl->current, _attribName.c_str(), -1, value);
+	if ( (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) ) {
+		if ( _impl->writer != NULL )
+			_impl->writer->appendInt32(_impl->level, _attribName.c_str(), value);
+		else
+			bson_append_int32(_impl->current, _attribName.c_str(), -1, value);
+	}
+	else {
+		if ( _impl->writer != NULL )
+			_impl->writer->appendInt64(_impl->level, _attribName.c_str(), value);
+		else
+			bson_append_int64(_impl->current, _attribName.c_str(), -1, value);
+	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -825,7 +1193,10 @@ void BSONArchive::write(int value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(float value) {
-	bson_append_double(_impl->current, _attribName.c_str(), -1, value);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendDouble(_impl->level, _attribName.c_str(), value);
+	else
+		bson_append_double(_impl->current, _attribName.c_str(), -1, value);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -834,7 +1205,10 @@ void BSONArchive::write(float value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(double value) {
-	bson_append_double(_impl->current, _attribName.c_str(), -1, value);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendDouble(_impl->level, _attribName.c_str(), value);
+	else
+		bson_append_double(_impl->current, _attribName.c_str(), -1, value);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -843,7 +1217,10 @@ void BSONArchive::write(double value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(bool value) {
-	bson_append_bool(_impl->current, _attribName.c_str(), -1, value);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendBool(_impl->level, _attribName.c_str(), value);
+	else
+		bson_append_bool(_impl->current, _attribName.c_str(), -1, value);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -852,7 +1229,10 @@ void BSONArchive::write(bool value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(std::string& value) {
-	bson_append_utf8(_impl->current, _attribName.c_str(), -1, value.c_str(), -1);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendUtf8(_impl->level, _attribName.c_str(), value.c_str(), strlen(value.c_str()));
+	else
+		bson_append_utf8(_impl->current, _attribName.c_str(), -1, value.c_str(), -1);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -861,7 +1241,10 @@ void BSONArchive::write(std::string& value) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void BSONArchive::write(char& value) {
-	bson_append_utf8(_impl->current, _attribName.c_str(), -1, &value, 1);
+	if ( _impl->writer != NULL )
+		_impl->writer->appendUtf8(_impl->level, _attribName.c_str(), &value, 1);
+	else
+		bson_append_utf8(_impl->current, _attribName.c_str(), -1, &value, 1);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -873,8 +1256,15 @@ template<typename T>
 void BSONArchive::writeVector(std::vector<T>& value) {
 	bson_t b = BSON_INITIALIZER;
 	bson_t* current = _impl->current;
+	size_t level = _impl->level;
 	std::string attribName = _attribName;
-	_impl->current = &b;
+
+	if ( _impl->writer != NULL ) {
+		_impl->writer->beginArray(level, attribName.c_str());
+		_impl->level = _impl->writer->depth()-1;
+	}
+	else
+		_impl->current = &b;
 
 	int arrayIndex = 0;
 
@@ -886,8 +1276,13 @@ void BSONArchive::writeVector(std::vector<T>& value) {
 
 	_attribName = attribName;
 	_impl->current = current;
+	_impl->level = level;
+
+	if ( _impl->writer != NULL )
+		_impl->writer->close(level);
+	else
+		bson_append_array(_impl->current, _attribName.c_str(), -1, &b);
 
-	bson_append_array(_impl->current, _attribName.c_str(), -1, &b);
 	bson_destroy(&b);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -1021,6 +1416,7 @@ bool BSONArchive::locateObjectByName(const char* name, const char* targetClass,
 			else {
 				_attribName = name;
 				_impl->children = NULL;
+				_impl->sequence = false;
 				return true;
 			}
 		}
@@ -1051,6 +1447,7 @@ bool BSONArchive::locateObjectByName(const char* name, const char* targetClass,
 			else {
 				_attribName = targetClass;
 				_impl->children = NULL;
+				_impl->sequence = false;
 				return true;
 			}
 		}
@@ -1127,9 +1524,18 @@ void BSONArchive::setClassName(const char* className) {
 	}
 
 	if ( _className.length() > 0 && _startSequence ) {
-		_impl->children = bson_new();
 		_siblingCount = 0;
-		_impl->links->push_back(make_pair(_attribName, _impl->children));
+
+		// Opens the array of the sequence in the current document. It is
+		// closed with the next element written to the document.
+		if ( _impl->writer != NULL ) {
+			_impl->writer->beginArray(_impl->level, _attribName.c_str());
+			_impl->sequence = true;
+		}
+		else {
+			_impl->children = bson_new();
+			_impl->links->push_back(make_pair(_attribName, _impl->children));
+		}
 	}
 
 	_startSequence = false;
@@ -1156,6 +1562,8 @@ void BSONArchive::serialize(RootType* object) {
 	bson_iter_t iterParent = _impl->iterParent;
 	bson_iter_t iterChildren = _impl->iterChildren;
 	std::list<std::pair<std::string, bson_t*> >* links = _impl->links;
+	size_t level = _impl->level;
+	bool sequence = _impl->sequence;
 	std::string attribName = _attribName;
 	std::string className = _className;
 	int siblingCount = _siblingCount;
@@ -1165,6 +1573,17 @@ void BSONArchive::serialize(RootType* object) {
 		if ( !bson_iter_recurse(&_impl->iter, &_impl->iterParent) )
 			SEISCOMP_ERROR("Could not recurse into %s", attribName.c_str());
 	}
+	else if ( _impl->writer != NULL ) {
+		if ( sequence )
+			_impl->writer->beginDocument(level+1, Core::toString(siblingCount).c_str());
+		else
+			_impl->writer->beginDocument(level, attribName.c_str());
+
+		_impl->level = _impl->writer->depth()-1;
+		_impl->sequence = false;
+		_siblingCount = 0;
+		_startSequence = false;
+	}
 	else {
 		_impl->current = bson_new();
 		_impl->children = NULL;
@@ -1175,7 +1594,12 @@ void BSONArchive::serialize(RootType* object) {
 
 	Seiscomp::Core::Archive::serialize(object);
 
-	if ( !isReading() ) {
+	if ( !isReading() && _impl->writer != NULL ) {
+		// Closes the document of the object and all arrays opened in it
+		_impl->writer->close(_impl->level-1);
+		if ( sequence ) ++siblingCount;
+	}
+	else if ( !isReading() ) {
 		while ( _impl->links->size() > 0 ) {
 			std::pair<std::string, bson_t*> link = _impl->links->front();
 			_impl->links->pop_front();
@@ -1201,6 +1625,8 @@ void BSONArchive::serialize(RootType* object) {
 	_impl->iterParent = iterParent;
 	_impl->iterChildren = iterChildren;
 	_impl->links = links;
+	_impl->level = level;
+	_impl->sequence = sequence;
 	_attribName = attribName;
 	_className = className;
 	_siblingCount = siblingCount;
@@ -1218,6 +1644,8 @@ void BSONArchive::serialize(SerializeDispatcher& disp) {
 	bson_iter_t iterParent = _impl->iterParent;
 	bson_iter_t iterChildren = _impl->iterChildren;
 	std::list<std::pair<std::string, bson_t*> >* links = _impl->links;
+	size_t level = _impl->level;
+	bool sequence = _impl->sequence;
 	std::string attribName = _attribName;
 	std::string className = _className;
 	int siblingCount = _siblingCount;
@@ -1230,6 +1658,8 @@ void BSONArchive::serialize(SerializeDispatcher& disp) {
 	_impl->iterParent = iterParent;
 	_impl->iterChildren = iterChildren;
 	_impl->links = links;
+	_impl->level = level;
+	_impl->sequence = sequence;
 	_attribName = attribName;
 	_className = className;
 	_siblingCount = siblingCount;
@@ -71,6 +71,29 @@ class SC_SYSTEM_CORE_API BSONArchive : public Seiscomp::Core::Archive {
 		 */
 		void setJSON(bool enable);
 
+		/**
+		 * Enables/Disables streaming output. Instead of building the
+		 * document tree in memory and writing it when the archive is
+		 * closed each element is written to the stream buffer while the
+		 * objects are serialized. The length prefixes of BSON documents
+		 * are patched by seeking back if the stream buffer supports it,
+		 * otherwise the output is buffered until close. JSON output does
+		 * not require seeking. The output is the same as without
+		 * streaming.
+		 * This flag, the compression and the JSON flag must be set before
+		 * calling create.
+		 * @param enable The state of this flag
+		 */
+		void setStreaming(bool enable);
+
+		/**
+		 * Returns whether the output of the last written archive has
+		 * been passed completely to the stream buffer. With streaming
+		 * output this includes patching the length prefixes. The state
+		 * is updated when the archive is closed.
+		 */
+		bool good() const;
+
 
 	// ----------------------------------------------------------------------
 	//  Read methods
@@ -216,6 +239,8 @@ class SC_SYSTEM_CORE_API BSONArchive : public Seiscomp::Core::Archive {
 
 		bool                   _compression;
 		bool                   _json;
+		bool                   _streaming;
+		bool                   _good;
 		int                    _forceWriteVersion;
 };
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
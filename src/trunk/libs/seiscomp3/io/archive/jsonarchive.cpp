@@ -59,15 +59,18 @@ struct jsonstring {
 };
 
 
-ostream &operator<<(ostream &os, const jsontime_t &js) {
-	//os << js.ref << "000";
-	os << Core::Time(js.ref).toString("\"" DATE_FORMAT "\"");
+ostream &operator<<(ostream &os, const jsontime &js) {
+	char buf[32];
+	size_t len = js.ref.iso(buf, sizeof(buf));
+	os.put('"');
+	os.write(buf, len);
+	os.put('"');
 	return os;
 }
 
-ostream &operator<<(ostream &os, const jsontime &js) {
-	os << js.ref.toString("\"" DATE_FORMAT "\"");
-	return os;
+ostream &operator<<(ostream &os, const jsontime_t &js) {
+	//os << js.ref << "000";
+	return os << jsontime(Core::Time(js.ref));
 }
 
 ostream &operator<<(ostream &os, const jsonstring &js) {
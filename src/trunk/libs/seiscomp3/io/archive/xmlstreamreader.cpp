@@ -0,0 +1,571 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_COMPONENT XMLArchive
+#include <seiscomp3/logging/log.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
+#include <seiscomp3/datamodel/notifier.h>
+
+#include <libxml/xmlreader.h>
+
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+
+
+namespace Seiscomp {
+namespace IO {
+
+
+namespace {
+
+
+int streamBufReadCallback(void* context, char* buffer, int len) {
+	std::streambuf* buf = static_cast<std::streambuf*>(context);
+	if ( buf == NULL ) return -1;
+
+	int count = 0;
+	int ch = buf->sgetc();
+	while ( ch != EOF && len-- && ch != '\0' ) {
+		*buffer++ = (char)buf->sbumpc();
+		ch = buf->sgetc();
+		++count;
+	}
+
+	return count;
+}
+
+
+int streamBufCloseCallback(void* context) {
+	return 0;
+}
+
+
+// Reads an in-memory document with the regular XMLArchive
+class SubtreeArchive : public XMLArchive {
+	public:
+		bool open(xmlDocPtr doc, const Core::Version &version, bool hasRoot) {
+			close();
+
+			if ( !Seiscomp::Core::Archive::open(NULL) ) {
+				xmlFreeDoc(doc);
+				return false;
+			}
+
+			_document = doc;
+			// Same as XMLArchive::open if the root element is not the
+			// configured root tag
+			_current = hasRoot ? (void*)xmlDocGetRootElement(doc) : (void*)doc;
+			setVersion(version);
+
+			return true;
+		}
+
+		// Reads an object directly from an element of another document
+		bool read(xmlNodePtr node, const Core::Version &version,
+		          Core::BaseObject *object) {
+			close();
+
+			if ( !Seiscomp::Core::Archive::open(NULL) )
+				return false;
+
+			setVersion(version);
+			_objectLocation = node;
+			serialize(object);
+			_objectLocation = NULL;
+
+			return success();
+		}
+};
+
+
+// Collects the direct children of an object
+class ChildCollector : public DataModel::Visitor {
+	public:
+		ChildCollector(DataModel::PublicObject *parent) : _parent(parent) {}
+
+	public:
+		bool visit(DataModel::PublicObject *po) {
+			if ( po == _parent ) return true;
+			if ( po->parent() == _parent ) children.push_back(po);
+			return false;
+		}
+
+		void visit(DataModel::Object *o) {
+			if ( o->parent() == _parent ) children.push_back(o);
+		}
+
+	public:
+		std::vector<DataModel::ObjectPtr> children;
+
+	private:
+		DataModel::PublicObject *_parent;
+};
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+XMLStreamReader::XMLStreamReader()
+: _reader(NULL)
+, _root(NULL)
+, _buf(NULL)
+, _filter(NULL)
+, _deleteOnClose(false)
+, _rootTag("seiscomp")
+, _compression(false)
+, _compressionMethod(XMLArchive::ZIP)
+, _version(0,0)
+, _topLevelDepth(1)
+, _pending(false)
+, _skip(false) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+XMLStreamReader::~XMLStreamReader() {
+	close();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool XMLStreamReader::open(const char *filename) {
+	close();
+
+	if ( !strcmp(filename, "-") ) {
+		_buf = std::cin.rdbuf();
+		_deleteOnClose = false;
+	}
+	else {
+		std::filebuf* fb = new std::filebuf();
+		if ( fb->open(filename, std::ios::in) == NULL ) {
+			delete fb;
+			return false;
+		}
+
+		_buf = fb;
+		_deleteOnClose = true;
+	}
+
+	return open();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool XMLStreamReader::open(std::streambuf *buf) {
+	close();
+
+	if ( buf == NULL ) return false;
+
+	_buf = buf;
+	_deleteOnClose = false;
+
+	return open();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool XMLStreamReader::open() {
+	std::streambuf *input = _buf;
+
+	if ( _compression ) {
+		boost::iostreams::filtering_istreambuf *filter = new boost::iostreams::filtering_istreambuf;
+
+		switch ( _compressionMethod ) {
+			case XMLArchive::ZIP:
+				filter->push(boost::iostreams::zlib_decompressor());
+				break;
+			case XMLArchive::GZIP:
+				filter->push(boost::iostreams::gzip_decompressor());
+				break;
+			default:
+				break;
+		}
+
+		filter->push(*_buf);
+		_filter = filter;
+		input = _filter;
+	}
+
+	xmlTextReaderPtr reader = xmlReaderForIO(streamBufReadCallback,
+	                                         streamBufCloseCallback,
+	                                         input, NULL, NULL, 0);
+	if ( reader == NULL ) {
+		close();
+		return false;
+	}
+
+	_reader = reader;
+
+	// Move to the root element
+	int res;
+	while ( (res = xmlTextReaderRead(reader)) == 1 ) {
+		if ( xmlTextReaderNodeType(reader) == XML_READER_TYPE_ELEMENT )
+			break;
+	}
+
+	if ( res != 1 ) {
+		close();
+		return false;
+	}
+
+	if ( !xmlStrcmp(xmlTextReaderConstLocalName(reader), (const xmlChar*)_rootTag.c_str()) ) {
+		xmlChar *version = xmlTextReaderGetAttribute(reader, (const xmlChar*)"version");
+		if ( version != NULL ) {
+			char* seperator = strchr((char*)version, '.');
+			if ( seperator != NULL ) {
+				*seperator++ = '\0';
+				_version = Core::Version(atoi((char*)version), atoi((char*)seperator));
+			}
+			else
+				_version = Core::Version(atoi((char*)version),0);
+
+			xmlFree(version);
+		}
+		else
+			_version = Core::Version(0,0);
+
+		_root = xmlCopyNode(xmlTextReaderCurrentNode(reader), 2);
+		_topLevelDepth = 1;
+	}
+	else {
+		// The root element is the top-level object as with XMLArchive
+		_version = Core::Version(0,0);
+		_topLevelDepth = 0;
+		_pending = true;
+	}
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void XMLStreamReader::close() {
+	if ( _reader != NULL ) {
+		xmlFreeTextReader(static_cast<xmlTextReaderPtr>(_reader));
+		_reader = NULL;
+	}
+
+	if ( _root != NULL ) {
+		xmlFreeNode(static_cast<xmlNodePtr>(_root));
+		_root = NULL;
+	}
+
+	if ( _filter != NULL ) {
+		delete _filter;
+		_filter = NULL;
+	}
+
+	if ( _deleteOnClose && _buf )
+		delete _buf;
+
+	_deleteOnClose = false;
+	_buf = NULL;
+
+	_version = Core::Version(0,0);
+	_topLevelDepth = 1;
+	_topLevelTag.clear();
+	_topLevel = NULL;
+	_childClasses.clear();
+	_pending = false;
+	_skip = false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void XMLStreamReader::setRootName(const std::string &name) {
+	_rootTag = name;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void XMLStreamReader::setCompression(bool enable) {
+	_compression = enable;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void XMLStreamReader::setCompressionMethod(XMLArchive::CompressionMethod method) {
+	_compressionMethod = method;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Core::Version XMLStreamReader::version() const {
+	return _version;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::PublicObjectPtr XMLStreamReader::read() {
+	DataModel::PublicObjectPtr top;
+	Token token;
+
+	while ( (token = advance()) != End ) {
+		if ( token == TopLevel ) {
+			// Stop at the next top-level object and handle it with the
+			// next call
+			if ( top ) {
+				_pending = true;
+				break;
+			}
+
+			top = _topLevel = readTopLevel();
+			if ( !top ) _skip = true;
+			continue;
+		}
+
+		if ( !_topLevel ) continue;
+
+		DataModel::ObjectPtr child = readChild();
+		if ( !child ) continue;
+
+		top = _topLevel;
+		child->attachTo(top.get());
+	}
+
+	return top;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::ObjectPtr XMLStreamReader::next() {
+	Token token;
+
+	while ( (token = advance()) != End ) {
+		if ( token == TopLevel ) {
+			_topLevel = readTopLevel();
+			if ( !_topLevel ) _skip = true;
+			continue;
+		}
+
+		if ( !_topLevel ) continue;
+
+		DataModel::ObjectPtr child = readChild();
+		if ( child ) return child;
+	}
+
+	return NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::PublicObject *XMLStreamReader::topLevelObject() const {
+	return _topLevel.get();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+XMLStreamReader::Token XMLStreamReader::advance() {
+	xmlTextReaderPtr reader = static_cast<xmlTextReaderPtr>(_reader);
+	if ( reader == NULL ) return End;
+
+	while ( true ) {
+		if ( _pending )
+			_pending = false;
+		else {
+			// Skipping a subtree releases its nodes
+			int res = _skip ? xmlTextReaderNext(reader) : xmlTextReaderRead(reader);
+			_skip = false;
+
+			if ( res != 1 ) {
+				if ( res < 0 )
+					SEISCOMP_ERROR("failed to parse XML document");
+				return End;
+			}
+		}
+
+		if ( xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT )
+			continue;
+
+		int depth = xmlTextReaderDepth(reader);
+		if ( depth == _topLevelDepth )
+			return TopLevel;
+
+		// Children are read as a whole
+		_skip = true;
+
+		if ( depth == _topLevelDepth+1 )
+			return Child;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::PublicObjectPtr XMLStreamReader::readTopLevel() {
+	xmlNodePtr node = xmlTextReaderCurrentNode(static_cast<xmlTextReaderPtr>(_reader));
+	if ( node == NULL ) return NULL;
+
+	_topLevelTag = (const char*)node->name;
+
+	DataModel::PublicObjectPtr obj = readSubtree(node, false);
+	if ( !obj )
+		SEISCOMP_WARNING("unknown top-level element '%s' skipped", _topLevelTag.c_str());
+
+	return obj;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::ObjectPtr XMLStreamReader::readChild() {
+	xmlNodePtr node = xmlTextReaderExpand(static_cast<xmlTextReaderPtr>(_reader));
+	if ( node == NULL ) return NULL;
+
+	// The child is read into an empty top-level object which does
+	// not exist anywhere else, so no notifiers must be created for it
+	bool notifierEnabled = DataModel::Notifier::IsEnabled();
+	DataModel::Notifier::Disable();
+
+	DataModel::ObjectPtr child;
+
+	// The class of a child depends on the tag and, if given, the role
+	// attribute. The class is determined by the top-level object for
+	// the first child with a tag and is reused for all following ones.
+	bool cacheable = xmlHasProp(node, (const xmlChar*)"role") == NULL;
+	std::string key;
+	ChildClasses::iterator it = _childClasses.end();
+
+	if ( cacheable ) {
+		key = _topLevelTag + '/' + (const char*)node->name;
+		it = _childClasses.find(key);
+	}
+
+	if ( it != _childClasses.end() ) {
+		Core::BaseObjectPtr obj = Core::ClassFactory::Create(it->second.c_str());
+		child = DataModel::Object::Cast(obj);
+
+		SubtreeArchive ar;
+		if ( child && !ar.read(node, _version, child.get()) )
+			child = NULL;
+	}
+	else {
+		DataModel::PublicObjectPtr parent = readSubtree(node, true);
+		if ( parent ) {
+			ChildCollector collector(parent.get());
+			parent->accept(&collector);
+
+			// Elements which do not describe objects, e.g. unknown ones,
+			// do not create children
+			if ( !collector.children.empty() ) {
+				child = collector.children.front();
+				child->detach();
+			}
+		}
+
+		if ( child && cacheable )
+			_childClasses[key] = child->className();
+	}
+
+	DataModel::Notifier::SetEnabled(notifierEnabled);
+
+	return child;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::PublicObjectPtr XMLStreamReader::readSubtree(void *node, bool child) {
+	xmlDocPtr doc = xmlNewDoc(NULL);
+	xmlNodePtr root = NULL;
+
+	if ( _root != NULL ) {
+		root = xmlDocCopyNode(static_cast<xmlNodePtr>(_root), doc, 2);
+		xmlDocSetRootElement(doc, root);
+	}
+
+	xmlNodePtr top;
+	if ( child ) {
+		// The attributes of the top-level element are left out to not
+		// register a second object with the same publicID
+		top = xmlNewDocNode(doc, NULL, (const xmlChar*)_topLevelTag.c_str(), NULL);
+		xmlAddChild(top, xmlDocCopyNode(static_cast<xmlNodePtr>(node), doc, 1));
+	}
+	else
+		top = xmlDocCopyNode(static_cast<xmlNodePtr>(node), doc, 2);
+
+	if ( root != NULL )
+		xmlAddChild(root, top);
+	else
+		xmlDocSetRootElement(doc, top);
+
+	SubtreeArchive ar;
+	DataModel::PublicObjectPtr obj;
+
+	if ( ar.open(doc, _version, root != NULL) ) {
+		ar >> obj;
+		ar.close();
+	}
+
+	return obj;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+}
+}
@@ -0,0 +1,174 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SCARCHIVE_XMLSTREAMREADER_H__
+#define __SCARCHIVE_XMLSTREAMREADER_H__
+
+
+#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/datamodel/publicobject.h>
+#include <seiscomp3/core.h>
+
+#include <map>
+#include <streambuf>
+#include <string>
+
+
+namespace Seiscomp {
+namespace IO {
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/** \brief A streaming reader for SeisComP XML documents
+ *
+ * XMLArchive parses the whole document into a DOM before the objects are
+ * created which requires several times the size of the document in
+ * memory. This reader parses the document element by element and builds
+ * a DOM only for one child of a top-level object at a time, e.g. for a
+ * Pick or an Event of EventParameters or for a Network of Inventory.
+ * That subtree is then read with XMLArchive and released.
+ *
+ * Properties of top-level objects must be stored as XML attributes which
+ * is the case for all top-level objects of the data model.
+ *
+ * \code
+ * XMLStreamReader reader;
+ * if ( reader.open("events.xml") ) {
+ *     DataModel::ObjectPtr obj;
+ *     while ( (obj = reader.next()) != NULL )
+ *         process(obj.get(), reader.topLevelObject());
+ * }
+ * \endcode
+ */
+class SC_SYSTEM_CORE_API XMLStreamReader {
+	// ----------------------------------------------------------------------
+	//  Xstruction
+	// ----------------------------------------------------------------------
+	public:
+		XMLStreamReader();
+		~XMLStreamReader();
+
+
+	// ----------------------------------------------------------------------
+	//  Public Interface
+	// ----------------------------------------------------------------------
+	public:
+		//! Opens a file for reading. "-" reads from stdin.
+		bool open(const char *filename);
+
+		//! Opens a streambuf for reading
+		bool open(std::streambuf *buf);
+
+		void close();
+
+		//! Sets the root tagname of the document, see XMLArchive
+		void setRootName(const std::string &name);
+
+		//! Enables decompression of the input. Must be called before open.
+		void setCompression(bool enable);
+		void setCompressionMethod(XMLArchive::CompressionMethod method);
+
+		//! Returns the version of the document
+		Core::Version version() const;
+
+		/**
+		 * @brief Reads the next top-level object including all its children.
+		 *
+		 * Children are added to the object as soon as they have been
+		 * parsed, so the memory used is bounded by the size of the
+		 * resulting objects and not by the size of the document. If
+		 * next() has been called before, the remaining children are
+		 * added to the current top-level object which is returned.
+		 * @return The object or NULL if no more objects are available
+		 */
+		DataModel::PublicObjectPtr read();
+
+		/**
+		 * @brief Reads the next child of a top-level object.
+		 *
+		 * The returned object is not attached to its parent which can be
+		 * retrieved with topLevelObject(). At no time a document has to
+		 * be held in memory as a whole.
+		 * @return The object or NULL if no more objects are available
+		 */
+		DataModel::ObjectPtr next();
+
+		//! Returns the top-level object of the last child returned by
+		//! next(). Its children are not attached.
+		DataModel::PublicObject *topLevelObject() const;
+
+
+	// ----------------------------------------------------------------------
+	//  Implementation
+	// ----------------------------------------------------------------------
+	private:
+		// Class names of children per top-level and child tag
+		typedef std::map<std::string, std::string> ChildClasses;
+
+		enum Token {
+			End,
+			TopLevel,
+			Child
+		};
+
+		bool open();
+
+		//! Moves to the next element of the top or the child level
+		Token advance();
+
+		//! Reads the current element of the top level without children
+		DataModel::PublicObjectPtr readTopLevel();
+
+		//! Reads the current element of the child level
+		DataModel::ObjectPtr readChild();
+
+		//! Creates a document from the root, the top-level element and
+		//! the given child element and reads its top-level object. If
+		//! child is false, node is the top-level element itself.
+		DataModel::PublicObjectPtr readSubtree(void *node, bool child);
+
+
+	private:
+		// xmlTextReaderPtr
+		void                          *_reader;
+		// Copy of the root element without children
+		void                          *_root;
+
+		std::streambuf                *_buf;
+		std::streambuf                *_filter;
+		bool                           _deleteOnClose;
+
+		std::string                    _rootTag;
+		bool                           _compression;
+		XMLArchive::CompressionMethod  _compressionMethod;
+		Core::Version                  _version;
+
+		// Depth of the top-level elements
+		int                            _topLevelDepth;
+		std::string                    _topLevelTag;
+		DataModel::PublicObjectPtr     _topLevel;
+		ChildClasses                   _childClasses;
+		// Whether the reader is positioned on an element which has not
+		// yet been handled
+		bool                           _pending;
+		// Whether the subtree of the current element has to be skipped
+		bool                           _skip;
+};
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+}
+}
+
+
+#endif
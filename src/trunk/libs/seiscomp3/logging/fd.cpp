@@ -50,6 +50,8 @@ FdOutput::FdOutput(int fdOut) : _fdOut(fdOut)
 
 
 FdOutput::~FdOutput() {
+	clear();
+	setAsyncEnabled(false);
 }
 
 
@@ -33,6 +33,8 @@ FileOutput::FileOutput(const char* filename)
 }
 
 FileOutput::~FileOutput() {
+	clear();
+	setAsyncEnabled(false);
 	_stream.close();
 }
 
@@ -75,7 +77,15 @@ void FileOutput::log(const char* channelName,
 	_stream << "] ";
 	if ( unlikely(_logContext) )
 		_stream << "(" << fileName() << ':' << lineNum() << ") ";
-	_stream << msg << std::endl;
+	// The background thread flushes the stream after each batch
+	if ( isAsyncActive() )
+		_stream << msg << '\n';
+	else
+		_stream << msg << std::endl;
+}
+
+void FileOutput::flush() {
+	_stream.flush();
 }
 
 
@@ -38,6 +38,8 @@ class SC_SYSTEM_CORE_API FileOutput : public Output {
 		         const char* msg,
 		         time_t time);
 
+		void flush();
+
 	protected:
 		std::string _filename;
 		mutable std::ofstream _stream;
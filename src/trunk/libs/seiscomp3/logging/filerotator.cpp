@@ -43,6 +43,12 @@ FileRotatorOutput::FileRotatorOutput(const char* filename, int timeSpan, int his
 , _lastInterval(-1) {
 }
 
+FileRotatorOutput::~FileRotatorOutput() {
+	// Write pending messages while rotation is still available
+	clear();
+	setAsyncEnabled(false);
+}
+
 bool FileRotatorOutput::open(const char* filename) {
 	if ( !FileOutput::open(filename) ) return false;
 
@@ -33,6 +33,7 @@ class SC_SYSTEM_CORE_API FileRotatorOutput : public FileOutput {
 		 */
 		FileRotatorOutput(const char* filename, int timeSpan = 60*60*24,
 		                  int historySize = 7, int maxFileSize = 100*1024*1024);
+		~FileRotatorOutput();
 
 		bool open(const char* filename);
 
@@ -15,12 +15,330 @@
 #include <seiscomp3/logging/output.h>
 #include <seiscomp3/logging/channel.h>
 
+#include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include <map>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
 
 namespace Seiscomp {
 namespace Logging {
 
 
-Output::Output() : _logComponent(true), _logContext(false), _useUTC(false) {
+namespace {
+
+
+// Interval in milliseconds in which buffered messages are written if the
+// buffers do not fill up
+const int FlushInterval = 100;
+
+
+// Most messages fit into the inline buffer of an entry. Longer messages
+// are copied to the heap and released by the background thread.
+struct Entry {
+	PublishLoc  *publisher;
+	LogLevel     level;
+	time_t       time;
+	char        *longMsg;
+	char         msg[224];
+
+	const char *text() const { return longMsg != NULL ? longMsg : msg; }
+};
+
+
+// Releases entries without logging them
+struct Discard {
+	void operator()(const Entry &entry) const {
+		delete [] entry.longMsg;
+	}
+};
+
+typedef boost::lockfree::spsc_queue<Entry> Buffer;
+typedef boost::shared_ptr<Buffer> BufferPtr;
+
+// The buffers of a thread per output. Outputs are identified by a serial
+// number rather than by their address which might be reused.
+typedef std::map<unsigned int, BufferPtr> LocalBuffers;
+
+boost::thread_specific_ptr<LocalBuffers> localBuffers;
+boost::atomic<unsigned int> asyncSerial(0);
+
+// Incremented in the child process after fork(). The background thread
+// of an output only exists in the process which created it.
+volatile unsigned int forkGeneration = 0;
+
+#ifndef WIN32
+void forked() {
+	++forkGeneration;
+}
+
+boost::once_flag forkHandlerFlag = BOOST_ONCE_INIT;
+
+void registerForkHandler() {
+	pthread_atfork(NULL, NULL, forked);
+}
+#endif
+
+
+// Location of the message which reports dropped messages
+bool dropLocEnabled = true;
+PublishLoc dropLoc = { &dropLocEnabled, NULL, NULL, NULL, "log", __FILE__,
+                       "Output::Async::run", __LINE__, NULL };
+
+
+}
+
+
+struct Output::Async {
+	//! Passes buffered messages to the output
+	struct Writer {
+		Writer(Output *output) : output(output) {}
+		void operator()(const Entry &entry) const {
+			output->_publisher = entry.publisher;
+			output->log(entry.publisher->channel->name().c_str(),
+			            entry.level, entry.text(), entry.time);
+			delete [] entry.longMsg;
+		}
+		Output *output;
+	};
+
+	Async(Output *output, size_t bufferSize);
+	~Async();
+
+	//! Whether the background thread runs in this process
+	bool isActive() const { return generation == forkGeneration; }
+
+	//! Stops the background thread. If write is false pending messages
+	//! are discarded.
+	void stop(bool write);
+
+	//! Returns the buffer of the calling thread
+	Buffer *buffer();
+
+	void push(PublishLoc *publisher, LogLevel level, time_t time, const char *msg);
+	void run();
+
+	Output                    *output;
+	unsigned int               serial;
+	unsigned int               generation;
+	size_t                     bufferSize;
+
+	boost::mutex               mutex;
+	boost::condition_variable  wakeup;
+	std::vector<BufferPtr>     buffers;
+	bool                       running;
+	bool                       discard;
+	boost::thread             *thread;
+
+	boost::atomic<size_t>      dropped;
+	size_t                     reported;
+};
+
+
+Output::Async::Async(Output *output, size_t bufferSize)
+: output(output), serial(++asyncSerial), bufferSize(bufferSize)
+, running(true), discard(false), dropped(0), reported(0) {
+#ifndef WIN32
+	boost::call_once(forkHandlerFlag, registerForkHandler);
+#endif
+	generation = forkGeneration;
+	thread = new boost::thread(boost::bind(&Async::run, this));
+}
+
+
+Output::Async::~Async() {
+	stop(true);
+}
+
+
+void Output::Async::stop(bool write) {
+	if ( thread == NULL ) return;
+
+	// The thread handle of a parent process is meaningless after fork()
+	// and the state of the mutex is unknown. The thread is left alone and
+	// the buffered messages are lost.
+	if ( !isActive() ) {
+		thread = NULL;
+		return;
+	}
+
+	{
+		boost::mutex::scoped_lock l(mutex);
+		running = false;
+		discard = !write;
+	}
+
+	wakeup.notify_one();
+	thread->join();
+	delete thread;
+	thread = NULL;
+}
+
+
+Buffer *Output::Async::buffer() {
+	LocalBuffers *local = localBuffers.get();
+	if ( local != NULL ) {
+		LocalBuffers::iterator it = local->find(serial);
+		if ( it != local->end() ) return it->second.get();
+	}
+	else {
+		local = new LocalBuffers;
+		localBuffers.reset(local);
+	}
+
+	// Release the buffers of outputs which do not exist anymore
+	for ( LocalBuffers::iterator it = local->begin(); it != local->end(); ) {
+		if ( it->second.unique() )
+			local->erase(it++);
+		else
+			++it;
+	}
+
+	boost::mutex::scoped_lock l(mutex);
+
+	// Reuse the buffer of a thread which has finished
+	BufferPtr buf;
+	for ( size_t i = 0; i < buffers.size(); ++i ) {
+		if ( buffers[i].unique() ) {
+			buf = buffers[i];
+			break;
+		}
+	}
+
+	if ( !buf ) {
+		buf = BufferPtr(new Buffer(bufferSize));
+		buffers.push_back(buf);
+	}
+
+	(*local)[serial] = buf;
+	return buf.get();
+}
+
+
+void Output::Async::push(PublishLoc *publisher, LogLevel level,
+                         time_t time, const char *msg) {
+	Buffer *buf = buffer();
+
+	Entry entry;
+	entry.publisher = publisher;
+	entry.level = level;
+	entry.time = time;
+
+	size_t len = strlen(msg);
+	if ( len < sizeof(entry.msg) ) {
+		entry.longMsg = NULL;
+		memcpy(entry.msg, msg, len+1);
+	}
+	else {
+		entry.longMsg = new char[len+1];
+		memcpy(entry.longMsg, msg, len+1);
+	}
+
+	if ( !buf->push(entry) ) {
+		delete [] entry.longMsg;
+		++dropped;
+		return;
+	}
+
+	// Do not wait for the next interval if the buffer is filling up
+	if ( buf->write_available() < bufferSize / 2 )
+		wakeup.notify_one();
+}
+
+
+void Output::Async::run() {
+	Writer writer(output);
+	std::vector<BufferPtr> pending;
+
+	while ( true ) {
+		bool stop;
+
+		{
+			boost::mutex::scoped_lock l(mutex);
+			stop = !running;
+			pending = buffers;
+		}
+
+		if ( stop && discard ) {
+			for ( size_t i = 0; i < pending.size(); ++i )
+				pending[i]->consume_all(Discard());
+			break;
+		}
+
+		size_t count = 0;
+		for ( size_t i = 0; i < pending.size(); ++i )
+			count += pending[i]->consume_all(writer);
+
+		pending.clear();
+
+		size_t numberOfDropped = dropped;
+		if ( numberOfDropped != reported ) {
+			char msg[64];
+			snprintf(msg, sizeof(msg), "%lu log messages dropped",
+			         (unsigned long)(numberOfDropped - reported));
+			output->_publisher = &dropLoc;
+			output->log("warning", LL_WARNING, msg, ::time(NULL));
+			reported = numberOfDropped;
+			++count;
+		}
+
+		if ( count > 0 )
+			output->flush();
+
+		// All messages logged before the output was stopped are written
+		if ( stop ) break;
+
+		if ( count == 0 ) {
+			boost::mutex::scoped_lock l(mutex);
+			if ( running )
+				wakeup.timed_wait(l, boost::posix_time::milliseconds(FlushInterval));
+		}
+	}
+}
+
+
+Output::Output()
+: _logComponent(true), _logContext(false), _useUTC(false), _async(NULL) {
+}
+
+
+Output::~Output() {
+	if ( _async != NULL ) {
+		// log() of the derived class is not available anymore
+		_async->stop(false);
+		delete _async;
+		_async = NULL;
+	}
+}
+
+
+void Output::setAsyncEnabled(bool e, size_t bufferSize) {
+	if ( _async != NULL ) {
+		delete _async;
+		_async = NULL;
+	}
+
+	if ( e )
+		_async = new Async(this, bufferSize);
+}
+
+
+bool Output::isAsyncActive() const {
+	return _async != NULL && _async->isActive();
+}
+
+
+size_t Output::droppedMessages() const {
+	return _async != NULL ? (size_t)_async->dropped : 0;
 }
 
 
@@ -47,6 +365,13 @@ bool Output::unsubscribe(Channel* ch) {
 void Output::publish(const Data &data) {
 	LogLevel level = data.publisher->channel->logLevel();
 
+	// A process forked after asynchronous logging has been enabled logs
+	// synchronously as the background thread is not running anymore
+	if ( _async != NULL && _async->isActive() ) {
+		_async->push(data.publisher, level, data.time, data.msg);
+		return;
+	}
+
 	_publisher = data.publisher;
 	log(_publisher->channel->name().c_str(),
 	    level,
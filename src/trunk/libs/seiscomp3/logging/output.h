@@ -32,13 +32,29 @@ namespace Logging {
  * MyOutput log;
  * log.subscribe(GetAll());
  * \endcode
+ *
+ * If asynchronous logging is enabled log(...) is not called by the thread
+ * that logs a message. Each thread writes its messages into a lock-free
+ * buffer of its own which is emptied by a background thread. That thread
+ * calls log(...) for all buffered messages and flush() afterwards. If a
+ * buffer is full the message is dropped and the number of dropped
+ * messages is logged later. Messages of different threads are not
+ * guaranteed to be logged in order. The destructor stops the background
+ * thread and discards messages which have not been logged yet. To write
+ * them derived classes call setAsyncEnabled(false) in their destructor
+ * after unsubscribing from all channels, e.g. with clear().
+ *
+ * The background thread does not exist in a process created with fork()
+ * after asynchronous logging has been enabled. Such a process logs
+ * synchronously. Daemons should enable asynchronous logging after they
+ * have forked.
  */
 class SC_SYSTEM_CORE_API Output : public Node {
 	protected:
 		Output();
 
 	public:
-		virtual ~Output() {}
+		virtual ~Output();
 
 	public:
 		/** Subscribe to a particular channel */
@@ -48,6 +64,19 @@ class SC_SYSTEM_CORE_API Output : public Node {
 		void logContext(bool e) { _logContext = e; }
 		void setUTCEnabled(bool e) { _useUTC = e; }
 
+		/**
+		 * Enables or disables asynchronous logging. This must not be called
+		 * while other threads log to the output. Disabling waits until
+		 * all buffered messages have been logged.
+		 * @param e Whether asynchronous logging is enabled
+		 * @param bufferSize The number of messages buffered per thread
+		 */
+		void setAsyncEnabled(bool e, size_t bufferSize = 1024);
+		bool isAsyncEnabled() const { return _async != NULL; }
+
+		/** Returns the number of messages dropped in asynchronous mode */
+		size_t droppedMessages() const;
+
 	protected:
 		/** Callback method for receiving log messages */
 		virtual void log(const char* channelName,
@@ -55,6 +84,15 @@ class SC_SYSTEM_CORE_API Output : public Node {
 		                 const char* msg,
 		                 time_t time) = 0;
 
+		/** Called in asynchronous mode after a batch of messages has
+		    been passed to log(...) */
+		virtual void flush() {}
+
+		/** Returns whether log(...) is called by the background thread.
+		    This is false in a process created with fork() although
+		    asynchronous logging is enabled. */
+		bool isAsyncActive() const;
+
 		/** The following methods calls are only valid inside the
 		    log(...) method */
 
@@ -70,6 +108,9 @@ class SC_SYSTEM_CORE_API Output : public Node {
 	private:
 		void publish(const Data &data);
 
+		struct Async;
+		friend struct Async;
+
 	protected:
 		bool _logComponent;
 		bool _logContext;
@@ -77,6 +118,7 @@ class SC_SYSTEM_CORE_API Output : public Node {
 
 	private:
 		PublishLoc* _publisher;
+		Async*      _async;
 };
 
 }
@@ -41,6 +41,8 @@ SyslogOutput::SyslogOutput(const char* ident, const char *facility)
 }
 
 SyslogOutput::~SyslogOutput() {
+	clear();
+	setAsyncEnabled(false);
 	SyslogOutput::close();
 }
 
@@ -12,6 +12,7 @@
 
 
 #include<seiscomp3/math/filter/stalta.h>
+#include <math.h>
 
 namespace Seiscomp {
 namespace Math {
@@ -30,6 +31,20 @@ T _average_sq(int n, T *f)
 	return avg/n;
 }
 
+
+// The recursive update shared by STALTA and STALTA2. The state is passed
+// by reference to keep it in registers while looping over the data which
+// could alias the members otherwise. The input value should be taken with
+// fabs rather than FABS which compiles to an unpredictable branch.
+inline double _update(double &sta, double &lta, double value,
+                      double insta, double inlta, double bleed = 1.) {
+	double q = (sta - lta)*inlta;
+	lta += q*bleed;
+	sta += (value - sta)*insta;
+	return sta/lta;
+}
+
+
 }
 
 template<typename TYPE>
@@ -103,35 +118,45 @@ void
 STALTA<TYPE>::apply(int ndata, TYPE *data)
 {
 	double inlta = 1./_numLTA, insta = 1./_numSTA;
+	double sta = _sta, lta = _lta;
+	int i = 0;
 
 	if (_saveIntermediate) {
 		_staVector.resize(ndata);
 		_ltaVector.resize(ndata);
 	}
 
-	for (int i=0; i<ndata; ++i, ++data) {	
-		if (_sampleCount < _initLength) {
-			// immediately after initialization
-			_lta = (_sampleCount*_lta+FABS(*data))/(_sampleCount+1);
-			_sta = _lta;
-			*data = 1.;
-			_sampleCount++;
-		}
-		else {
-			// normal behaviour
-			double q = (_sta - _lta)*inlta;
-			_lta += q;
-			_sta += (FABS(*data) - _sta)*insta;
-			*data = (TYPE)(_sta/_lta);
-		}
+	// immediately after initialization
+	for ( ; i<ndata && _sampleCount < _initLength; ++i) {
+		lta = (_sampleCount*lta+FABS(data[i]))/(_sampleCount+1);
+		sta = lta;
+		data[i] = 1.;
+		_sampleCount++;
 
 		if (_saveIntermediate) {
-			_staVector[i] = (TYPE)_sta;
-			_ltaVector[i] = (TYPE)_lta;
+			_staVector[i] = (TYPE)sta;
+			_ltaVector[i] = (TYPE)lta;
+		}
+	}
+
+	// normal behaviour, the loops are kept free of any branches
+	if (_saveIntermediate) {
+		for ( ; i<ndata; ++i) {
+			data[i] = (TYPE)_update(sta, lta, fabs(data[i]), insta, inlta);
+			_staVector[i] = (TYPE)sta;
+			_ltaVector[i] = (TYPE)lta;
 		}
 	}
+	else {
+		for ( ; i<ndata; ++i)
+			data[i] = (TYPE)_update(sta, lta, fabs(data[i]), insta, inlta);
+	}
+
+	_sta = sta;
+	_lta = lta;
 }
 
+
 template <typename TYPE>
 InPlaceFilter<TYPE>* STALTA<TYPE>::clone() const {
 	return new STALTA<TYPE>(_lenSTA, _lenLTA, _fsamp);
@@ -209,36 +234,43 @@ void
 STALTA2<TYPE>::apply(int ndata, TYPE *data)
 {
 	double inlta = 1./_numLTA, insta = 1./_numSTA;
+	double sta = _sta, lta = _lta, bleed = _bleed;
+	int i = 0;
 
 	if (_saveIntermediate) {
 		_staVector.resize(ndata);
 		_ltaVector.resize(ndata);
 	}
 
-	for (int i=0; i<ndata; ++i, ++data) {
-		if (_sampleCount < _initLength) {
-			// immediately after initialization
-			_lta = (_sampleCount*_lta+FABS(*data))/(_sampleCount+1);
-			_sta = _lta;
-			*data = 1.;
-			_sampleCount++;
-		}
-		else {
-			// normal behaviour
-			double q = (_sta - _lta)*inlta;
-			_lta += q*_bleed;
-			_sta += (FABS(*data) - _sta)*insta;
-			*data = (TYPE)(_sta/_lta);
-
-			if ( (_bleed > 0.) && (*data > _eventOn) ) _bleed = 0.;
-			else if ( (_bleed < 1.) && (*data < _eventOff) ) _bleed = 1.;
+	// immediately after initialization
+	for ( ; i<ndata && _sampleCount < _initLength; ++i) {
+		lta = (_sampleCount*lta+FABS(data[i]))/(_sampleCount+1);
+		sta = lta;
+		data[i] = 1.;
+		_sampleCount++;
+
+		if (_saveIntermediate) {
+			_staVector[i] = (TYPE)sta;
+			_ltaVector[i] = (TYPE)lta;
 		}
+	}
+
+	// normal behaviour
+	for ( ; i<ndata; ++i) {
+		TYPE ratio = (TYPE)_update(sta, lta, fabs(data[i]), insta, inlta, bleed);
+		data[i] = ratio;
+		if ( (bleed > 0.) && (ratio > _eventOn) ) bleed = 0.;
+		else if ( (bleed < 1.) && (ratio < _eventOff) ) bleed = 1.;
 
 		if (_saveIntermediate) {
-			_staVector[i] = (TYPE)_sta;
-			_ltaVector[i] = (TYPE)_lta;
+			_staVector[i] = (TYPE)sta;
+			_ltaVector[i] = (TYPE)lta;
 		}
 	}
+
+	_sta = sta;
+	_lta = lta;
+	_bleed = bleed;
 }
 
 
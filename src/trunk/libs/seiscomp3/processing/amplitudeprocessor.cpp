@@ -16,6 +16,8 @@
 
 #include <seiscomp3/datamodel/pick.h>
 #include <seiscomp3/processing/amplitudeprocessor.h>
+#include <seiscomp3/processing/preprocessingcache.h>
+#include <seiscomp3/core/strings.h>
 #include <seiscomp3/math/mean.h>
 #include <seiscomp3/math/filter/iirdifferentiate.h>
 #include <seiscomp3/logging/log.h>
@@ -614,6 +616,11 @@ void AmplitudeProcessor::prepareData(DoubleArray &data) {
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool AmplitudeProcessor::deconvolveData(Response *resp, DoubleArray &data,
                                         int numberOfIntegrations) {
+	PreprocessingCache::Key key(resp, deconvolutionStage(numberOfIntegrations),
+	                            _stream.fsamp, data);
+	if ( PreprocessingCache::get(key, data) )
+		return true;
+
 	// Remove linear trend
 	double m,n;
 	Math::Statistics::computeLinearTrend(data.size(), data.typedData(), m, n);
@@ -634,6 +641,8 @@ bool AmplitudeProcessor::deconvolveData(Response *resp, DoubleArray &data,
 		++numberOfIntegrations;
 	}
 
+	PreprocessingCache::put(key, data);
+
 	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -641,6 +650,17 @@ bool AmplitudeProcessor::deconvolveData(Response *resp, DoubleArray &data,
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+std::string AmplitudeProcessor::deconvolutionStage(int numberOfIntegrations) const {
+	return Core::stringify("deconvolution(%d,%.17g,%.17g,%.17g)",
+	                       numberOfIntegrations, _config.respTaper,
+	                       _config.respMinFreq, _config.respMaxFreq);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool AmplitudeProcessor::computeNoise(const DoubleArray &data, int i1, int i2, double *offset, double *amplitude) {
 	// compute offset and rms within the time window
@@ -316,6 +316,12 @@ class SC_SYSTEM_CLIENT_API AmplitudeProcessor : public TimeWindowProcessor {
 		virtual bool deconvolveData(Response *resp, DoubleArray &data,
 		                            int numberOfIntegrations);
 
+		//! Returns a description of the response deconvolution with the
+		//! configured taper and frequency limits. It is used together
+		//! with a description of further simulation stages to share the
+		//! deconvolved data via the PreprocessingCache.
+		std::string deconvolutionStage(int numberOfIntegrations) const;
+
 		//! -----------------------------------------------------------------------
 		//! Computes the amplitude of data in the range[i1, i2].
 		//! -----------------------------------------------------------------------
@@ -16,6 +16,8 @@
 
 #include <seiscomp3/logging/log.h>
 #include <seiscomp3/processing/amplitudes/ML.h>
+#include <seiscomp3/processing/preprocessingcache.h>
+#include <seiscomp3/core/strings.h>
 #include <seiscomp3/math/mean.h>
 #include <seiscomp3/math/filter/seismometers.h>
 #include <seiscomp3/math/restitution/fft.h>
@@ -232,6 +234,16 @@ bool AbstractAmplitudeProcessor_ML::deconvolveData(Response *resp,
 	if ( numberOfIntegrations < -1 )
 		return false;
 
+	PreprocessingCache::Key key(resp,
+		Core::stringify("WoodAnderson(%.17g,%.17g,%.17g)/",
+		                _config.woodAndersonResponse.gain,
+		                _config.woodAndersonResponse.T0,
+		                _config.woodAndersonResponse.h) +
+		deconvolutionStage(numberOfIntegrations),
+		_stream.fsamp, data);
+	if ( PreprocessingCache::get(key, data) )
+		return true;
+
 	Math::Restitution::FFT::TransferFunctionPtr tf =
 		resp->getTransferFunction(numberOfIntegrations < 0 ? 0 : numberOfIntegrations);
 
@@ -249,10 +261,14 @@ bool AbstractAmplitudeProcessor_ML::deconvolveData(Response *resp,
 	Math::Statistics::computeLinearTrend(data.size(), data.typedData(), m, n);
 	Math::Statistics::detrend(data.size(), data.typedData(), m, n);
 
-	return Math::Restitution::transformFFT(data.size(), data.typedData(),
-	                                       _stream.fsamp, cascade.get(),
-	                                       _config.respTaper, _config.respMinFreq,
-	                                       _config.respMaxFreq);
+	if ( !Math::Restitution::transformFFT(data.size(), data.typedData(),
+	                                      _stream.fsamp, cascade.get(),
+	                                      _config.respTaper, _config.respMinFreq,
+	                                      _config.respMaxFreq) )
+		return false;
+
+	PreprocessingCache::put(key, data);
+	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -15,6 +15,7 @@
 #define SEISCOMP_COMPONENT AmplitudeMjma
 
 #include <seiscomp3/processing/amplitudes/Mjma.h>
+#include <seiscomp3/processing/preprocessingcache.h>
 #include <seiscomp3/math/mean.h>
 #include <seiscomp3/math/filter/seismometers.h>
 #include <seiscomp3/math/restitution/fft.h>
@@ -84,6 +85,12 @@ bool AmplitudeProcessor_Mjma::deconvolveData(Response *resp,
 	if ( numberOfIntegrations < -1 )
 		return false;
 
+	PreprocessingCache::Key key(resp,
+		"Seismometer5sec/" + deconvolutionStage(numberOfIntegrations),
+		_stream.fsamp, data);
+	if ( PreprocessingCache::get(key, data) )
+		return true;
+
 	Math::Restitution::FFT::TransferFunctionPtr tf =
 		resp->getTransferFunction(numberOfIntegrations < 0 ? 0 : numberOfIntegrations);
 
@@ -101,9 +108,13 @@ bool AmplitudeProcessor_Mjma::deconvolveData(Response *resp,
 	Math::Statistics::computeLinearTrend(data.size(), data.typedData(), m, n);
 	Math::Statistics::detrend(data.size(), data.typedData(), m, n);
 
-	return Math::Restitution::transformFFT(data.size(), data.typedData(),
-	                                         _stream.fsamp, cascade.get(),
-	                                         _config.respTaper, _config.respMinFreq, _config.respMaxFreq);
+	if ( !Math::Restitution::transformFFT(data.size(), data.typedData(),
+	                                      _stream.fsamp, cascade.get(),
+	                                      _config.respTaper, _config.respMinFreq, _config.respMaxFreq) )
+		return false;
+
+	PreprocessingCache::put(key, data);
+	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
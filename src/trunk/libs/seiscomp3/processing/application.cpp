@@ -15,17 +15,176 @@
 
 #include <seiscomp3/processing/application.h>
 #include <seiscomp3/datamodel/configstation.h>
+#include <seiscomp3/client/queue.ipp>
 #include <seiscomp3/logging/log.h>
 
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <climits>
+
 
 namespace Seiscomp {
 
 namespace Processing {
 
 
+namespace {
+
+// Wakes up the main thread to dispatch the notifications posted by the
+// workers. Custom types of the applications are small negative numbers.
+const int DispatchNotifications = INT_MIN;
+
+}
+
+
+// The processors of a set of stations and the thread feeding them. All
+// members except the queue are protected by the mutex.
+struct Application::Worker {
+	Worker() : queue(1024), thread(NULL), log(NULL),
+	           registrationBlocked(false), records(0), busy(0) {}
+
+	boost::recursive_mutex         mutex;
+	Client::ThreadedQueue<Record*> queue;
+	boost::thread                 *thread;
+	boost::thread::id              threadID;
+	ObjectLog                     *log;
+
+	ProcessorMap                   processors;
+	StationProcessors              stationProcessors;
+	WaveformProcessorQueue         waveformProcessorQueue;
+	WaveformProcessorRemovalQueue  waveformProcessorRemovalQueue;
+	TimeWindowProcessorQueue       timeWindowProcessorQueue;
+	bool                           registrationBlocked;
+
+	// Statistics of the current monitor period
+	size_t                         records;
+	double                         busy;
+	Core::Time                     lastEndTime;
+};
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Application::Application(int argc, char **argv)
 : Client::StreamApplication(argc, argv), _waveformBuffer(30.*60.) {
-	_registrationBlocked = false;
+	_workers.push_back(new Worker);
+	_workersStarted = false;
+	_pendingRecords = 0;
+	_notificationsPosted = false;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Application::~Application() {
+	stopWorkers();
+
+	for ( size_t i = 0; i < _workers.size(); ++i )
+		delete _workers[i];
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::setProcessingThreads(int count) {
+	if ( count < 1 ) count = 1;
+	if ( count == (int)_workers.size() ) return;
+
+	// Processors must not have been registered yet
+	stopWorkers();
+
+	for ( size_t i = 0; i < _workers.size(); ++i )
+		delete _workers[i];
+	_workers.clear();
+
+	for ( int i = 0; i < count; ++i ) {
+		_workers.push_back(new Worker);
+		if ( count > 1 ) {
+			std::stringstream ss;
+			ss << "worker-" << i;
+			_workers.back()->log = addInputObjectLog(ss.str());
+		}
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+int Application::processingThreads() const {
+	return (int)_workers.size();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+boost::recursive_mutex &Application::callbackMutex() {
+	return _callbackMutex;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::postNotification(int type, Core::BaseObject *obj) {
+	Core::BaseObjectPtr tmp(obj);
+
+	if ( currentWorker() == NULL ) {
+		dispatchNotification(type, obj);
+		return;
+	}
+
+	boost::mutex::scoped_lock lock(_notificationMutex);
+	_pendingNotifications.push_back(PendingNotification(type, tmp));
+
+	// The worker must not block on a full queue because it holds locks
+	// the main thread may wait for. If the wake up cannot be queued the
+	// notifications are dispatched in idle() after the next event.
+	if ( !_notificationsPosted )
+		_notificationsPosted = _queue.tryPush(Client::Notification(DispatchNotifications));
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::dispatchPendingNotifications() {
+	PendingNotifications pending;
+
+	{
+		boost::mutex::scoped_lock lock(_notificationMutex);
+		if ( _pendingNotifications.empty() ) return;
+		pending.swap(_pendingNotifications);
+		_notificationsPosted = false;
+	}
+
+	for ( PendingNotifications::iterator it = pending.begin();
+	      it != pending.end(); ++it )
+		dispatchNotification(it->first, it->second.get());
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Application::dispatchNotification(int type, Core::BaseObject *obj) {
+	if ( type != DispatchNotifications )
+		return Client::StreamApplication::dispatchNotification(type, obj);
+
+	dispatchPendingNotifications();
+	return true;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -33,7 +192,44 @@ Application::Application(int argc, char **argv)
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-Application::~Application() {}
+void Application::idle() {
+	Client::StreamApplication::idle();
+	dispatchPendingNotifications();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Application::Worker *Application::worker(const std::string &stationID) const {
+	if ( _workers.size() == 1 ) return _workers[0];
+
+	// FNV-1a, std::hash is not available with C++98
+	unsigned int hash = 2166136261U;
+	for ( size_t i = 0; i < stationID.size(); ++i ) {
+		hash ^= (unsigned char)stationID[i];
+		hash *= 16777619U;
+	}
+
+	return _workers[hash % _workers.size()];
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Application::Worker *Application::currentWorker() const {
+	if ( !_workersStarted ) return NULL;
+
+	boost::thread::id id = boost::this_thread::get_id();
+	for ( size_t i = 0; i < _workers.size(); ++i )
+		if ( _workers[i]->thread && _workers[i]->threadID == id )
+			return _workers[i];
+
+	return NULL;
+}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
 
@@ -63,15 +259,18 @@ void Application::addProcessor(const std::string& networkCode,
                                const std::string& locationCode,
                                const std::string& channelCode,
                                WaveformProcessor *wp) {
-	if ( _registrationBlocked ) {
-		_waveformProcessorQueue.push_back(
+	Worker *w = worker(networkCode + "." + stationCode);
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+	if ( w->registrationBlocked ) {
+		w->waveformProcessorQueue.push_back(
 			WaveformProcessorItem(WID(networkCode, stationCode,
 			                          locationCode, channelCode, ""), wp))
 		;
 		return;
 	}
 
-	registerProcessor(networkCode, stationCode,
+	registerProcessor(w, networkCode, stationCode,
 	                  locationCode, channelCode, wp);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -99,15 +298,18 @@ void Application::addProcessor(const std::string& networkCode,
                                const std::string& locationCode,
                                const std::string& channelCode,
                                TimeWindowProcessor *twp) {
-	if ( _registrationBlocked ) {
-		_timeWindowProcessorQueue.push_back(
+	Worker *w = worker(networkCode + "." + stationCode);
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+	if ( w->registrationBlocked ) {
+		w->timeWindowProcessorQueue.push_back(
 			TimeWindowProcessorItem(WID(networkCode, stationCode,
 			                            locationCode, channelCode, ""), twp))
 		;
 		return;
 	}
 
-	registerProcessor(networkCode, stationCode,
+	registerProcessor(w, networkCode, stationCode,
 	                  locationCode, channelCode, twp);
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -130,19 +332,20 @@ void Application::addProcessor(const DataModel::WaveformStreamID &wfid,
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void Application::registerProcessor(const std::string& networkCode,
+void Application::registerProcessor(Worker *w,
+                                    const std::string& networkCode,
                                     const std::string& stationCode,
                                     const std::string& locationCode,
                                     const std::string& channelCode,
                                     WaveformProcessor *wp) {
-	_processors.insert(ProcessorMap::value_type(networkCode + "." + stationCode + "." + locationCode + "." + channelCode, wp));
+	w->processors.insert(ProcessorMap::value_type(networkCode + "." + stationCode + "." + locationCode + "." + channelCode, wp));
 
 	// Because we are dealing with a multimap we need to check if the pointer
 	// is already registered for this station. Otherwise the remove method will
 	// keep the additional instance because it stops after the first hit.
 	std::string staID = networkCode + "." + stationCode;
 	std::pair<StationProcessors::iterator, StationProcessors::iterator> itq =
-		_stationProcessors.equal_range(staID);
+		w->stationProcessors.equal_range(staID);
 	bool foundWP = false;
 	for ( StationProcessors::iterator it = itq.first; it != itq.second; ++it ) {
 		if ( it->second == wp ) {
@@ -152,7 +355,7 @@ void Application::registerProcessor(const std::string& networkCode,
 	}
 
 	if ( !foundWP )
-		_stationProcessors.insert(StationProcessors::value_type(staID, wp));
+		w->stationProcessors.insert(StationProcessors::value_type(staID, wp));
 
 	wp->setEnabled(isStationEnabled(networkCode, stationCode));
 
@@ -161,8 +364,8 @@ void Application::registerProcessor(const std::string& networkCode,
 	               locationCode.c_str(), channelCode.c_str(),
                        (long)wp);
 	SEISCOMP_DEBUG("Current processor count: %lu/%lu, object count: %d",
-		      (unsigned long)_processors.size(),
-	              (unsigned long)_stationProcessors.size(),
+		      (unsigned long)w->processors.size(),
+	              (unsigned long)w->stationProcessors.size(),
 		      Core::BaseObject::ObjectCount());
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -171,31 +374,24 @@ void Application::registerProcessor(const std::string& networkCode,
 
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void Application::registerProcessor(const DataModel::WaveformStreamID &wfid,
-			            WaveformProcessor *proc) {
-	registerProcessor(wfid.networkCode(),
-		          wfid.stationCode(),
-		          wfid.locationCode(),
-		          wfid.channelCode(),
-		          proc);
-}
-// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-
-
-
-
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void Application::registerProcessor(const std::string& networkCode,
+void Application::registerProcessor(Worker *w,
+                                    const std::string& networkCode,
                                     const std::string& stationCode,
                                     const std::string& locationCode,
                                     const std::string& channelCode,
                                     TimeWindowProcessor *twp) {
-	registerProcessor(networkCode, stationCode, locationCode, channelCode, (WaveformProcessor*)twp);
+	registerProcessor(w, networkCode, stationCode, locationCode, channelCode, (WaveformProcessor*)twp);
 
 	twp->computeTimeWindow();
 
-	RecordSequence* seq = _waveformBuffer.sequence(
-		StreamBuffer::WaveformID(networkCode, stationCode, locationCode, channelCode));
+	// The sequence itself is only modified by the worker of the station
+	// which is the calling thread
+	RecordSequence* seq;
+	{
+		boost::mutex::scoped_lock lock(_waveformBufferMutex);
+		seq = _waveformBuffer.sequence(
+			StreamBuffer::WaveformID(networkCode, stationCode, locationCode, channelCode));
+	}
 	if ( !seq ) return;
 
 	Core::Time startTime = twp->timeWindow().startTime() - twp->margin();
@@ -233,8 +429,9 @@ void Application::registerProcessor(const std::string& networkCode,
 	}
 
 	if ( twp->isFinished() ) {
+		boost::recursive_mutex::scoped_lock lock(_callbackMutex);
 		processorFinished(twp->lastRecord(), twp);
-		removeProcessor(twp);
+		removeProcessor(w, twp);
 	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -242,29 +439,17 @@ void Application::registerProcessor(const std::string& networkCode,
 
 
 
-// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
-void Application::registerProcessor(const DataModel::WaveformStreamID &wfid,
-                                    TimeWindowProcessor *proc) {
-	registerProcessor(wfid.networkCode(),
-		          wfid.stationCode(),
-		          wfid.locationCode(),
-		          wfid.channelCode(),
-		          proc);
-}
-// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-
-
-
-
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::removeProcessors(const std::string& networkCode,
                                    const std::string& stationCode,
                                    const std::string& locationCode,
                                    const std::string& channelCode) {
+	Worker *w = worker(networkCode + "." + stationCode);
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
 
 	bool checkPendingQueue;
 	std::pair<ProcessorMap::iterator, ProcessorMap::iterator> itq =
-		_processors.equal_range(networkCode + "." +
+		w->processors.equal_range(networkCode + "." +
 		                        stationCode + "." +
 		                        locationCode + "." +
 		                        channelCode);
@@ -273,38 +458,38 @@ void Application::removeProcessors(const std::string& networkCode,
 
 	// Remove stations - processor association
 	for ( ProcessorMap::iterator it = itq.first; it != itq.second; ++it ) {
-		for ( StationProcessors::iterator its = _stationProcessors.begin();
-		      its != _stationProcessors.end(); )
+		for ( StationProcessors::iterator its = w->stationProcessors.begin();
+		      its != w->stationProcessors.end(); )
 		{
 			if ( its->second == it->second ) {
 				SEISCOMP_DEBUG("Removed processor from station %s", its->first.c_str());
-				_stationProcessors.erase(its++);
+				w->stationProcessors.erase(its++);
 				break;
 			}
 		}
 	}
 
-	_processors.erase(itq.first, itq.second);
+	w->processors.erase(itq.first, itq.second);
 
 	if ( !checkPendingQueue ) return;
 
 	// Remove from pending queue (if exists)
-	for ( WaveformProcessorQueue::iterator it = _waveformProcessorQueue.begin();
-	      it != _waveformProcessorQueue.end(); ) {
+	for ( WaveformProcessorQueue::iterator it = w->waveformProcessorQueue.begin();
+	      it != w->waveformProcessorQueue.end(); ) {
 		if ( it->first.networkCode() != networkCode ) { ++it; continue; }
 		if ( it->first.stationCode() != stationCode ) { ++it; continue; }
 		if ( it->first.locationCode() != locationCode ) { ++it; continue; }
 		if ( it->first.channelCode() != channelCode ) { ++it; continue; }
-		it = _waveformProcessorQueue.erase(it);
+		it = w->waveformProcessorQueue.erase(it);
 	}
 
-	for ( TimeWindowProcessorQueue::iterator it = _timeWindowProcessorQueue.begin();
-	      it != _timeWindowProcessorQueue.end(); ) {
+	for ( TimeWindowProcessorQueue::iterator it = w->timeWindowProcessorQueue.begin();
+	      it != w->timeWindowProcessorQueue.end(); ) {
 		if ( it->first.networkCode() != networkCode ) { ++it; continue; }
 		if ( it->first.stationCode() != stationCode ) { ++it; continue; }
 		if ( it->first.locationCode() != locationCode ) { ++it; continue; }
 		if ( it->first.channelCode() != channelCode ) { ++it; continue; }
-		it = _timeWindowProcessorQueue.erase(it);
+		it = w->timeWindowProcessorQueue.erase(it);
 	}
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -326,46 +511,66 @@ void Application::removeProcessors(const DataModel::WaveformStreamID &wfid) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::removeProcessor(Processing::WaveformProcessor *wp) {
-	if ( _registrationBlocked ) {
-		_waveformProcessorRemovalQueue.push_back(wp);
+	// Called from a processing thread the processor can only belong to
+	// the station being processed
+	Worker *current = currentWorker();
+	if ( current ) {
+		removeProcessor(current, wp);
+		return;
+	}
+
+	for ( size_t i = 0; i < _workers.size(); ++i )
+		removeProcessor(_workers[i], wp);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::removeProcessor(Worker *w, Processing::WaveformProcessor *wp) {
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+	if ( w->registrationBlocked ) {
+		w->waveformProcessorRemovalQueue.push_back(wp);
 		return;
 	}
 
-	for ( ProcessorMap::iterator it = _processors.begin();
-	      it != _processors.end(); )
+	for ( ProcessorMap::iterator it = w->processors.begin();
+	      it != w->processors.end(); )
 	{
 		if ( it->second.get() == wp ) {
 			SEISCOMP_DEBUG("Removed processor from stream %s    addr=0x%lx",
 				       it->first.c_str(), (long)wp);
-			_processors.erase(it++);
+			w->processors.erase(it++);
 		}
 		else
 			++it;
 	}
 
-	for ( StationProcessors::iterator it = _stationProcessors.begin();
-	      it != _stationProcessors.end(); ++it )
+	for ( StationProcessors::iterator it = w->stationProcessors.begin();
+	      it != w->stationProcessors.end(); ++it )
 	{
 		if ( it->second.get() == wp ) {
 			SEISCOMP_DEBUG("Removed processor from station %s", it->first.c_str());
-			_stationProcessors.erase(it);
+			w->stationProcessors.erase(it);
 			break;
 		}
 	}
 
 	// Remove from pending queue (if exists)
-	for ( WaveformProcessorQueue::iterator it = _waveformProcessorQueue.begin();
-	      it != _waveformProcessorQueue.end(); ) {
+	for ( WaveformProcessorQueue::iterator it = w->waveformProcessorQueue.begin();
+	      it != w->waveformProcessorQueue.end(); ) {
 		if ( it->second.get() == wp )
-			it = _waveformProcessorQueue.erase(it);
+			it = w->waveformProcessorQueue.erase(it);
 		else
 			++it;
 	}
 
-	for ( TimeWindowProcessorQueue::iterator it = _timeWindowProcessorQueue.begin();
-	      it != _timeWindowProcessorQueue.end(); ) {
+	for ( TimeWindowProcessorQueue::iterator it = w->timeWindowProcessorQueue.begin();
+	      it != w->timeWindowProcessorQueue.end(); ) {
 		if ( it->second.get() == wp )
-			it = _timeWindowProcessorQueue.erase(it);
+			it = w->timeWindowProcessorQueue.erase(it);
 		else
 			++it;
 	}
@@ -377,7 +582,12 @@ void Application::removeProcessor(Processing::WaveformProcessor *wp) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 size_t Application::processorCount() const {
-	return _processors.size();
+	size_t count = 0;
+	for ( size_t i = 0; i < _workers.size(); ++i ) {
+		boost::recursive_mutex::scoped_lock lock(_workers[i]->mutex);
+		count += _workers[i]->processors.size();
+	}
+	return count;
 }
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
@@ -431,26 +641,44 @@ void Application::updateObject(const std::string& parentID, DataModel::Object* o
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::handleRecord(Record *rec) {
-	std::string streamID = rec->streamID();
-	std::list<WaveformProcessor*> trashList;
-
 	RecordPtr tmp(rec);
 
 	if ( rec->data() == NULL ) return;
 
-	if ( !_waveformBuffer.feed(rec) ) return;
+	process(worker(rec->networkCode() + "." + rec->stationCode()), rec);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::process(Worker *w, Record *rec) {
+	std::string streamID = rec->streamID();
+	std::list<WaveformProcessor*> trashList;
+	bool newStream;
+
+	{
+		boost::mutex::scoped_lock lock(_waveformBufferMutex);
+		if ( !_waveformBuffer.feed(rec) ) return;
+		newStream = _waveformBuffer.addedNewStream();
+	}
+
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
 
-	if ( _waveformBuffer.addedNewStream() )
+	if ( newStream ) {
+		boost::recursive_mutex::scoped_lock lock(_callbackMutex);
 		handleNewStream(rec);
+	}
 
-	_registrationBlocked = true;
+	w->registrationBlocked = true;
 
-	std::pair<ProcessorMap::iterator, ProcessorMap::iterator> itq = _processors.equal_range(streamID);
+	std::pair<ProcessorMap::iterator, ProcessorMap::iterator> itq = w->processors.equal_range(streamID);
 	for ( ProcessorMap::iterator it = itq.first; it != itq.second; ++it ) {
 		// The proc must not be already on the removal list
-		if ( std::find(_waveformProcessorRemovalQueue.begin(),
-		               _waveformProcessorRemovalQueue.end(),
-		               it->second) != _waveformProcessorRemovalQueue.end() )
+		if ( std::find(w->waveformProcessorRemovalQueue.begin(),
+		               w->waveformProcessorRemovalQueue.end(),
+		               it->second) != w->waveformProcessorRemovalQueue.end() )
 			continue;
 
 		// Schedule the processor for deletion when finished
@@ -463,40 +691,46 @@ void Application::handleRecord(Record *rec) {
 		}
 	}
 
-	// Delete finished processors
-	for ( std::list<WaveformProcessor*>::iterator itt = trashList.begin();
-	      itt != trashList.end(); ++itt ) {
-		processorFinished(rec, *itt);
-		removeProcessor(*itt);
-	}
+	{
+		// Processors are released while holding the callback mutex as
+		// the application may reference them as well
+		boost::recursive_mutex::scoped_lock lock(_callbackMutex);
+
+		// Delete finished processors
+		for ( std::list<WaveformProcessor*>::iterator itt = trashList.begin();
+		      itt != trashList.end(); ++itt ) {
+			processorFinished(rec, *itt);
+			removeProcessor(w, *itt);
+		}
 
-	trashList.clear();
+		trashList.clear();
 
-	_registrationBlocked = false;
+		w->registrationBlocked = false;
 
-	// Remove outdated processors if not already on the trash list
-	while ( !_waveformProcessorRemovalQueue.empty() ) {
-		WaveformProcessorPtr wp = _waveformProcessorRemovalQueue.front();
-		_waveformProcessorRemovalQueue.pop_front();
-		removeProcessor(wp.get());
+		// Remove outdated processors if not already on the trash list
+		while ( !w->waveformProcessorRemovalQueue.empty() ) {
+			WaveformProcessorPtr wp = w->waveformProcessorRemovalQueue.front();
+			w->waveformProcessorRemovalQueue.pop_front();
+			removeProcessor(w, wp.get());
+		}
 	}
 
 	// Register pending processors
-	while ( !_waveformProcessorQueue.empty() ) {
-		WID wid = _waveformProcessorQueue.front().first;
-		WaveformProcessorPtr wp = _waveformProcessorQueue.front().second;
-		_waveformProcessorQueue.pop_front();
+	while ( !w->waveformProcessorQueue.empty() ) {
+		WID wid = w->waveformProcessorQueue.front().first;
+		WaveformProcessorPtr wp = w->waveformProcessorQueue.front().second;
+		w->waveformProcessorQueue.pop_front();
 
-		registerProcessor(wid.networkCode(), wid.stationCode(),
+		registerProcessor(w, wid.networkCode(), wid.stationCode(),
 		                  wid.locationCode(), wid.channelCode(), wp.get());
 	}
 
-	while ( !_timeWindowProcessorQueue.empty() ) {
-		WID wid = _timeWindowProcessorQueue.front().first;
-		TimeWindowProcessorPtr twp = _timeWindowProcessorQueue.front().second;
-		_timeWindowProcessorQueue.pop_front();
+	while ( !w->timeWindowProcessorQueue.empty() ) {
+		WID wid = w->timeWindowProcessorQueue.front().first;
+		TimeWindowProcessorPtr twp = w->timeWindowProcessorQueue.front().second;
+		w->timeWindowProcessorQueue.pop_front();
 
-		registerProcessor(wid.networkCode(), wid.stationCode(),
+		registerProcessor(w, wid.networkCode(), wid.stationCode(),
 		                  wid.locationCode(), wid.channelCode(), twp.get());
 	}
 }
@@ -505,8 +739,193 @@ void Application::handleRecord(Record *rec) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Application::storeRecord(Record *rec) {
+	if ( _workers.size() == 1 )
+		return Client::StreamApplication::storeRecord(rec);
+
+	// Records are passed directly to the processing threads and bypass
+	// the event loop of the main thread
+	if ( !_workersStarted ) startWorkers();
+
+	Worker *w = worker(rec->networkCode() + "." + rec->stationCode());
+
+	{
+		boost::mutex::scoped_lock lock(_pendingMutex);
+		++_pendingRecords;
+	}
+
+	if ( !w->queue.push(rec) ) {
+		boost::mutex::scoped_lock lock(_pendingMutex);
+		--_pendingRecords;
+		_pendingProcessed.notify_all();
+		return false;
+	}
+
+	synchronizeAcquisition();
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::flushStoredRecords() {
+	// A sync must not overtake the records which are still queued in
+	// the processing threads
+	boost::mutex::scoped_lock lock(_pendingMutex);
+	while ( _pendingRecords > 0 )
+		_pendingProcessed.wait(lock);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::processRecords(Worker *w) {
+	{
+		boost::recursive_mutex::scoped_lock lock(w->mutex);
+		w->threadID = boost::this_thread::get_id();
+	}
+
+	while ( true ) {
+		Record *rec;
+
+		try {
+			rec = w->queue.pop();
+		}
+		catch ( Client::QueueClosedException & ) {
+			break;
+		}
+
+		// A NULL record terminates the thread
+		if ( rec == NULL ) break;
+
+		RecordPtr tmp(rec);
+		Core::Time start = Core::Time::LocalTime();
+
+		try {
+			if ( rec->data() != NULL ) process(w, rec);
+		}
+		catch ( std::exception &e ) {
+			SEISCOMP_ERROR("Exception while processing %s: %s",
+			               rec->streamID().c_str(), e.what());
+		}
+
+		{
+			boost::recursive_mutex::scoped_lock lock(w->mutex);
+			++w->records;
+			w->busy += (double)(Core::Time::LocalTime() - start);
+			w->lastEndTime = rec->endTime();
+		}
+
+		boost::mutex::scoped_lock lock(_pendingMutex);
+		if ( --_pendingRecords == 0 )
+			_pendingProcessed.notify_all();
+	}
+
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+	w->threadID = boost::thread::id();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::startWorkers() {
+	SEISCOMP_INFO("Starting %d processing threads", (int)_workers.size());
+
+	for ( size_t i = 0; i < _workers.size(); ++i ) {
+		Worker *w = _workers[i];
+		w->thread = new boost::thread(boost::bind(&Application::processRecords, this, w));
+	}
+
+	_workersStarted = true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::stopWorkers() {
+	if ( !_workersStarted ) return;
+
+	// Queued records are processed before the threads terminate
+	for ( size_t i = 0; i < _workers.size(); ++i )
+		_workers[i]->queue.push(NULL);
+
+	for ( size_t i = 0; i < _workers.size(); ++i ) {
+		Worker *w = _workers[i];
+		w->thread->join();
+		delete w->thread;
+		w->thread = NULL;
+	}
+
+	_workersStarted = false;
+	SEISCOMP_INFO("Stopped processing threads");
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::acquisitionFinished() {
+	// Finish processing of all pending records before the application
+	// gets closed
+	stopWorkers();
+	dispatchPendingNotifications();
+	Client::StreamApplication::acquisitionFinished();
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void Application::handleMonitorLog(const Core::Time &timestamp) {
+	Client::StreamApplication::handleMonitorLog(timestamp);
+
+	if ( _workers.size() == 1 ) return;
+
+	for ( size_t i = 0; i < _workers.size(); ++i ) {
+		Worker *w = _workers[i];
+		boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+		if ( w->log ) logObject(w->log, timestamp, w->records);
+
+		if ( w->lastEndTime.valid() ) {
+			SEISCOMP_DEBUG("worker-%d: %lu records, %.2fs busy, %lu queued, %.1fs behind",
+			               (int)i, (unsigned long)w->records, w->busy,
+			               (unsigned long)w->queue.size(),
+			               (double)(Core::Time::GMT() - w->lastEndTime));
+		}
+
+		w->records = 0;
+		w->busy = 0;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::done() {
+	// The results of the processing threads are sent from the main
+	// thread. Stop the acquisition, process all queued records and
+	// dispatch the results before the base class closes the connection.
+	if ( recordStream() )
+		recordStream()->close();
+
+	waitForRecordThread();
+	stopWorkers();
+	dispatchPendingNotifications();
+
 	Client::StreamApplication::done();
 	//_waveformBuffer.printStreams();
 }
@@ -517,7 +936,10 @@ void Application::done() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::enableStation(const std::string& code, bool enabled) {
-	std::pair<StationProcessors::iterator, StationProcessors::iterator> itq = _stationProcessors.equal_range(code);
+	Worker *w = worker(code);
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+	std::pair<StationProcessors::iterator, StationProcessors::iterator> itq = w->stationProcessors.equal_range(code);
 	for (StationProcessors::iterator it = itq.first; it != itq.second; ++it) {
 		SEISCOMP_INFO("%s station %s", enabled?"Enabling":"Disabling", code.c_str());
 		it->second->setEnabled(enabled);
@@ -530,7 +952,14 @@ void Application::enableStation(const std::string& code, bool enabled) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 void Application::enableStream(const std::string& code, bool enabled) {
-	std::pair<StationProcessors::iterator, StationProcessors::iterator> itq = _processors.equal_range(code);
+	// The stream code is NET.STA.LOC.CHA
+	size_t pos = code.find('.');
+	if ( pos != std::string::npos ) pos = code.find('.', pos+1);
+
+	Worker *w = worker(code.substr(0, pos));
+	boost::recursive_mutex::scoped_lock lock(w->mutex);
+
+	std::pair<StationProcessors::iterator, StationProcessors::iterator> itq = w->processors.equal_range(code);
 	for (StationProcessors::iterator it = itq.first; it != itq.second; ++it) {
 		SEISCOMP_INFO("%s stream %s", enabled?"Enabling":"Disabling", code.c_str());
 		it->second->setEnabled(enabled);
@@ -21,6 +21,12 @@
 #include <seiscomp3/processing/timewindowprocessor.h>
 #include <seiscomp3/processing/streambuffer.h>
 
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/recursive_mutex.hpp>
+#include <deque>
+#include <vector>
+
 
 namespace Seiscomp {
 
@@ -75,6 +81,42 @@ class SC_SYSTEM_CLIENT_API Application : public Client::StreamApplication {
 
 		size_t processorCount() const;
 
+		/**
+		 * @brief Sets the number of threads used to process the records.
+		 *
+		 * With more than one thread the stations are distributed over
+		 * the threads and all processors of a station are fed by the
+		 * same thread. The records are then dispatched directly from
+		 * the acquisition thread and handleRecord is not called
+		 * anymore. handleNewStream, processorFinished and the publish
+		 * callbacks of the processors are called from the processing
+		 * threads. handleNewStream and processorFinished are called
+		 * with the callback mutex locked, publish callbacks must lock it
+		 * when accessing shared state. Processors must only be added for
+		 * the station of the record which is currently being processed.
+		 * Messages must be sent and the application must be exited from
+		 * the main thread with postNotification.
+		 *
+		 * This method must be called in init(). The default is 1 which
+		 * processes all records in the main thread.
+		 */
+		void setProcessingThreads(int count);
+		int processingThreads() const;
+
+		//! Returns the mutex which serializes the callbacks of the
+		//! processing threads
+		boost::recursive_mutex &callbackMutex();
+
+		/**
+		 * @brief Hands a notification to the main thread.
+		 *
+		 * Called from a processing thread the notification is queued
+		 * and passed to dispatchNotification in the main thread in the
+		 * order of posting. Otherwise it is dispatched immediately. The
+		 * object is released after it has been dispatched.
+		 */
+		void postNotification(int type, Core::BaseObject *obj = NULL);
+
 
 	// ----------------------------------------------------------------------
 	//  Protected methods
@@ -86,6 +128,13 @@ class SC_SYSTEM_CLIENT_API Application : public Client::StreamApplication {
 
 		void handleRecord(Record *rec);
 
+		bool storeRecord(Record *rec);
+		void flushStoredRecords();
+		void acquisitionFinished();
+		void handleMonitorLog(const Core::Time &timestamp);
+		bool dispatchNotification(int type, Core::BaseObject *obj);
+		void idle();
+
 		void enableStation(const std::string& code, bool enabled);
 		void enableStream(const std::string& code, bool enabled);
 
@@ -99,21 +148,35 @@ class SC_SYSTEM_CLIENT_API Application : public Client::StreamApplication {
 	//  Private methods
 	// ----------------------------------------------------------------------
 	private:
-		void registerProcessor(const std::string& networkCode,
+		struct Worker;
+
+		void registerProcessor(Worker *worker,
+		                       const std::string& networkCode,
 		                       const std::string& stationCode,
 		                       const std::string& locationCode,
 		                       const std::string& channelCode,
 		                       WaveformProcessor *wp);
-		void registerProcessor(const DataModel::WaveformStreamID &wfid,
-				       WaveformProcessor *twp);
 
-		void registerProcessor(const std::string& networkCode,
+		void registerProcessor(Worker *worker,
+		                       const std::string& networkCode,
 		                       const std::string& stationCode,
 		                       const std::string& locationCode,
 		                       const std::string& channelCode,
 		                       TimeWindowProcessor *twp);
-		void registerProcessor(const DataModel::WaveformStreamID &wfid,
-				       TimeWindowProcessor *twp);
+
+		void removeProcessor(Worker *worker, WaveformProcessor *wp);
+
+		//! Returns the worker of a station given as NET.STA
+		Worker *worker(const std::string &stationID) const;
+		//! Returns the worker running in the calling thread or NULL
+		Worker *currentWorker() const;
+
+		void dispatchPendingNotifications();
+
+		void process(Worker *worker, Record *rec);
+		void processRecords(Worker *worker);
+		void startWorkers();
+		void stopWorkers();
 
 
 	// ----------------------------------------------------------------------
@@ -128,16 +191,28 @@ class SC_SYSTEM_CLIENT_API Application : public Client::StreamApplication {
 		typedef std::list<WaveformProcessorItem>                 WaveformProcessorQueue;
 		typedef std::list<WaveformProcessorPtr>                  WaveformProcessorRemovalQueue;
 		typedef std::list<TimeWindowProcessorItem>               TimeWindowProcessorQueue;
+		typedef std::vector<Worker*>                             Workers;
+		typedef std::pair<int, Core::BaseObjectPtr>              PendingNotification;
+		typedef std::deque<PendingNotification>                  PendingNotifications;
 
-		ProcessorMap                    _processors;
-		StationProcessors               _stationProcessors;
+		// At least one worker which holds the processors of all
+		// stations if no processing threads are used
+		Workers                         _workers;
+		bool                            _workersStarted;
 
-		StreamBuffer                    _waveformBuffer;
+		// Records passed to the workers which have not been processed yet
+		size_t                          _pendingRecords;
+		boost::mutex                    _pendingMutex;
+		boost::condition_variable       _pendingProcessed;
 
-		WaveformProcessorQueue          _waveformProcessorQueue;
-		WaveformProcessorRemovalQueue   _waveformProcessorRemovalQueue;
-		TimeWindowProcessorQueue        _timeWindowProcessorQueue;
-		bool                            _registrationBlocked;
+		// Notifications posted by the workers for the main thread
+		PendingNotifications            _pendingNotifications;
+		boost::mutex                    _notificationMutex;
+		bool                            _notificationsPosted;
+
+		StreamBuffer                    _waveformBuffer;
+		boost::mutex                    _waveformBufferMutex;
+		boost::recursive_mutex          _callbackMutex;
 };
 
 
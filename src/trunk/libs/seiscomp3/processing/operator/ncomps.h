@@ -40,6 +40,11 @@ class Proc {
 */
 
 
+// Aligns the records of N components and passes the common time window to
+// PROC. The buffers only hold references to the records which are shared
+// with the stream buffer of the application. The samples are converted to
+// T when appended to the aligned window, PROC then works on this private
+// copy with its own state.
 template <typename T, int N, class PROC, int BSIZE=-1>
 class NCompsOperator : public WaveformOperator {
 	public:
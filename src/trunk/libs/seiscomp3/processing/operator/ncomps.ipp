@@ -30,6 +30,42 @@ struct ScopedUnsetFlag {
 	bool &flag;
 };
 
+
+// Appends n samples of source converted to T
+template <typename T, typename S>
+void appendSamples(NumericArray<T> *target, const S *source, int n) {
+	int ofs = target->size();
+	target->resize(ofs + n);
+	T *out = target->typedData() + ofs;
+	for ( int i = 0; i < n; ++i )
+		out[i] = (T)source[i];
+}
+
+
+// Appends n samples of source starting at index ofs converted to T.
+// Only the requested samples are converted instead of the whole record.
+template <typename T>
+void appendSamples(NumericArray<T> *target, const Array *source, int ofs, int n) {
+	switch ( source->dataType() ) {
+		case Array::INT:
+			appendSamples(target, static_cast<const IntArray*>(source)->typedData()+ofs, n);
+			break;
+		case Array::FLOAT:
+			appendSamples(target, static_cast<const FloatArray*>(source)->typedData()+ofs, n);
+			break;
+		case Array::DOUBLE:
+			appendSamples(target, static_cast<const DoubleArray*>(source)->typedData()+ofs, n);
+			break;
+		default:
+		{
+			typename Core::SmartPointer< NumericArray<T> >::Impl tmp;
+			tmp = (NumericArray<T>*)source->copy(NumericArray<T>::ArrayType);
+			target->append(n, tmp->typedData()+ofs);
+			break;
+		}
+	}
+}
+
 template <typename T, int N, class PROC, int BSIZE>
 WaveformProcessor::Status NCompsOperator<T,N,PROC,BSIZE>::process(int, const Record *rec) {
 	Core::Time minStartTime;
@@ -191,15 +227,12 @@ WaveformProcessor::Status NCompsOperator<T,N,PROC,BSIZE>::process(int, const Rec
 
 				++it[i];
 
+				// Records of the same type are used directly, all others are
+				// converted while appending
 				const NumericArray<T> *srcData = NumericArray<T>::ConstCast(rec_data);
-				typename Core::SmartPointer< NumericArray<T> >::Impl tmp;
-				if ( srcData == NULL ) {
-					tmp = (NumericArray<T>*)rec_data->copy(NumericArray<T>::ArrayType);
-					srcData = tmp.get();
-				}
 
 				int startIndex = 0;
-				int endIndex = srcData->size();
+				int endIndex = rec_data->size();
 
 				if ( (*rec_it)->startTime() < maxStartTime )
 					startIndex += (int)(double(maxStartTime-(*rec_it)->startTime())*(*rec_it)->samplingFrequency()+0.5);
@@ -233,7 +266,10 @@ WaveformProcessor::Status NCompsOperator<T,N,PROC,BSIZE>::process(int, const Rec
 						clipMask->set(ofs, clipMask->test(ofs) || recClipMask->test(i));
 				}
 
-				data[i]->append(len, srcData->typedData()+startIndex);
+				if ( srcData != NULL )
+					data[i]->append(len, srcData->typedData()+startIndex);
+				else
+					appendSamples(data[i].get(), rec_data, startIndex, len);
 
 				++rec_it;
 			}
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam                                          *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_PROCESSING_PICKER_AIC_PRIVATE_H__
+#define __SEISCOMP_PROCESSING_PICKER_AIC_PRIVATE_H__
+
+
+#include <math.h>
+
+
+namespace {
+
+
+// Number of samples at both ends of the trace which are not considered
+// as onset
+const int AICMargin = 10;
+
+
+//
+// AIC repicker using the simple non-AR algorithm of Maeda (1985),
+// see paper of Zhang et al. (2003) in BSSA
+//
+// The offset is subtracted from the data which must be filtered already.
+// Returns the index of the first minimum of the AIC curve within
+// [margin,n-margin) or -1 if the trace is too short. The variances before
+// and after the minimum are returned in var1 and var2.
+//
+template<typename TYPE>
+int maeda_aic_min(int n, const TYPE *data, double offset,
+                  double &var1, double &var2, int margin=AICMargin)
+{
+	int imin = margin, imax = n-margin;
+	if ( imax <= imin ) return -1;
+
+	// windowed sum for variance computation
+	double sumwin1 = 0, sumwin2 = 0;
+	for ( int i = 0; i < n; ++i ) {
+		double value = data[i]-offset;
+		if ( i < imin )
+			sumwin1 += value*value;
+		else
+			sumwin2 += value*value;
+	}
+
+	double minaic = 0;
+	int kmin = imin;
+	for ( int k = imin; k < imax; ++k ) {
+		double v1 = sumwin1/(k-1),
+		       v2 = sumwin2/(n-k-1);
+		double aic = k*log10(v1) + (n-k-1)*log10(v2);
+		double value = data[k]-offset;
+
+		sumwin1 += value*value;
+		sumwin2 -= value*value;
+
+		if ( k == imin || aic < minaic ) {
+			minaic = aic;
+			kmin = k;
+			var1 = v1;
+			var2 = v2;
+		}
+	}
+
+	return kmin;
+}
+
+}
+
+
+#endif
@@ -0,0 +1,202 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam, gempa GmbH                              *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#define SEISCOMP_COMPONENT PreprocessingCache
+
+#include <seiscomp3/processing/preprocessingcache.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <list>
+#include <map>
+#include <string.h>
+
+
+namespace Seiscomp {
+namespace Processing {
+
+
+namespace {
+
+
+struct Entry {
+	PreprocessingCache::Key key;
+	ResponseCPtr            response;
+	DoubleArrayPtr          data;
+
+	size_t memorySize() const {
+		return sizeof(Entry) + key.stage.size() +
+		       (key.input->size() + data->size()) * sizeof(double);
+	}
+};
+
+typedef std::list<Entry> Entries;
+typedef std::map<PreprocessingCache::Key, Entries::iterator> EntryIndex;
+
+
+boost::mutex cacheMutex;
+// Entries sorted by last access, most recent first
+Entries      entries;
+EntryIndex   index;
+size_t       memoryUsed = 0;
+size_t       memoryLimit = 32*1024*1024;
+
+
+void evict(size_t limit) {
+	while ( memoryUsed > limit && !entries.empty() ) {
+		memoryUsed -= entries.back().memorySize();
+		index.erase(entries.back().key);
+		entries.pop_back();
+	}
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PreprocessingCache::Key::Key()
+: response(NULL), fsamp(0), hash(0) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+PreprocessingCache::Key::Key(const Response *resp, const std::string &s,
+                             double fs, const DoubleArray &data)
+: response(resp), stage(s), fsamp(fs), input(new DoubleArray(data)) {
+	// FNV-1a over the sample values with an additional fold of the
+	// upper bits as whole 64 bit words are mixed in at once
+	hash = 14695981039346656037ULL;
+	const double *values = data.typedData();
+	for ( int i = 0; i < data.size(); ++i ) {
+		uint64_t v;
+		memcpy(&v, values + i, sizeof(v));
+		hash ^= v;
+		hash *= 1099511628211ULL;
+		hash ^= hash >> 32;
+	}
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PreprocessingCache::Key::operator<(const Key &other) const {
+	if ( hash != other.hash ) return hash < other.hash;
+	if ( input->size() != other.input->size() )
+		return input->size() < other.input->size();
+	if ( response != other.response ) return response < other.response;
+	if ( fsamp != other.fsamp ) return fsamp < other.fsamp;
+	int cmp = stage.compare(other.stage);
+	if ( cmp != 0 ) return cmp < 0;
+
+	// Equal hashes do not guarantee equal data. The bytes are compared to
+	// treat NaN values the same way as the hash does.
+	return memcmp(input->data(), other.input->data(),
+	              input->size() * sizeof(double)) < 0;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool PreprocessingCache::get(const Key &key, DoubleArray &data) {
+	if ( key.response == NULL ) return false;
+
+	boost::mutex::scoped_lock lock(cacheMutex);
+
+	EntryIndex::iterator it = index.find(key);
+	if ( it == index.end() ) return false;
+
+	// Mark as most recently used
+	entries.splice(entries.begin(), entries, it->second);
+	data = *it->second->data;
+
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void PreprocessingCache::put(const Key &key, const DoubleArray &data) {
+	if ( key.response == NULL ) return;
+
+	boost::mutex::scoped_lock lock(cacheMutex);
+
+	Entry entry;
+	entry.key = key;
+	entry.response = key.response;
+	entry.data = new DoubleArray(data);
+
+	size_t size = entry.memorySize();
+	if ( size > memoryLimit ) return;
+
+	EntryIndex::iterator it = index.find(key);
+	if ( it != index.end() ) {
+		memoryUsed -= it->second->memorySize();
+		entries.erase(it->second);
+		index.erase(it);
+	}
+
+	entries.push_front(entry);
+	index[key] = entries.begin();
+	memoryUsed += size;
+
+	evict(memoryLimit);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void PreprocessingCache::setCapacity(size_t bytes) {
+	boost::mutex::scoped_lock lock(cacheMutex);
+	memoryLimit = bytes;
+	evict(memoryLimit);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t PreprocessingCache::capacity() {
+	boost::mutex::scoped_lock lock(cacheMutex);
+	return memoryLimit;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void PreprocessingCache::clear() {
+	boost::mutex::scoped_lock lock(cacheMutex);
+	evict(0);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+}
+}
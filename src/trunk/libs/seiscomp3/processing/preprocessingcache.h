@@ -0,0 +1,96 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam, gempa GmbH                              *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_PROCESSING_PREPROCESSINGCACHE_H__
+#define __SEISCOMP_PROCESSING_PREPROCESSINGCACHE_H__
+
+
+#include <seiscomp3/core/typedarray.h>
+#include <seiscomp3/processing/response.h>
+#include <seiscomp3/client.h>
+
+#include <stdint.h>
+#include <string>
+
+
+namespace Seiscomp {
+namespace Processing  {
+
+
+/**
+ * @brief A process wide cache of preprocessed waveform data.
+ *
+ * Preprocessing stages such as the response deconvolution or the
+ * simulation of a seismometer are expensive and are often applied to the
+ * same data more than once, e.g. by the amplitude processors of
+ * consecutive origins of an event which share the same pick and thus the
+ * same time window.
+ *
+ * An entry is identified by the response, a description of the stage
+ * including all its parameters, the sampling frequency and the input data.
+ * Keys are ordered by a hash of the input first, the samples itself are
+ * only compared if the hashes are equal. The cache holds a reference to
+ * the response of each entry so that its address cannot be reused while
+ * the entry exists.
+ *
+ * The memory used by the cache is limited. If the limit is exceeded the
+ * least recently used entries are removed. All functions are thread-safe.
+ */
+class SC_SYSTEM_CLIENT_API PreprocessingCache {
+	// ----------------------------------------------------------------------
+	//  Public types
+	// ----------------------------------------------------------------------
+	public:
+		struct SC_SYSTEM_CLIENT_API Key {
+			Key();
+			//! Copies the input as it is usually replaced by the output
+			//! of the stage before the key is passed to put.
+			Key(const Response *response, const std::string &stage,
+			    double fsamp, const DoubleArray &input);
+
+			bool operator<(const Key &other) const;
+
+			const Response *response;
+			std::string     stage;
+			double          fsamp;
+			uint64_t        hash;
+			DoubleArrayCPtr input;
+		};
+
+
+	// ----------------------------------------------------------------------
+	//  Public interface
+	// ----------------------------------------------------------------------
+	public:
+		//! Copies the cached output of a stage into data. Returns false
+		//! if no entry exists for the key.
+		static bool get(const Key &key, DoubleArray &data);
+
+		//! Stores a copy of the output of a stage
+		static void put(const Key &key, const DoubleArray &data);
+
+		//! Sets the maximum memory used by all entries in bytes. Zero
+		//! disables the cache. The default is 32MB.
+		static void setCapacity(size_t bytes);
+		static size_t capacity();
+
+		//! Removes all entries
+		static void clear();
+};
+
+
+}
+}
+
+
+#endif
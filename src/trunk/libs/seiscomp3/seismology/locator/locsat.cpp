@@ -466,7 +466,112 @@ DataModel::Origin* LocSAT::fromPicks(PickList &picks){
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 DataModel::Origin *LocSAT::relocate(const DataModel::Origin *origin) {
-	if ( origin == NULL ) return NULL;
+	if ( !prepareRelocation(origin) ) return NULL;
+
+	if ( _usingFixedDepth ) {
+		_locator_params->fixing_depth = _fixedDepth;
+		_locator_params->fix_depth = 'y';
+	}
+	else
+		_locator_params->fix_depth = 'n';
+
+	DataModel::Origin *result = locateEvent(_locateEvent, origin);
+
+	delete _locateEvent;
+	_locateEvent = NULL;
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::Origin *LocSAT::relocate(const DataModel::Origin *origin,
+                                    const StartLocations &startLocations) {
+	if ( startLocations.empty() || !prepareRelocation(origin) ) return NULL;
+
+	if ( _usingFixedDepth ) {
+		_locator_params->fixing_depth = _fixedDepth;
+		_locator_params->fix_depth = 'y';
+	}
+	else
+		_locator_params->fix_depth = 'n';
+
+	// The start locations are used regardless of IgnoreInitialLocation
+	_locator_params->use_location = TRUE;
+
+	TrialResult best;
+
+	for ( size_t i = 0; i < startLocations.size(); ++i ) {
+		// The initial location of the parameters is applied to each trial
+		// by locateEvent and must match the start location
+		_locator_params->lat_init = startLocations[i].latitude;
+		_locator_params->lon_init = startLocations[i].longitude;
+		_locator_params->depth_init = startLocations[i].depth;
+
+		Internal::LocSAT trial(*_locateEvent);
+		trial.setOrigin(startLocations[i].latitude,
+		                startLocations[i].longitude,
+		                startLocations[i].depth);
+
+		double rms;
+		DataModel::Origin *result = locateTrial(trial, origin, rms);
+		if ( result ) keepBest(best, result, rms);
+	}
+
+	delete _locateEvent;
+	_locateEvent = NULL;
+
+	return finishTrials(best);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::Origin *LocSAT::scanDepth(const DataModel::Origin *origin,
+                                     const std::vector<double> &depths,
+                                     DepthProfile *profile) {
+	if ( profile ) profile->clear();
+	if ( depths.empty() || !prepareRelocation(origin) ) return NULL;
+
+	_locator_params->fix_depth = 'y';
+
+	TrialResult best;
+
+	for ( size_t i = 0; i < depths.size(); ++i ) {
+		_locator_params->fixing_depth = depths[i];
+
+		Internal::LocSAT trial(*_locateEvent);
+		double rms;
+		DataModel::Origin *result = locateTrial(trial, origin, rms);
+
+		if ( profile ) {
+			DepthTrial entry;
+			entry.depth = depths[i];
+			entry.rms = result ? rms : -1;
+			profile->push_back(entry);
+		}
+
+		if ( result ) keepBest(best, result, rms);
+	}
+
+	delete _locateEvent;
+	_locateEvent = NULL;
+
+	return finishTrials(best);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool LocSAT::prepareRelocation(const DataModel::Origin *origin) {
+	if ( origin == NULL ) return false;
 
 	if ( isInitialLocationIgnored() )
 		setLocatorParams(LP_USE_LOCATION, "n");
@@ -492,18 +597,21 @@ DataModel::Origin *LocSAT::relocate(const DataModel::Origin *origin) {
 	if ( !loadArrivals(origin)) {
 		delete _locateEvent;
 		_locateEvent = NULL;
-		return NULL;
+		return false;
 	}
 
-	if ( _usingFixedDepth ) {
-		_locator_params->fixing_depth = _fixedDepth;
-		_locator_params->fix_depth = 'y';
-	}
-	else
-		_locator_params->fix_depth = 'n';
+	return true;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
 
-	_locateEvent->setLocatorParams(_locator_params);
-	Internal::Loc *newLoc = _locateEvent->doLocation();
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::Origin *LocSAT::locateEvent(Internal::LocSAT *event,
+                                       const DataModel::Origin *origin) {
+	event->setLocatorParams(_locator_params);
+	Internal::Loc *newLoc = event->doLocation();
 
 	DataModel::Origin *result = loc2Origin(newLoc);
 
@@ -545,8 +653,6 @@ DataModel::Origin *LocSAT::relocate(const DataModel::Origin *origin) {
 	}
 
 	if ( newLoc) free(newLoc);
-	delete _locateEvent;
-	_locateEvent = NULL;
 
 	return result;
 }
@@ -555,6 +661,74 @@ DataModel::Origin *LocSAT::relocate(const DataModel::Origin *origin) {
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::Origin *LocSAT::locateTrial(Internal::LocSAT &event,
+                                       const DataModel::Origin *origin,
+                                       double &rms) {
+	// Trial origins are created without the configured publicID as it
+	// can only be registered once. It is assigned to the best trial.
+	std::string newOriginID;
+	std::swap(newOriginID, _newOriginID);
+
+	DataModel::Origin *result = NULL;
+
+	try {
+		result = locateEvent(&event, origin);
+	}
+	catch ( std::exception &e ) {
+		SEISCOMP_DEBUG("LocSAT trial failed: %s", e.what());
+	}
+
+	std::swap(newOriginID, _newOriginID);
+
+	if ( result == NULL ) return NULL;
+
+	try {
+		rms = result->quality().standardError();
+	}
+	catch ( ... ) {
+		delete result;
+		return NULL;
+	}
+
+	return result;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+void LocSAT::keepBest(TrialResult &best, DataModel::Origin *origin, double rms) {
+	if ( best.origin == NULL || rms < best.rms ) {
+		delete best.origin;
+		best.origin = origin;
+		best.rms = rms;
+		best.errorEllipsoid = _errorEllipsoid;
+	}
+	else
+		delete origin;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+DataModel::Origin *LocSAT::finishTrials(TrialResult &best) {
+	if ( best.origin == NULL ) return NULL;
+
+	_errorEllipsoid = best.errorEllipsoid;
+	if ( !_newOriginID.empty() )
+		best.origin->setPublicID(_newOriginID);
+
+	return best.origin;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 static bool atTransitionPtoPKP(const DataModel::Arrival* arrival) {
 	return (arrival->distance() > 106.9 && arrival->distance() < 111.1);
@@ -69,6 +69,29 @@ struct SC_SYSTEM_CORE_API LocSATErrorEllipsoid {
 
 
 class SC_SYSTEM_CORE_API LocSAT : public Seismology::LocatorInterface {
+	public:
+		struct StartLocation {
+			StartLocation() : latitude(0), longitude(0), depth(0) {}
+			StartLocation(double lat, double lon, double dep)
+			: latitude(lat), longitude(lon), depth(dep) {}
+
+			double latitude;
+			double longitude;
+			double depth;
+		};
+
+		typedef std::vector<StartLocation> StartLocations;
+
+		//! A point of the curve returned by scanDepth
+		struct DepthTrial {
+			double depth;
+			//! The RMS of the solution or -1 if the location failed
+			double rms;
+		};
+
+		typedef std::vector<DepthTrial> DepthProfile;
+
+
 	public:
 		LocSAT();
 		virtual ~LocSAT();
@@ -102,11 +125,53 @@ class SC_SYSTEM_CORE_API LocSAT : public Seismology::LocatorInterface {
 
 		DataModel::Origin* relocate(const DataModel::Origin* origin);
 
+		/**
+		 * Relocates an origin starting from each of the given initial
+		 * locations and returns the solution with the lowest RMS or NULL
+		 * if all trials failed. The arrivals are loaded only once for all
+		 * trials.
+		 *
+		 * This is a multi-start API only. The trials run one after another
+		 * as the LocSAT library is not reentrant and every call into it
+		 * holds TTT::locsatMutex(). The wall time is therefore the sum of
+		 * all trials and not that of a single location.
+		 */
+		DataModel::Origin* relocate(const DataModel::Origin* origin,
+		                            const StartLocations &startLocations);
+
+		/**
+		 * Relocates an origin with the depth fixed to each of the given
+		 * depths and returns the solution with the lowest RMS or NULL if
+		 * all trials failed. If profile is given it receives the RMS of
+		 * each depth. Like relocate() with start locations the depths are
+		 * located one after another.
+		 */
+		DataModel::Origin* scanDepth(const DataModel::Origin* origin,
+		                             const std::vector<double> &depths,
+		                             DepthProfile *profile = NULL);
+
 		const LocSATErrorEllipsoid &errorEllipsoid() const {
 			return _errorEllipsoid;
 		}
 
 	private:
+		struct TrialResult {
+			TrialResult() : origin(NULL), rms(0) {}
+
+			DataModel::Origin    *origin;
+			double                rms;
+			LocSATErrorEllipsoid  errorEllipsoid;
+		};
+
+		bool prepareRelocation(const DataModel::Origin *origin);
+		DataModel::Origin *locateEvent(Internal::LocSAT *event,
+		                               const DataModel::Origin *origin);
+		DataModel::Origin *locateTrial(Internal::LocSAT &event,
+		                               const DataModel::Origin *origin,
+		                               double &rms);
+		void keepBest(TrialResult &best, DataModel::Origin *origin, double rms);
+		DataModel::Origin *finishTrials(TrialResult &best);
+
 		void setLocatorParams(int param, const char* value);
 		std::string getLocatorParams(int param) const;
 		void setDefaultLocatorParams();
@@ -14,6 +14,8 @@
 #include "locsat.h"
 #include "locsat_internal.h"
 
+#include <seiscomp3/seismology/ttt/locsat.h>
+
 
 using namespace Seiscomp::Seismology;
 
@@ -22,6 +24,38 @@ namespace Seiscomp {
 namespace Internal {
 
 
+namespace {
+
+template <typename T>
+T *duplicate(const T *source, int count) {
+	if ( source == NULL ) return NULL;
+	T *target = (T*)malloc(count * sizeof(T));
+	memcpy(target, source, count * sizeof(T));
+	return target;
+}
+
+
+// Locator_params declares a destructor and must not be copied with
+// memcpy. The string buffers are not copied.
+void copyParams(Locator_params *target, const Locator_params *source) {
+	target->num_dof = source->num_dof;
+	target->est_std_error = source->est_std_error;
+	target->conf_level = source->conf_level;
+	target->damp = source->damp;
+	target->max_iterations = source->max_iterations;
+	target->fix_depth = source->fix_depth;
+	target->fixing_depth = source->fixing_depth;
+	target->lat_init = source->lat_init;
+	target->lon_init = source->lon_init;
+	target->depth_init = source->depth_init;
+	target->use_location = source->use_location;
+	target->verbose = source->verbose;
+	target->cor_level = source->cor_level;
+}
+
+}
+
+
 LocSAT::LocSAT() {
 	_origerr = (Origerr*)malloc(sizeof(Origerr));
 	_origin = (Origin*)malloc(sizeof(Origin));
@@ -43,6 +77,31 @@ LocSAT::LocSAT() {
 }
 
 
+LocSAT::LocSAT(const LocSAT &other) {
+	_origerr = duplicate(other._origerr, 1);
+	_origin = duplicate(other._origin, 1);
+
+	_locator_params = (Locator_params*)malloc(sizeof(Locator_params));
+	copyParams(_locator_params, other._locator_params);
+	_locator_params->outfile_name = duplicate(other._locator_params->outfile_name, 1024);
+	_locator_params->prefix = duplicate(other._locator_params->prefix, 1024);
+
+	_dt = duplicate(other._dt, 1);
+
+	_sites = duplicate(other._sites, other._siteCount);
+	_arrival = duplicate(other._arrival, other._arrivalCount);
+	_assoc = duplicate(other._assoc, other._assocCount);
+	_locator_errors = duplicate(other._locator_errors, other._arrivalCount);
+	_newnet = other._newnet;
+
+	_num_obs = other._num_obs;
+	_num_sta = other._num_sta;
+	_siteCount = other._siteCount;
+	_arrivalCount = other._arrivalCount;
+	_assocCount = other._assocCount;
+}
+
+
 LocSAT::~LocSAT() {
 	reset();
 
@@ -94,9 +153,13 @@ Loc* LocSAT::doLocation() {
 	if( (_num_sta > 9999) || (_num_obs > 9999) )
 		throw LocatorException("error: Too many picks/stations [9999] - Please raise limits within pre-f2c locsat code!");
 
+	// The LocSAT library keeps the travel time tables and the site list
+	// in static variables. It is shared with the travel time interfaces.
+	boost::recursive_mutex::scoped_lock lock(TTT::locsatMutex());
 	int ierr = locate_event(NULL, _sites, _num_sta, _arrival, _assoc,
 	                        _origin, _origerr, _locator_params,
 	                        _locator_errors, _num_obs);
+	lock.unlock();
 
 	//std::cerr << "ierr = locate_event: " <<  ierr << std::endl;
 
@@ -274,13 +337,7 @@ void LocSAT::printLocatorParams(){
 
 
 void LocSAT::setLocatorParams(Locator_params* params){
-
-	char *outfile_name = _locator_params->outfile_name;
-	char *prefix = _locator_params->prefix;
-
-	memmove(_locator_params, params, sizeof(Locator_params));
-	_locator_params->prefix = prefix;
-	_locator_params->outfile_name = outfile_name;
+	copyParams(_locator_params, params);
 
 	strcpy(_locator_params->outfile_name, params->outfile_name);
 	strcpy(_locator_params->prefix, params->prefix);
@@ -33,6 +33,10 @@ class LocSAT {
 
 public:
 	LocSAT();
+	//! Creates a deep copy of the sites, arrivals and parameters. It is
+	//! used to run several trials on the same data as LocSAT modifies
+	//! the associations in place.
+	LocSAT(const LocSAT &other);
 	~LocSAT();
 
 	void reset();
@@ -75,6 +79,7 @@ private:
 	int _arrivalCount;
 	int _assocCount;
 
+	LocSAT &operator=(const LocSAT &);
 };
 
 } // of namespace Internal
@@ -13,6 +13,7 @@
 
 
 #include <seiscomp3/seismology/ttt.h>
+#include <seiscomp3/seismology/ttt/locsat.h>
 #include <seiscomp3/math/geo.h>
 #include <seiscomp3/core/interfacefactory.ipp>
 
@@ -39,6 +40,9 @@ bool ellipcorr(const std::string &phase, double lat1, double lon1, double lat2,
 	Seiscomp::Math::Geo::delazi(lat1, lon1, lat2, lon2, &delta, &azi1, &azi2);
 	real staazi=azi1, stadel=delta, zfoc = depth, colat = 90. - lat1, ecorr=0;
 
+	// elpcor_ keeps its state in static variables
+	boost::recursive_mutex::scoped_lock lock(TTT::locsatMutex());
+
 	if (phase=="P" || phase=="Pn" || phase=="Pg" || phase=="Pb" || phase=="Pdif" || phase=="Pdiff")
 		elpcor_("P       ", &stadel, &zfoc, &staazi, &colat, &ecorr, 8);
 	else if (phase=="PcP")
@@ -0,0 +1,503 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_COMPONENT TTT
+
+#include <seiscomp3/logging/log.h>
+#include <seiscomp3/system/environment.h>
+#include <seiscomp3/utils/timer.h>
+#include <seiscomp3/seismology/ttt/grid.h>
+#include <seiscomp3/seismology/ttt/libtau.h>
+#include <seiscomp3/seismology/ttt/locsat.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <vector>
+#include <string.h>
+
+
+namespace Seiscomp {
+namespace TTT {
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+extern "C" {
+
+void distaz2_(double *lat1, double *lon1, double *lat2, double *lon2, double *delta, double *azi1, double *azi2);
+int setup_tttables_dir(const char *new_dir, int verbose);
+double compute_ttime(double distance, double depth, char *phase, int extrapolate, double *dtdel, int *errorflag);
+int num_phases();
+char **phase_types();
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+struct Grid::Model {
+	struct Phase {
+		std::string        name;
+		// Travel times with depth as major index, negative if not defined
+		std::vector<float> times;
+	};
+
+	typedef std::vector<Phase> Phases;
+
+	Model() {
+		numberOfDistances = int(MaxDistance / DistanceStep + 0.5) + 1;
+		numberOfDepths = int(MaxDepth / DepthStep + 0.5) + 1;
+	}
+
+	Phase &add(const std::string &name) {
+		phases.resize(phases.size()+1);
+		Phase &phase = phases.back();
+		phase.name = name;
+		phase.times.assign(numberOfDistances*numberOfDepths, -1);
+		return phase;
+	}
+
+	const Phase *find(const char *name) const {
+		for ( size_t i = 0; i < phases.size(); ++i )
+			if ( !strcmp(phases[i].name.c_str(), name) ) return &phases[i];
+		return NULL;
+	}
+
+	bool interpolate(TravelTime &tt, const Phase &phase,
+	                 double delta, double depth) const {
+		if ( !(delta >= 0) || !(depth >= 0) ) return false;
+
+		double fx = delta / DistanceStep;
+		double fz = depth / DepthStep;
+		int ix = int(fx);
+		int iz = int(fz);
+
+		// The last node belongs to the last cell
+		if ( ix >= numberOfDistances-1 ) {
+			if ( fx > numberOfDistances-1 ) return false;
+			ix = numberOfDistances-2;
+		}
+
+		if ( iz >= numberOfDepths-1 ) {
+			if ( fz > numberOfDepths-1 ) return false;
+			iz = numberOfDepths-2;
+		}
+
+		const float *t0 = &phase.times[iz*numberOfDistances+ix];
+		const float *t1 = t0 + numberOfDistances;
+
+		if ( t0[0] < 0 || t0[1] < 0 || t1[0] < 0 || t1[1] < 0 )
+			return false;
+
+		double wx = fx - ix;
+		double wz = fz - iz;
+
+		double top = t0[0] + wx*(t0[1]-t0[0]);
+		double bottom = t1[0] + wx*(t1[1]-t1[0]);
+
+		tt.phase = phase.name;
+		tt.time = top + wz*(bottom-top);
+		tt.dtdd = ((1-wz)*(t0[1]-t0[0]) + wz*(t1[1]-t1[0])) / DistanceStep;
+		tt.dtdh = (bottom-top) / DepthStep;
+		tt.dddp = 0;
+		tt.takeoff = 0;
+
+		return true;
+	}
+
+	static const double MaxDistance;
+	static const double MaxDepth;
+	static const double DistanceStep;
+	static const double DepthStep;
+
+	int    numberOfDistances;
+	int    numberOfDepths;
+	Phases phases;
+};
+
+
+const double Grid::Model::MaxDistance = 180.0;
+const double Grid::Model::MaxDepth = 800.0;
+const double Grid::Model::DistanceStep = 0.25;
+const double Grid::Model::DepthStep = 5.0;
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+namespace {
+
+
+typedef std::map<std::string, Grid::Model*> Models;
+
+
+// All loaded models. Models are never changed after they have been
+// inserted and are kept until the process exits.
+struct Registry {
+	~Registry() {
+		for ( Models::iterator it = models.begin(); it != models.end(); ++it )
+			delete it->second;
+	}
+
+	boost::mutex mutex;
+	Models       models;
+};
+
+
+Registry registry;
+
+
+bool loadLocsat(Grid::Model &model, const std::string &name) {
+	std::string prefix = Environment::Instance()->shareDir() + "/locsat/tables/" + name;
+
+	// The tables are global. Other LOCSAT users load their tables again
+	// on their next call.
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
+	if ( setup_tttables_dir(prefix.c_str(), 0) != 0 ) return false;
+
+	int nphases = num_phases();
+	char **phases = phase_types();
+
+	for ( int p = 0; p < nphases; ++p ) {
+		Grid::Model::Phase *phase = NULL;
+
+		for ( int iz = 0; iz < model.numberOfDepths; ++iz ) {
+			double depth = iz * Grid::Model::DepthStep;
+			size_t offset = iz*model.numberOfDistances;
+
+			for ( int ix = 0; ix < model.numberOfDistances; ++ix ) {
+				double delta = ix * Grid::Model::DistanceStep;
+				double dtdel;
+				int errorflag = 0;
+				double ttime = compute_ttime(delta, depth, phases[p], 0, &dtdel, &errorflag);
+				// This comparison is there to also skip NaN values
+				if ( errorflag != 0 || !(ttime > 0) ) continue;
+
+				if ( phase == NULL ) phase = &model.add(phases[p]);
+				phase->times[offset+ix] = float(ttime);
+			}
+		}
+	}
+
+	return !model.phases.empty();
+}
+
+
+bool loadLibTau(Grid::Model &model, const std::string &name) {
+	LibTau tau;
+
+	try {
+		tau.setModel(name);
+	}
+	catch ( std::exception &e ) {
+		SEISCOMP_ERROR("%s", e.what());
+		return false;
+	}
+
+	std::map<std::string, size_t> phases;
+
+	// Iterate over depth first, changing the depth is expensive in libtau
+	for ( int iz = 0; iz < model.numberOfDepths; ++iz ) {
+		double depth = iz * Grid::Model::DepthStep;
+		size_t offset = iz*model.numberOfDistances;
+
+		for ( int ix = 0; ix < model.numberOfDistances; ++ix ) {
+			// Along the equator the longitude difference is the distance
+			double delta = ix * Grid::Model::DistanceStep;
+			TravelTimeList *ttlist;
+
+			try {
+				ttlist = tau.compute(0, 0, depth, 0, delta, 0, 0);
+			}
+			catch ( std::exception & ) {
+				continue;
+			}
+
+			if ( ttlist == NULL ) continue;
+
+			// The list is sorted by time, keep the first arrival of each
+			// phase
+			for ( TravelTimeList::iterator it = ttlist->begin();
+			      it != ttlist->end(); ++it ) {
+				if ( !(it->time > 0) ) continue;
+
+				std::map<std::string, size_t>::iterator pit = phases.find(it->phase);
+				if ( pit == phases.end() ) {
+					pit = phases.insert(std::make_pair(it->phase, model.phases.size())).first;
+					model.add(it->phase);
+				}
+
+				float &time = model.phases[pit->second].times[offset+ix];
+				if ( time < 0 ) time = float(it->time);
+			}
+
+			delete ttlist;
+		}
+	}
+
+	return !model.phases.empty();
+}
+
+
+const Grid::Model *load(const std::string &id) {
+	boost::mutex::scoped_lock lock(registry.mutex);
+
+	Models::iterator it = registry.models.find(id);
+	if ( it != registry.models.end() ) return it->second;
+
+	std::string source = "LOCSAT";
+	std::string name = id;
+	size_t pos = id.find(':');
+	if ( pos != std::string::npos ) {
+		source = id.substr(0, pos);
+		name = id.substr(pos+1);
+	}
+
+	Util::StopWatch timer;
+	Grid::Model *model = new Grid::Model;
+	bool ok;
+
+	// Loading is serialized by the registry mutex, LOCSAT tables are
+	// additionally loaded under the LOCSAT lock
+	if ( source == "LOCSAT" )
+		ok = loadLocsat(*model, name);
+	else if ( source == "libtau" )
+		ok = loadLibTau(*model, name);
+	else {
+		SEISCOMP_ERROR("TTT grid: unknown source: %s", source.c_str());
+		ok = false;
+	}
+
+	if ( !ok ) {
+		SEISCOMP_ERROR("TTT grid: failed to load model %s", id.c_str());
+		delete model;
+		return NULL;
+	}
+
+	SEISCOMP_INFO("TTT grid: loaded %d phases of model %s in %fs",
+	              int(model->phases.size()), id.c_str(), (double)timer.elapsed());
+
+	registry.models[id] = model;
+	return model;
+}
+
+
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Grid::Grid() : _tables(NULL) {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+Grid::~Grid() {}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::setModel(const std::string &model) {
+	_model = model;
+
+	if ( _model.empty() ) {
+		_tables = NULL;
+		return true;
+	}
+
+	_tables = load(_model);
+	return _tables != NULL;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+const std::string &Grid::model() const {
+	return _model;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTimeList *Grid::compute(double lat1, double lon1, double dep1,
+                              double lat2, double lon2, double alt2,
+                              int ellc) {
+	if ( _tables == NULL ) return NULL;
+
+	double delta, azi1, azi2;
+	distaz2_(&lat1, &lon1, &lat2, &lon2, &delta, &azi1, &azi2);
+
+	TravelTimeList *ttlist = new TravelTimeList;
+	ttlist->delta = delta;
+	ttlist->depth = dep1;
+
+	TravelTime tt;
+	for ( size_t i = 0; i < _tables->phases.size(); ++i ) {
+		if ( !_tables->interpolate(tt, _tables->phases[i], delta, dep1) )
+			continue;
+
+		if ( ellc ) {
+			double ecorr = 0.;
+			if ( ellipcorr(tt.phase, lat1, lon1, lat2, lon2, dep1, ecorr) )
+				tt.time += ecorr;
+		}
+
+		ttlist->push_back(tt);
+	}
+
+	ttlist->sortByTime();
+
+	return ttlist;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTime Grid::compute(const char *phase,
+                         double lat1, double lon1, double dep1,
+                         double lat2, double lon2, double alt2,
+                         int ellc) {
+	double delta, azi1, azi2;
+	distaz2_(&lat1, &lon1, &lat2, &lon2, &delta, &azi1, &azi2);
+
+	TravelTime tt;
+	if ( !compute(tt, phase, delta, dep1) ) throw NoPhaseError();
+
+	if ( ellc ) {
+		double ecorr = 0.;
+		if ( ellipcorr(tt.phase, lat1, lon1, lat2, lon2, dep1, ecorr) )
+			tt.time += ecorr;
+	}
+
+	return tt;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+TravelTime Grid::computeFirst(double lat1, double lon1, double dep1,
+                              double lat2, double lon2, double alt2,
+                              int ellc) {
+	if ( _tables == NULL ) throw NoPhaseError();
+
+	double delta, azi1, azi2;
+	distaz2_(&lat1, &lon1, &lat2, &lon2, &delta, &azi1, &azi2);
+
+	TravelTime first, tt;
+	bool found = false;
+
+	for ( size_t i = 0; i < _tables->phases.size(); ++i ) {
+		if ( !_tables->interpolate(tt, _tables->phases[i], delta, dep1) )
+			continue;
+
+		if ( !found || tt.time < first.time ) {
+			first = tt;
+			found = true;
+		}
+	}
+
+	if ( !found ) throw NoPhaseError();
+
+	if ( ellc ) {
+		double ecorr = 0.;
+		if ( ellipcorr(first.phase, lat1, lon1, lat2, lon2, dep1, ecorr) )
+			first.time += ecorr;
+	}
+
+	return first;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+size_t Grid::compute(TravelTime *results, const char *phase,
+                     const Point *points, size_t count, int ellc) const {
+	const Model::Phase *tables = _tables != NULL ? _tables->find(phase) : NULL;
+	size_t valid = 0;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		const Point &p = points[i];
+		TravelTime &tt = results[i];
+
+		double lat1 = p.lat1, lon1 = p.lon1, lat2 = p.lat2, lon2 = p.lon2;
+		double delta, azi1, azi2;
+		distaz2_(&lat1, &lon1, &lat2, &lon2, &delta, &azi1, &azi2);
+
+		if ( tables == NULL || !_tables->interpolate(tt, *tables, delta, p.dep1) ) {
+			tt = TravelTime(phase, -1, 0, 0, 0, 0);
+			continue;
+		}
+
+		if ( ellc ) {
+			double ecorr = 0.;
+			if ( ellipcorr(tt.phase, lat1, lon1, lat2, lon2, p.dep1, ecorr) )
+				tt.time += ecorr;
+		}
+
+		++valid;
+	}
+
+	return valid;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+bool Grid::compute(TravelTime &result, const char *phase,
+                   double delta, double depth) const {
+	if ( _tables == NULL ) return false;
+
+	const Model::Phase *tables = _tables->find(phase);
+	if ( tables == NULL ) return false;
+
+	return _tables->interpolate(result, *tables, delta, depth);
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+REGISTER_TRAVELTIMETABLE(Grid, "grid");
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+}
+}
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#ifndef _SEISCOMP_TTT_GRID_H_
+#define _SEISCOMP_TTT_GRID_H_
+
+
+#include <string>
+#include <seiscomp3/seismology/ttt.h>
+
+
+namespace Seiscomp {
+namespace TTT {
+
+
+/**
+ * Grid
+ *
+ * Travel times sampled on a dense regular (distance, depth) grid.
+ *
+ * When a model is set for the first time its travel times are sampled
+ * for each phase from either the LOCSAT tables or libtau. The grids are
+ * immutable after loading and shared by all instances using the same
+ * model. Travel times are computed with bilinear interpolation.
+ *
+ * Any number of models can be used at the same time. The interpolation
+ * does not change any state. Loading LOCSAT tables and the ellipticity
+ * correction (ellc) call into the LOCSAT library and are serialized with
+ * TTT::locsatMutex(). An instance must not be used from other threads
+ * while setModel() is called.
+ *
+ * The model is given as "[source:]name" where source is either "LOCSAT"
+ * (default) or "libtau", e.g. "iasp91" or "libtau:iasp91". The grid
+ * spacing is 0.25 deg in distance and 5 km in depth. Take-off angles are
+ * not available.
+ */
+class SC_SYSTEM_CORE_API Grid : public TravelTimeTableInterface {
+	public:
+		//! A source receiver pair used for batch computations
+		struct Point {
+			Point() {}
+			Point(double la1, double lo1, double d1,
+			      double la2, double lo2, double a2 = 0.)
+			: lat1(la1), lon1(lo1), dep1(d1), lat2(la2), lon2(lo2), alt2(a2) {}
+
+			double lat1, lon1, dep1;
+			double lat2, lon2, alt2;
+		};
+
+		//! The sampled tables of a model
+		struct Model;
+
+
+	public:
+		Grid();
+		~Grid();
+
+
+	public:
+		bool setModel(const std::string &model);
+		const std::string &model() const;
+
+
+		/**
+		 * @brief Compute the traveltime(s) for the model selected using
+		 *        setModel().
+		 *
+		 * Note that altitude correction is currently not implemented! The
+		 * respective parameters are ignored.
+		 * @param dep1 The source depth in km
+		 *
+		 * @returns A TravelTimeList of travel times sorted by time.
+		 */
+		TravelTimeList *compute(double lat1, double lon1, double dep1,
+		                        double lat2, double lon2, double alt2 = 0.,
+		                        int ellc = 1);
+
+		/**
+		 * Compute the traveltime for a given phase.
+		 * @param dep1 The source depth in km
+		 *
+		 * @returns A TravelTime
+		 */
+		TravelTime compute(const char *phase,
+		                   double lat1, double lon1, double dep1,
+		                   double lat2, double lon2, double alt2 = 0.,
+		                   int ellc = 1);
+
+		/**
+		 * Compute the traveltime for the first (fastest) phase.
+		 * @param dep1 The source depth in km
+		 *
+		 * @returns A TravelTime
+		 */
+		TravelTime computeFirst(double lat1, double lon1, double dep1,
+		                        double lat2, double lon2, double alt2 = 0.,
+		                        int ellc = 1);
+
+		/**
+		 * @brief Compute the traveltimes of a phase for a batch of
+		 *        source receiver pairs.
+		 * @param results The output array with at least count elements.
+		 *                Travel times which are not available have
+		 *                a negative time.
+		 * @returns The number of available travel times
+		 */
+		size_t compute(TravelTime *results, const char *phase,
+		               const Point *points, size_t count,
+		               int ellc = 1) const;
+
+		/**
+		 * @brief Compute the traveltime of a phase for a distance and
+		 *        depth without ellipticity correction.
+		 * @param delta The distance in degrees
+		 * @param depth The source depth in km
+		 * @returns Whether the phase is available or not
+		 */
+		bool compute(TravelTime &result, const char *phase,
+		             double delta, double depth) const;
+
+
+	private:
+		std::string  _model;
+		const Model *_tables;
+};
+
+
+}
+}
+
+
+#endif
@@ -45,6 +45,16 @@ char **phase_types();
 
 
 
+// >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+boost::recursive_mutex &locsatMutex() {
+	static boost::recursive_mutex mutex;
+	return mutex;
+}
+// <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+
+
+
+
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 Locsat::Locsat() : _Pindex(-1) {}
 // <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
@@ -110,6 +120,7 @@ const std::string &Locsat::model() const {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 bool Locsat::initTables() {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	if ( _tablePrefix.empty()
 	  || (setup_tttables_dir(_tablePrefix.c_str()) != 0) )
 		return false;
@@ -136,6 +147,7 @@ bool Locsat::initTables() {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 TravelTimeList *Locsat::compute(double delta, double depth) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	int nphases = num_phases();
 	char **phases = phase_types();
 	//float vp, vs;
@@ -181,6 +193,7 @@ TravelTimeList *Locsat::compute(double delta, double depth) {
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 TravelTime Locsat::compute(const char *phase, double delta, double depth) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	int errorflag=0;
 	double dtdel;
 	double ttime = compute_ttime(delta, depth, const_cast<char*>(phase), 0, &dtdel, &errorflag);
@@ -198,6 +211,7 @@ TravelTime Locsat::compute(const char *phase, double delta, double depth) {
 TravelTimeList *Locsat::compute(double lat1, double lon1, double dep1,
                                 double lat2, double lon2, double alt2,
                                 int ellc) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	if ( !initTables() ) return NULL;
 
 	double delta, azi1, azi2;
@@ -230,6 +244,7 @@ TravelTime Locsat::compute(const char *phase,
                            double lat1, double lon1, double dep1,
                            double lat2, double lon2, double alt2,
                            int ellc) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	if ( !initTables() ) throw NoPhaseError();
 
 	double delta, azi1, azi2;
@@ -252,6 +267,7 @@ TravelTime Locsat::compute(const char *phase,
 
 // >>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
 TravelTime Locsat::computeFirst(double delta, double depth) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	char **phases = phase_types();
 	char *phase = phases[_Pindex];
 	int errorflag=0;
@@ -271,6 +287,7 @@ TravelTime Locsat::computeFirst(double delta, double depth) {
 TravelTime Locsat::computeFirst(double lat1, double lon1, double dep1,
                                 double lat2, double lon2, double alt2,
                                 int ellc) {
+	boost::recursive_mutex::scoped_lock lock(locsatMutex());
 	if ( !initTables() ) throw NoPhaseError();
 
 	double delta, azi1, azi2;
@@ -20,11 +20,23 @@
 #include <vector>
 #include <seiscomp3/seismology/ttt.h>
 
+#include <boost/thread/recursive_mutex.hpp>
+
 
 namespace Seiscomp {
 namespace TTT {
 
 
+/**
+ * Returns the lock of the LOCSAT library. The library keeps the loaded
+ * travel time tables and the state of the ellipticity correction in
+ * static variables. Locsat, Grid, ellipcorr() and the LocSAT locator
+ * hold this lock while they call into it. The lock is recursive as the
+ * ellipticity correction is applied while the tables are locked.
+ */
+SC_SYSTEM_CORE_API boost::recursive_mutex &locsatMutex();
+
+
 /**
  * TTTLibTau
  *
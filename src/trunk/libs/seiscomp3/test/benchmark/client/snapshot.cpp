@@ -0,0 +1,79 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/client/snapshot.h>
+#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <boost/filesystem.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+
+
+int main(int, char **) {
+	char tmpl[] = "/tmp/sc3snapshotXXXXXX";
+	const char *dir = mkdtemp(tmpl);
+	if ( dir == NULL ) {
+		fprintf(stderr, "unable to create a temporary directory\n");
+		return 1;
+	}
+
+	PublicObject::SetRegistrationEnabled(false);
+
+	// 5000 stations
+	InventoryPtr inv = createInventory(20, 250);
+	Client::SnapshotCache cache(dir);
+
+	string xmlFile = string(dir) + "/inventory.xml";
+	IO::XMLArchive ar;
+	bool ok = ar.create(xmlFile.c_str());
+	if ( ok ) {
+		ar << inv;
+		ar.close();
+	}
+
+	ok = ok && cache.save("inventory", "key", inv.get());
+	inv = NULL;
+
+	if ( ok ) {
+		Util::StopWatch timer;
+		InventoryPtr fromXML;
+		if ( ar.open(xmlFile.c_str()) ) {
+			ar >> fromXML;
+			ar.close();
+		}
+		double xmlTime = (double)timer.elapsed();
+
+		timer.restart();
+		InventoryPtr fromSnapshot = Inventory::Cast(cache.load("inventory", "key"));
+		double snapshotTime = (double)timer.elapsed();
+
+		ok = fromXML && fromSnapshot;
+		printf("load 5000 stations: XML %.3fs, snapshot %.3fs\n", xmlTime, snapshotTime);
+	}
+
+	boost::system::error_code ec;
+	boost::filesystem::remove_all(dir, ec);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/core/typedarray.h>
+#include <seiscomp3/utils/timer.h>
+
+#include <stdio.h>
+
+
+using namespace Seiscomp;
+
+
+namespace {
+
+
+// The former non-atomic reference counter
+struct PlainCounted {
+	PlainCounted() : count(0) {}
+	void inc() const { ++count; }
+	bool dec() const { return --count == 0; }
+	mutable volatile unsigned int count;
+};
+
+
+}
+
+
+int main(int, char **) {
+	const int N = 10000000;
+
+	DoubleArrayPtr obj = new DoubleArray;
+	PlainCounted plain;
+
+	Util::StopWatch timer;
+	for ( int i = 0; i < N; ++i ) {
+		obj->incrementReferenceCount();
+		obj->decrementReferenceCount();
+	}
+	double atomicTime = (double)timer.elapsed();
+
+	timer.restart();
+	for ( int i = 0; i < N; ++i ) {
+		plain.inc();
+		plain.dec();
+	}
+	double plainTime = (double)timer.elapsed();
+
+	printf("%d reference count increment/decrement pairs: atomic %.3fs, plain %.3fs\n",
+	       N, atomicTime, plainTime);
+
+	return obj->referenceCount() == 1 ? 0 : 1;
+}
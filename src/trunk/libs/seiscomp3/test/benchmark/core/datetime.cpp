@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/core/datetime.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Core;
+using namespace Seiscomp::Test;
+
+
+int main(int, char **) {
+	// Spelled out formats are converted with strftime and strptime
+	const char *genericISO = "%Y-%m-%dT%H:%M:%S.%fZ";
+
+	vector<Time> times = createTimes(1000000);
+	vector<string> strings(times.size());
+	size_t length = 0;
+
+	Util::StopWatch timer;
+	for ( size_t i = 0; i < times.size(); ++i )
+		strings[i] = times[i].toString(genericISO);
+	double genericFormat = (double)timer.elapsed();
+
+	timer.restart();
+	for ( size_t i = 0; i < times.size(); ++i )
+		strings[i] = times[i].iso();
+	double fastFormat = (double)timer.elapsed();
+
+	timer.restart();
+	char buf[32];
+	for ( size_t i = 0; i < times.size(); ++i )
+		length += times[i].iso(buf, sizeof(buf));
+	double bufferFormat = (double)timer.elapsed();
+
+	Time t;
+	timer.restart();
+	for ( size_t i = 0; i < strings.size(); ++i )
+		t.fromString(strings[i].c_str(), genericISO);
+	double genericParse = (double)timer.elapsed();
+
+	timer.restart();
+	for ( size_t i = 0; i < strings.size(); ++i )
+		t.fromISO(strings[i].c_str());
+	double fastParse = (double)timer.elapsed();
+
+	printf("format %d times: strftime %.3fs, iso() %.3fs, iso(buffer) %.3fs (%d bytes)\n",
+	       int(times.size()), genericFormat, fastFormat, bufferFormat, int(length));
+	printf("parse %d times: strptime %.3fs, fromISO %.3fs\n",
+	       int(strings.size()), genericParse, fastParse);
+
+	return 0;
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/datamodel/diff.h>
+#include <seiscomp3/datamodel/utils.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+
+
+int main(int, char **) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	// 60000 streams with one changed gain
+	InventoryPtr local = createInventory(200, 100);
+	InventoryPtr remote = createInventory(200, 100);
+	remote->network(150)->station(42)->sensorLocation(0)->stream(1)->setGain(2E9);
+
+	Diff2 diff;
+
+	// Logging differences disables skipping equal subtrees
+	Diff2::LogNode log;
+	log.setLevel(Diff2::LogNode::DIFFERENCES);
+	Diff2::Notifiers walked;
+	Util::StopWatch timer;
+	diff.diff(local.get(), remote.get(), "", walked, &log);
+	double walkTime = (double)timer.elapsed();
+
+	Diff2::Notifiers hashed;
+	timer.restart();
+	diff.diff(local.get(), remote.get(), "", hashed);
+	double hashTime = (double)timer.elapsed();
+
+	printf("Diff2 60000 streams: full walk %.3fs, content hashes %.3fs\n",
+	       walkTime, hashTime);
+
+	DiffMerge merge;
+	vector<NotifierPtr> merged;
+	timer.restart();
+	merge.diff(local.get(), remote.get(), merged);
+	printf("DiffMerge 60000 streams: content hashes %.3fs\n", (double)timer.elapsed());
+
+	return walked.size() == 1 && hashed.size() == 1 && merged.size() == 1 ? 0 : 1;
+}
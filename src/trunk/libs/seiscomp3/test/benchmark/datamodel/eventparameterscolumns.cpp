@@ -0,0 +1,68 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/datamodel/eventparameterscolumns.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+
+
+int main(int, char **) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	EventParametersPtr ep = createEventParameters(20000, 20);
+
+	EventParametersColumns columns;
+	columns.add(ep.get());
+
+	Core::Time start(2015, 1, 1), end(2015, 1, 8);
+	size_t count = 0;
+
+	Util::StopWatch timer;
+	for ( size_t i = 0; i < ep->pickCount(); ++i ) {
+		const Pick *pick = ep->pick(i);
+		if ( pick->time().value() >= start && pick->time().value() < end &&
+		     pick->waveformID().stationCode() == "MORC" )
+			++count;
+	}
+	printf("objects: %d picks in %.3fs\n", int(count), (double)timer.elapsed());
+
+	timer.restart();
+	size_t rows = columns.selectPicks(start, end, "GE.MORC..BHZ").size();
+	printf("columns: %d picks in %.3fs\n", int(rows), (double)timer.elapsed());
+
+	timer.restart();
+	double sum = 0;
+	size_t arrivals = 0;
+	for ( size_t i = 0; i < ep->originCount(); ++i ) {
+		const Origin *origin = ep->origin(i);
+		for ( size_t a = 0; a < origin->arrivalCount(); ++a, ++arrivals )
+			sum += origin->arrival(a)->timeResidual();
+	}
+	printf("objects: mean residual %g in %.3fs\n", sum / arrivals, (double)timer.elapsed());
+
+	timer.restart();
+	EventParametersColumns::Statistics stats = columns.timeResiduals();
+	printf("columns: mean residual %g in %.3fs\n", stats.mean, (double)timer.elapsed());
+
+	return rows == count ? 0 : 1;
+}
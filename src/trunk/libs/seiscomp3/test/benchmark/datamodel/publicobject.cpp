@@ -0,0 +1,91 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/datamodel/pick.h>
+#include <seiscomp3/utils/timer.h>
+
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+
+
+namespace {
+
+
+// Creates publicIDs as generated by scautopick, scamp and scolv. They
+// share long prefixes which is the worst case for an ordered map.
+vector<string> createIds(size_t count) {
+	const char *patterns[] = {
+		"Pick/2015%02d%02d%02d%02d%02d.%06d.%d",
+		"Amplitude/2015%02d%02d%02d%02d%02d.%06d.%d",
+		"smi:org.gfz-potsdam.de/geofon/Arrival/2015%02d%02d%02d%02d%02d.%06d.%d"
+	};
+
+	vector<string> ids;
+	ids.reserve(count);
+
+	for ( size_t i = 0; i < count; ++i ) {
+		char id[128];
+		int seconds = (int)(i / 3) * 7;
+		snprintf(id, sizeof(id), patterns[i % 3],
+		         1 + seconds / 2678400 % 12, 1 + seconds / 86400 % 28,
+		         seconds / 3600 % 24, seconds / 60 % 60, seconds % 60,
+		         (int)(i * 7919 % 1000000), (int)i);
+		ids.push_back(id);
+	}
+
+	return ids;
+}
+
+
+}
+
+
+int main(int, char **) {
+	vector<string> ids = createIds(500000);
+	vector<PickPtr> picks;
+	picks.reserve(ids.size());
+
+	Util::StopWatch timer;
+	for ( size_t i = 0; i < ids.size(); ++i )
+		picks.push_back(Pick::Create(ids[i]));
+	double createTime = (double)timer.elapsed();
+
+	// Objects are not looked up in the order they were created
+	vector<string> lookups(ids);
+	random_shuffle(lookups.begin(), lookups.end());
+
+	size_t found = 0;
+	timer.restart();
+	for ( int n = 0; n < 4; ++n ) {
+		for ( size_t i = 0; i < lookups.size(); ++i )
+			found += Pick::Find(lookups[i]) != NULL ? 1 : 0;
+	}
+	double findTime = (double)timer.elapsed();
+
+	timer.restart();
+	picks.clear();
+	double deleteTime = (double)timer.elapsed();
+
+	printf("%d publicIDs: create %.3fs, find %.3fs, delete %.3fs\n",
+	       int(ids.size()), createTime, findTime, deleteTime);
+
+	return found == ids.size() * 4 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/io/archive/bsonarchive.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+
+
+int main(int, char **) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	// 20000 arrivals
+	EventParametersPtr ep = createEventParameters(200, 100);
+
+	const char *filename = "/tmp/benchmark_bsonarchive.bson";
+	double times[2];
+	bool ok = true;
+
+	for ( int streaming = 0; streaming < 2; ++streaming ) {
+		Util::StopWatch timer;
+		IO::BSONArchive ar;
+		ar.setStreaming(streaming != 0);
+		if ( !ar.create(filename) ) return 1;
+		ar << ep;
+		ar.close();
+		times[streaming] = (double)timer.elapsed();
+		ok = ok && ar.good();
+	}
+
+	remove(filename);
+
+	printf("write 20000 arrivals: tree %.3fs, streaming %.3fs\n", times[0], times[1]);
+
+	return ok ? 0 : 1;
+}
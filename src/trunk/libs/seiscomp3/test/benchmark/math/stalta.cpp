@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/math/filter/stalta.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../../processing/picker/aic_private.h"
+#include "../../fixtures.h"
+
+#include <stdio.h>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Math::Filtering;
+using namespace Seiscomp::Test;
+
+
+namespace {
+
+
+template <typename T>
+void benchmarkSTALTA(const char *name, double fsamp) {
+	// One day of data
+	vector<T> data = createTrace<T>(fsamp, 86400);
+	vector<T> ref = data;
+
+	Util::StopWatch timer;
+	referenceSTALTA(ref, fsamp, 2, 80);
+	double refTime = (double)timer.elapsed();
+
+	STALTA<T> filter(2, 80, fsamp);
+	timer.restart();
+	for ( size_t i = 0; i < data.size(); i += 512 )
+		filter.apply(min(data.size()-i, size_t(512)), &data[i]);
+	double time = (double)timer.elapsed();
+
+	printf("STALTA<%s> %gHz: %d samples in %.3fs, reference %.3fs\n",
+	       name, fsamp, int(data.size()), time, refTime);
+}
+
+
+}
+
+
+int main(int, char **) {
+	benchmarkSTALTA<double>("double", 100);
+	benchmarkSTALTA<double>("double", 200);
+	benchmarkSTALTA<float>("float", 100);
+	benchmarkSTALTA<float>("float", 200);
+
+	// Typical repick windows of 30 seconds
+	vector<double> data = createTrace<double>(200, 30);
+	const int loops = 1000;
+	int kmin = 0;
+
+	Util::StopWatch timer;
+	for ( int i = 0; i < loops; ++i )
+		kmin += referenceAIC((int)data.size(), &data[0]);
+	double refTime = (double)timer.elapsed();
+
+	timer.restart();
+	for ( int i = 0; i < loops; ++i ) {
+		double var1, var2;
+		kmin -= maeda_aic_min((int)data.size(), &data[0], 0.0, var1, var2);
+	}
+	double time = (double)timer.elapsed();
+
+	printf("AIC: %d windows of %d samples in %.3fs, reference %.3fs\n",
+	       loops, int(data.size()), time, refTime);
+
+	return kmin == 0 ? 0 : 1;
+}
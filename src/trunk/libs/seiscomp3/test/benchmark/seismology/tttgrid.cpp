@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+
+#include <seiscomp3/seismology/ttt/grid.h>
+#include <seiscomp3/seismology/ttt/libtau.h>
+#include <seiscomp3/seismology/ttt/locsat.h>
+#include <seiscomp3/utils/timer.h>
+
+#include "../../fixtures.h"
+
+#include <stdio.h>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::TTT;
+using namespace Seiscomp::Test;
+
+
+namespace {
+
+
+double benchmark(TravelTimeTableInterface &ttt, const vector<Grid::Point> &points,
+                 size_t &count) {
+	Util::StopWatch timer;
+	count = 0;
+
+	for ( size_t i = 0; i < points.size(); ++i ) {
+		const Grid::Point &p = points[i];
+		try {
+			ttt.compute("P", p.lat1, p.lon1, p.dep1, p.lat2, p.lon2, 0, 0);
+			++count;
+		}
+		catch ( ... ) {}
+	}
+
+	return (double)timer.elapsed();
+}
+
+
+}
+
+
+int main(int, char **) {
+	vector<Grid::Point> points = createPoints(100000);
+	size_t count;
+
+	Grid grid;
+	if ( !grid.setModel("iasp91") ) {
+		fprintf(stderr, "iasp91 grid not available\n");
+		return 1;
+	}
+
+	double gridTime = benchmark(grid, points, count);
+	printf("grid  : %d travel times in %.3fs\n", int(count), gridTime);
+
+	vector<TravelTime> results(points.size());
+	Util::StopWatch timer;
+	count = grid.compute(&results[0], "P", &points[0], points.size(), 0);
+	printf("batch : %d travel times in %.3fs\n", int(count), (double)timer.elapsed());
+
+	Locsat locsat;
+	if ( locsat.setModel("iasp91") ) {
+		double locsatTime = benchmark(locsat, points, count);
+		printf("LOCSAT: %d travel times in %.3fs\n", int(count), locsatTime);
+	}
+
+	// The libtau tables are optional
+	LibTau libtau;
+	try {
+		libtau.setModel("iasp91");
+	}
+	catch ( ... ) {
+		return 0;
+	}
+
+	double libtauTime = benchmark(libtau, points, count);
+	printf("libtau: %d travel times in %.3fs\n", int(count), libtauTime);
+
+	return 0;
+}
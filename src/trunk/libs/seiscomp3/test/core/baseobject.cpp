@@ -0,0 +1,96 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_baseobject
+
+
+#include <seiscomp3/core/genericrecord.h>
+#include <seiscomp3/core/typedarray.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include <boost/thread.hpp>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+const int Threads = 8;
+const int Iterations = 100000;
+
+
+// Copies and releases a shared record in a loop and reads its samples
+struct Processor {
+	Processor(RecordPtr rec, double *mean) : rec(rec), mean(mean) {}
+
+	void operator()() {
+		vector<RecordPtr> copies;
+		copies.reserve(16);
+
+		for ( int i = 0; i < Iterations; ++i ) {
+			copies.push_back(rec);
+			if ( copies.size() == copies.capacity() )
+				copies.clear();
+		}
+
+		const DoubleArray *data = DoubleArray::ConstCast(rec->data());
+		*mean = data->mean();
+		rec = NULL;
+	}
+
+	RecordPtr  rec;
+	double    *mean;
+};
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(sharedRecord) {
+	unsigned int objects = Core::BaseObject::ObjectCount();
+
+	{
+		DoubleArrayPtr samples = new DoubleArray(1000);
+		for ( int i = 0; i < samples->size(); ++i )
+			(*samples)[i] = i;
+
+		GenericRecordPtr rec = new GenericRecord("GE", "MORC", "", "BHZ",
+		                                         Core::Time(2015, 1, 1), 20.0);
+		rec->setData(samples.get());
+		samples = NULL;
+
+		vector<double> means(Threads, 0);
+		boost::thread_group threads;
+		for ( int i = 0; i < Threads; ++i )
+			threads.create_thread(Processor(rec.get(), &means[i]));
+
+		threads.join_all();
+
+		BOOST_CHECK_EQUAL(rec->referenceCount(), 1u);
+		for ( int i = 0; i < Threads; ++i )
+			BOOST_CHECK_EQUAL(means[i], 499.5);
+	}
+
+	// The record and its data have been deleted exactly once
+	BOOST_CHECK_EQUAL(Core::BaseObject::ObjectCount(), objects);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
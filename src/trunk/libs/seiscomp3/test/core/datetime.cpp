@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_datetime
+
+
+#include <seiscomp3/core/datetime.h>
+#include <seiscomp3/core/strings.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Core;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+// The same formats spelled out are not recognized as standard formats
+// and are converted with strftime and strptime.
+const char *GenericISO = "%Y-%m-%dT%H:%M:%S.%fZ";
+const char *GenericSQL = "%Y-%m-%d %H:%M:%S ";
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(format) {
+	BOOST_CHECK_EQUAL(Time(0, 0).iso(), "1970-01-01T00:00:00.0000Z");
+	BOOST_CHECK_EQUAL(Time(2015, 3, 1, 12, 30, 5, 120000).iso(), "2015-03-01T12:30:05.12Z");
+	BOOST_CHECK_EQUAL(Time(2000, 2, 29, 23, 59, 59, 1).iso(), "2000-02-29T23:59:59.000001Z");
+	BOOST_CHECK_EQUAL(Time(1969, 12, 31, 23, 59, 59, 500000).iso(), "1969-12-31T23:59:59.5Z");
+	BOOST_CHECK_EQUAL(Time(2015, 3, 1).toString("%F %T"), "2015-03-01 00:00:00");
+	BOOST_CHECK_EQUAL(Time(2015, 3, 1).toString("%FT%TZ"), "2015-03-01T00:00:00Z");
+
+	char buf[32];
+	BOOST_CHECK_EQUAL(Time(2015, 3, 1).iso(buf, sizeof(buf)), size_t(25));
+	BOOST_CHECK_EQUAL(string(buf), "2015-03-01T00:00:00.0000Z");
+	BOOST_CHECK_EQUAL(Time(2015, 3, 1).iso(buf, 25), size_t(0));
+
+	vector<Time> times = createTimes(100000);
+	for ( size_t i = 0; i < times.size(); ++i ) {
+		size_t len = times[i].iso(buf, sizeof(buf));
+		string generic = times[i].toString(GenericISO);
+		BOOST_REQUIRE_EQUAL(string(buf, len), generic);
+		BOOST_REQUIRE_EQUAL(times[i].iso(), generic);
+		BOOST_REQUIRE_EQUAL(times[i].toString("%F %T") + " ", times[i].toString(GenericSQL));
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(parse) {
+	Time t;
+	BOOST_CHECK(t.fromISO("2015-03-01T12:30:05.12Z"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5, 120000));
+	BOOST_CHECK(t.fromISO("2015-03-01T12:30:05Z"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5));
+	BOOST_CHECK(t.fromISO("2015-03-01T12:30:05.1234567Z"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5, 123456));
+	BOOST_CHECK(t.fromISO("1969-12-31T23:59:59.5Z"));
+	BOOST_CHECK(t == Time(1969, 12, 31, 23, 59, 59, 500000));
+	BOOST_CHECK(t.fromString("2015-03-01 12:30:05", "%F %T"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5));
+	// Fractions of timestamps returned by the database are ignored
+	BOOST_CHECK(t.fromString("2015-03-01 12:30:05.123", "%F %T"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5));
+	// Rolls over into March as timegm does
+	BOOST_CHECK(t.fromISO("2015-02-30T00:00:00Z"));
+	BOOST_CHECK(t == Time(2015, 3, 2));
+
+	// Not zero padded: handled by strptime
+	BOOST_CHECK(t.fromString("2015-3-1 12:30:05", "%F %T"));
+	BOOST_CHECK(t == Time(2015, 3, 1, 12, 30, 5));
+
+	BOOST_CHECK(!t.fromISO("2015-03-01T12:30:05"));
+	BOOST_CHECK(!t.fromISO("2015-13-01T12:30:05Z"));
+	BOOST_CHECK(!t.fromISO("2015-03-01T24:30:05Z"));
+	BOOST_CHECK(!t.fromISO(""));
+
+	Time parsed;
+	BOOST_CHECK(fromString(parsed, "2015-03-01T12:30:05Z"));
+	BOOST_CHECK(parsed == Time(2015, 3, 1, 12, 30, 5));
+
+	vector<Time> times = createTimes(100000);
+	for ( size_t i = 0; i < times.size(); ++i ) {
+		string str = times[i].iso();
+		Time fast, generic;
+		BOOST_REQUIRE(fast.fromISO(str.c_str()));
+		BOOST_REQUIRE(generic.fromString(str.c_str(), GenericISO));
+		BOOST_REQUIRE(fast == generic);
+		BOOST_REQUIRE(fast == times[i]);
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -0,0 +1,218 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_diff
+
+
+#include <seiscomp3/datamodel/diff.h>
+#include <seiscomp3/datamodel/inventory_package.h>
+#include <seiscomp3/datamodel/utils.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <limits>
+#include <sstream>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+class AcceptingDiff : public Diff3 {
+	protected:
+		bool confirmUpdate(const Core::BaseObject *, const Core::BaseObject *,
+		                   LogNode *) {
+			return true;
+		}
+};
+
+
+Stream *findStream(Inventory *inv, int n, int s, int c) {
+	return inv->network(n)->station(s)->sensorLocation(0)->stream(c);
+}
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(equalTrees) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	InventoryPtr local = createInventory(3, 5);
+	InventoryPtr remote = createInventory(3, 5);
+
+	Diff2 diff;
+	Diff2::Notifiers notifiers;
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_CHECK(notifiers.empty());
+
+	// The order of children does not matter
+	NetworkPtr net = remote->network(0);
+	remote->removeNetwork(0);
+	remote->add(net.get());
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_CHECK(notifiers.empty());
+
+	AcceptingDiff diff3;
+	diff3.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_CHECK(notifiers.empty());
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(changedTrees) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	InventoryPtr local = createInventory(3, 5);
+	InventoryPtr remote = createInventory(3, 5);
+
+	Stream *stream = findStream(remote.get(), 1, 2, 0);
+	stream->setGain(2E9);
+
+	Diff2 diff;
+	Diff2::Notifiers notifiers;
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_REQUIRE_EQUAL(notifiers.size(), size_t(1));
+	BOOST_CHECK_EQUAL(notifiers[0]->operation(), OP_UPDATE);
+	BOOST_CHECK(notifiers[0]->object() == stream);
+	BOOST_CHECK_EQUAL(notifiers[0]->parentID(), "SensorLocation/N1/S2");
+
+	// The objects may change between two diffs
+	findStream(local.get(), 1, 2, 0)->setGain(2E9);
+	notifiers.clear();
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_CHECK(notifiers.empty());
+
+	// Unset optional attributes
+	findStream(local.get(), 0, 0, 1)->setGain(Core::None);
+	findStream(remote.get(), 2, 4, 2)->setSampleRateDenominator(Core::None);
+	remote->network(2)->station(0)->comment(0)->setText("Moved");
+	remote->network(0)->station(1)->sensorLocation(0)->removeStream(0);
+	remote->network(1)->station(3)->sensorLocation(0)->add(Stream::Create("Stream/new"));
+
+	Diff2::Notifiers notifiers3;
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	AcceptingDiff diff3;
+	diff3.diff(local.get(), remote.get(), "", notifiers3);
+
+	BOOST_REQUIRE_EQUAL(notifiers.size(), size_t(5));
+	BOOST_REQUIRE_EQUAL(notifiers3.size(), notifiers.size());
+
+	int ops[4] = { 0, 0, 0, 0 };
+	for ( size_t i = 0; i < notifiers.size(); ++i ) {
+		++ops[notifiers[i]->operation()];
+		BOOST_CHECK_EQUAL(notifiers[i]->operation(), notifiers3[i]->operation());
+		BOOST_CHECK(notifiers[i]->object() == notifiers3[i]->object());
+	}
+
+	BOOST_CHECK_EQUAL(ops[OP_ADD], 1);
+	BOOST_CHECK_EQUAL(ops[OP_REMOVE], 1);
+	BOOST_CHECK_EQUAL(ops[OP_UPDATE], 3);
+
+	// Logging all properties walks the full trees but yields the same
+	// notifiers
+	Diff2::LogNode log;
+	log.setLevel(Diff2::LogNode::ALL);
+	Diff2::Notifiers logged;
+	diff.diff(local.get(), remote.get(), "", logged, &log);
+	BOOST_CHECK_EQUAL(logged.size(), notifiers.size());
+	BOOST_CHECK_EQUAL(log.childCount(), size_t(1));
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(notANumber) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	InventoryPtr local = createInventory(1, 2);
+	InventoryPtr remote = createInventory(1, 2);
+
+	// NaN never compares equal and is always reported as an update
+	double nan = numeric_limits<double>::quiet_NaN();
+	findStream(local.get(), 0, 1, 2)->setGain(nan);
+	findStream(remote.get(), 0, 1, 2)->setGain(nan);
+
+	Diff2 diff;
+	Diff2::Notifiers notifiers;
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_REQUIRE_EQUAL(notifiers.size(), size_t(1));
+	BOOST_CHECK(notifiers[0]->object() == findStream(remote.get(), 0, 1, 2));
+
+	// Zero compares equal regardless of the sign
+	findStream(local.get(), 0, 1, 2)->setGain(0.0);
+	findStream(remote.get(), 0, 1, 2)->setGain(-0.0);
+	notifiers.clear();
+	diff.diff(local.get(), remote.get(), "", notifiers);
+	BOOST_CHECK(notifiers.empty());
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(diffMerge) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	InventoryPtr local = createInventory(3, 5);
+	InventoryPtr remote = createInventory(3, 5);
+
+	DiffMerge merge;
+	vector<NotifierPtr> notifiers;
+	BOOST_CHECK(merge.diff(local.get(), remote.get(), notifiers));
+	BOOST_CHECK(notifiers.empty());
+
+	Stream *stream = findStream(remote.get(), 1, 2, 0);
+	stream->setGain(2E9);
+	BOOST_CHECK(merge.diff(local.get(), remote.get(), notifiers));
+	BOOST_REQUIRE_EQUAL(notifiers.size(), size_t(1));
+	BOOST_CHECK_EQUAL(notifiers[0]->operation(), OP_UPDATE);
+	BOOST_CHECK(notifiers[0]->object() == stream);
+
+	// Logging all properties walks the equal subtrees as well
+	merge.setLoggingLevel(2);
+	notifiers.clear();
+	BOOST_CHECK(merge.diff(local.get(), remote.get(), notifiers));
+	BOOST_REQUIRE_EQUAL(notifiers.size(), size_t(1));
+	BOOST_CHECK(notifiers[0]->object() == stream);
+
+	stringstream log;
+	merge.showLog(log);
+	BOOST_CHECK(log.str().find("S4") != string::npos);
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
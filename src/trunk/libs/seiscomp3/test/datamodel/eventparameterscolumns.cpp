@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_eventparameterscolumns
+
+
+#include <seiscomp3/datamodel/eventparameterscolumns.h>
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <sstream>
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(dictionary) {
+	StringDictionary dict;
+	BOOST_CHECK_EQUAL(dict.insert("P"), StringDictionary::Index(0));
+	BOOST_CHECK_EQUAL(dict.insert("S"), StringDictionary::Index(1));
+	BOOST_CHECK_EQUAL(dict.insert("P"), StringDictionary::Index(0));
+	BOOST_CHECK_EQUAL(dict.size(), size_t(2));
+	BOOST_CHECK_EQUAL(dict.find("S"), StringDictionary::Index(1));
+	BOOST_CHECK_EQUAL(dict.find("Pn"), StringDictionary::None);
+	BOOST_CHECK_EQUAL(dict.value(1), "S");
+
+	// Values must stay valid while the dictionary grows
+	for ( int i = 0; i < 10000; ++i ) {
+		char value[16];
+		snprintf(value, sizeof(value), "%d", i);
+		dict.insert(value);
+	}
+	BOOST_CHECK_EQUAL(dict.value(0), "P");
+	BOOST_CHECK_EQUAL(dict.value(10001), "9999");
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(queries) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	EventParametersPtr ep = createEventParameters(10, 6);
+
+	EventParametersColumns columns;
+	columns.add(ep.get());
+
+	BOOST_CHECK_EQUAL(columns.picks().size(), size_t(60));
+	BOOST_CHECK_EQUAL(columns.origins().size(), size_t(10));
+	BOOST_CHECK_EQUAL(columns.arrivals().size(), size_t(60));
+	BOOST_CHECK_EQUAL(columns.magnitudes().size(), size_t(10));
+	BOOST_CHECK_EQUAL(columns.events().size(), size_t(10));
+	BOOST_CHECK_EQUAL(columns.streamIDs().size(), size_t(5));
+
+	// Objects are added only once
+	BOOST_CHECK(!columns.add(ep->pick(0)));
+	BOOST_CHECK(!columns.add(ep->origin(0)));
+	BOOST_CHECK_EQUAL(columns.arrivals().size(), size_t(60));
+
+	size_t row = columns.originRow("Origin/3");
+	BOOST_REQUIRE(row != EventParametersColumns::NoRow);
+	BOOST_CHECK_EQUAL(columns.origins().firstArrival[row], size_t(18));
+	BOOST_CHECK_EQUAL(columns.origins().firstArrival[row+1], size_t(24));
+
+	size_t arrival = columns.origins().firstArrival[row];
+	BOOST_CHECK_EQUAL(columns.pickRow(columns.arrivals().pickID[arrival]),
+	                  columns.pickRow("Pick/3.0"));
+
+	Core::Time start(2015, 1, 1);
+	BOOST_CHECK_EQUAL(columns.selectPicks(start, start + Core::TimeSpan(120.0)).size(), size_t(12));
+	BOOST_CHECK_EQUAL(columns.selectPicks(start, start + Core::TimeSpan(3600.0), "GE.MORC..BHZ").size(), size_t(20));
+	BOOST_CHECK(columns.selectPicks(start, start + Core::TimeSpan(3600.0), "GE.XXX..BHZ").empty());
+
+	BOOST_CHECK_EQUAL(columns.selectOrigins(start, start + Core::TimeSpan(3600.0), -90, 90, -180, -175).size(), size_t(6));
+	// Across the date line: the origins at -180 ... -178
+	BOOST_CHECK_EQUAL(columns.selectOrigins(start, start + Core::TimeSpan(3600.0), -90, 90, 170, -178).size(), size_t(3));
+
+	BOOST_CHECK_EQUAL(columns.selectEvents(start, start + Core::TimeSpan(300.0)).size(), size_t(5));
+	BOOST_CHECK_EQUAL(columns.selectEvents(start, start + Core::TimeSpan(3600.0), 5).size(), size_t(3));
+
+	vector<size_t> perStream = columns.countPicksPerStream();
+	BOOST_CHECK_EQUAL(perStream[columns.streamIDs().find("GE.MORC..BHZ")], size_t(20));
+
+	vector<size_t> perPhase = columns.countArrivalsPerPhase();
+	BOOST_CHECK_EQUAL(perPhase[columns.phases().find("P")], size_t(30));
+
+	EventParametersColumns::Statistics stats = columns.timeResiduals();
+	BOOST_CHECK_EQUAL(stats.count, size_t(60));
+	BOOST_CHECK_CLOSE(stats.mean + 1, 1.0, 1E-9);
+	BOOST_CHECK_CLOSE(stats.rms, 1.0, 1E-9);
+
+	stats = columns.timeResiduals("S");
+	BOOST_CHECK_EQUAL(stats.count, size_t(30));
+	BOOST_CHECK_CLOSE(stats.mean, 1.0, 1E-9);
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(streamReader) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	EventParametersPtr ep = createEventParameters(10, 6);
+
+	stringbuf buf;
+	IO::XMLArchive ar;
+	ar.create(&buf);
+	ar << ep;
+	ar.close();
+
+	stringbuf in(buf.str());
+	IO::XMLStreamReader reader;
+	BOOST_REQUIRE(reader.open(&in));
+
+	EventParametersColumns columns;
+	BOOST_CHECK_EQUAL(columns.read(reader), size_t(80));
+	BOOST_CHECK_EQUAL(columns.arrivals().size(), size_t(60));
+	BOOST_CHECK_EQUAL(columns.selectEvents(Core::Time(2015, 1, 1), Core::Time(2015, 1, 2)).size(), size_t(10));
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
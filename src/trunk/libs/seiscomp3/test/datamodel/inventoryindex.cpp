@@ -0,0 +1,78 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_inventoryindex
+
+
+#include <seiscomp3/datamodel/inventory_package.h>
+#include <seiscomp3/datamodel/inventoryindex.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+Core::Time year(int y) {
+	return Core::Time(y, 1, 1);
+}
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(lookup) {
+	InventoryPtr inv = createEpochInventory();
+	InventoryIndex index(inv.get());
+
+	const char *netCodes[] = { "GE", "II", "XX" };
+	const char *staCodes[] = { "ST0", "ST1", "ST2", "ST9" };
+
+	for ( int n = 0; n < 3; ++n ) {
+		for ( int s = 0; s < 4; ++s ) {
+			// Check all epoch boundaries and the times in between
+			for ( int y = 1985; y <= 2030; ++y ) {
+				Core::Time times[] = { year(y), year(y) + Core::TimeSpan(86400*180) };
+				for ( int t = 0; t < 2; ++t ) {
+					BOOST_CHECK_EQUAL(index.getStation(netCodes[n], staCodes[s], times[t]),
+					                  getStation(inv.get(), netCodes[n], staCodes[s], times[t]));
+					BOOST_CHECK_EQUAL(index.getSensorLocation(netCodes[n], staCodes[s], "", times[t]),
+					                  getSensorLocation(inv.get(), netCodes[n], staCodes[s], "", times[t]));
+					BOOST_CHECK_EQUAL(index.getStream(netCodes[n], staCodes[s], "", "BHZ", times[t]),
+					                  getStream(inv.get(), netCodes[n], staCodes[s], "", "BHZ", times[t]));
+				}
+			}
+		}
+	}
+
+	InventoryError indexError, error;
+	BOOST_CHECK(index.getStream("GE", "ST0", "", "BHN", year(2000), &indexError) == NULL);
+	BOOST_CHECK(getStream(inv.get(), "GE", "ST0", "", "BHN", year(2000), &error) == NULL);
+	BOOST_CHECK_EQUAL(indexError.toString(), error.toString());
+
+	index.clear();
+	BOOST_CHECK(index.getStation("GE", "ST0", year(2000)) == NULL);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
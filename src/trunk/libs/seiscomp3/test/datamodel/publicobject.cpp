@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_publicobject
+
+
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/unittest/unittests.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+namespace bu = boost::unit_test;
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(registration) {
+	size_t count = PublicObject::ObjectCount();
+
+	PickPtr pick = Pick::Create("Pick/1");
+	BOOST_REQUIRE(pick != NULL);
+	BOOST_CHECK(pick->registered());
+	BOOST_CHECK(PublicObject::Find("Pick/1") == pick.get());
+	BOOST_CHECK(Pick::Create("Pick/1") == NULL);
+
+	// A second object with the same publicID is not registered
+	PickPtr other = new Pick("Pick/1");
+	BOOST_CHECK(!other->registered());
+	BOOST_CHECK(PublicObject::Find("Pick/1") == pick.get());
+
+	BOOST_CHECK(pick->setPublicID("Pick/2"));
+	BOOST_CHECK(PublicObject::Find("Pick/1") == NULL);
+	BOOST_CHECK(PublicObject::Find("Pick/2") == pick.get());
+	BOOST_CHECK(other->registerMe());
+	BOOST_CHECK(PublicObject::Find("Pick/1") == other.get());
+
+	// The registry is iterated in publicID order
+	size_t iterated = 0;
+	string lastID;
+	for ( PublicObject::Iterator it = PublicObject::Begin(); it != PublicObject::End(); ++it ) {
+		BOOST_CHECK_EQUAL(it->first, it->second->publicID());
+		BOOST_CHECK(iterated == 0 || lastID < it->first);
+		lastID = it->first;
+		++iterated;
+	}
+	BOOST_CHECK_EQUAL(iterated, PublicObject::ObjectCount());
+
+	pick = NULL;
+	other = NULL;
+	BOOST_CHECK(PublicObject::Find("Pick/2") == NULL);
+	BOOST_CHECK_EQUAL(PublicObject::ObjectCount(), count);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
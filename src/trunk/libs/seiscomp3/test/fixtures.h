@@ -0,0 +1,340 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#ifndef __SEISCOMP_TEST_FIXTURES_H__
+#define __SEISCOMP_TEST_FIXTURES_H__
+
+
+#include <seiscomp3/core/datetime.h>
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/datamodel/inventory_package.h>
+#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/seismology/ttt/grid.h>
+
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+
+namespace Seiscomp {
+namespace Test {
+
+
+/**
+ * Creates an inventory with the given number of networks and stations per
+ * network. Each station has one comment and one sensor location with three
+ * streams. The publicIDs are derived from the codes so that independently
+ * created inventories can be compared with each other.
+ */
+inline DataModel::InventoryPtr createInventory(int networks, int stations) {
+	using namespace DataModel;
+
+	InventoryPtr inv = new Inventory;
+	char id[64], code[16];
+
+	for ( int n = 0; n < networks; ++n ) {
+		snprintf(id, sizeof(id), "Network/N%d", n);
+		NetworkPtr net = Network::Create(id);
+		snprintf(code, sizeof(code), "N%d", n);
+		net->setCode(code);
+		net->setStart(Core::Time(1990, 1, 1));
+
+		for ( int s = 0; s < stations; ++s ) {
+			snprintf(id, sizeof(id), "Station/N%d/S%d", n, s);
+			StationPtr sta = Station::Create(id);
+			snprintf(code, sizeof(code), "S%d", s);
+			sta->setCode(code);
+			sta->setStart(Core::Time(1995, 1, 1));
+			sta->setLatitude(s * 0.01);
+			sta->setLongitude(n * 0.1);
+			sta->add(new Comment);
+
+			snprintf(id, sizeof(id), "SensorLocation/N%d/S%d", n, s);
+			SensorLocationPtr loc = SensorLocation::Create(id);
+			loc->setCode("");
+			loc->setStart(sta->start());
+
+			const char *channels[] = { "HHZ", "HHN", "HHE" };
+			for ( int c = 0; c < 3; ++c ) {
+				snprintf(id, sizeof(id), "Stream/N%d/S%d/%s", n, s, channels[c]);
+				StreamPtr cha = Stream::Create(id);
+				cha->setCode(channels[c]);
+				cha->setStart(sta->start());
+				cha->setGain(1E9);
+				cha->setSampleRateNumerator(100);
+				cha->setSampleRateDenominator(1);
+				loc->add(cha.get());
+			}
+
+			sta->add(loc.get());
+			net->add(sta.get());
+		}
+
+		inv->add(net.get());
+	}
+
+	return inv;
+}
+
+
+/**
+ * Creates two networks GE and II with three stations each. Every station
+ * has three consecutive epochs with two sensor locations and one BHZ
+ * stream each. The network II ends in 2015 and its second sensor
+ * locations are open ended and overlap the following epochs.
+ */
+inline DataModel::InventoryPtr createEpochInventory() {
+	using namespace DataModel;
+
+	InventoryPtr inv = new Inventory;
+
+	const char *netCodes[] = { "GE", "II" };
+	for ( int n = 0; n < 2; ++n ) {
+		NetworkPtr net = Network::Create();
+		net->setCode(netCodes[n]);
+		net->setStart(Core::Time(1990, 1, 1));
+		if ( n == 1 ) net->setEnd(Core::Time(2015, 1, 1));
+		inv->add(net.get());
+
+		for ( int s = 0; s < 3; ++s ) {
+			char code[8];
+			snprintf(code, sizeof(code), "ST%d", s);
+
+			for ( int e = 0; e < 3; ++e ) {
+				StationPtr sta = Station::Create();
+				sta->setCode(code);
+				sta->setStart(Core::Time(1995 + e*10, 1, 1));
+				if ( e < 2 ) sta->setEnd(Core::Time(2005 + e*10, 1, 1));
+				net->add(sta.get());
+
+				for ( int l = 0; l < 2; ++l ) {
+					SensorLocationPtr loc = SensorLocation::Create();
+					loc->setCode("");
+					loc->setStart(Core::Time(1995 + e*10 + l*3, 1, 1));
+					if ( l == 0 || n == 0 )
+						loc->setEnd(Core::Time(2005 + e*10, 1, 1));
+					sta->add(loc.get());
+
+					StreamPtr cha = Stream::Create();
+					cha->setCode("BHZ");
+					cha->setStart(loc->start());
+					loc->add(cha.get());
+				}
+			}
+		}
+	}
+
+	return inv;
+}
+
+
+/**
+ * Creates event parameters with one event per minute starting at
+ * 2015-01-01. Each event has a preferred origin with the given number of
+ * arrivals and a preferred magnitude. The picks alternate between P and S
+ * with residuals of -1 and 1 and cycle through five stations of GE.
+ */
+inline DataModel::EventParametersPtr createEventParameters(int events, int arrivals) {
+	using namespace DataModel;
+
+	const char *stations[] = { "MORC", "RGN", "UGM", "WLF", "STU" };
+	EventParametersPtr ep = new EventParameters;
+	Core::Time start(2015, 1, 1);
+
+	for ( int e = 0; e < events; ++e ) {
+		char id[64];
+		snprintf(id, sizeof(id), "Origin/%d", e);
+		OriginPtr origin = Origin::Create(id);
+		origin->setTime(TimeQuantity(start + Core::TimeSpan(e * 60.0)));
+		origin->setLatitude(RealQuantity(-60 + e % 120, 0.5));
+		origin->setLongitude(RealQuantity(-180 + e % 360));
+		origin->setDepth(RealQuantity(10));
+		origin->setEvaluationMode(EvaluationMode(AUTOMATIC));
+		origin->add(new Comment);
+
+		for ( int a = 0; a < arrivals; ++a ) {
+			snprintf(id, sizeof(id), "Pick/%d.%d", e, a);
+			PickPtr pick = Pick::Create(id);
+			pick->setTime(TimeQuantity(origin->time().value() + Core::TimeSpan(10.0 + a)));
+			pick->setWaveformID(WaveformStreamID("GE", stations[a % 5], "", "BHZ", ""));
+			pick->setPhaseHint(Phase(a % 2 ? "S" : "P"));
+			ep->add(pick.get());
+
+			ArrivalPtr arr = new Arrival;
+			arr->setPickID(id);
+			arr->setPhase(Phase(a % 2 ? "S" : "P"));
+			arr->setDistance(a);
+			arr->setTimeResidual(a % 2 ? 1.0 : -1.0);
+			arr->setWeight(1);
+			origin->add(arr.get());
+		}
+
+		snprintf(id, sizeof(id), "Magnitude/%d", e);
+		MagnitudePtr mag = Magnitude::Create(id);
+		mag->setType("M");
+		mag->setMagnitude(RealQuantity(e % 8));
+		origin->add(mag.get());
+
+		ep->add(origin.get());
+
+		snprintf(id, sizeof(id), "Event/%d", e);
+		EventPtr event = Event::Create(id);
+		event->setPreferredOriginID(origin->publicID());
+		event->setPreferredMagnitudeID(mag->publicID());
+		ep->add(event.get());
+	}
+
+	return ep;
+}
+
+
+/**
+ * Creates reproducible times between 1900 and 2100 with no, arbitrary,
+ * millisecond and half second fractions.
+ */
+inline std::vector<Core::Time> createTimes(size_t count) {
+	std::vector<Core::Time> times;
+	times.reserve(count);
+
+	srand(12345);
+	for ( size_t i = 0; i < count; ++i ) {
+		long secs = (long)((double)rand() / RAND_MAX * 6311390400.0) - 2208988800L;
+		long usecs = 0;
+		switch ( i % 4 ) {
+			case 1: usecs = rand() % 1000000; break;
+			case 2: usecs = (rand() % 1000) * 1000; break;
+			case 3: usecs = 500000; break;
+		}
+		times.push_back(Core::Time(secs, usecs));
+	}
+
+	return times;
+}
+
+
+//! Creates reproducible noise with an onset after two thirds of the trace
+template <typename T>
+std::vector<T> createTrace(double fsamp, double length) {
+	std::vector<T> data(int(fsamp*length));
+	unsigned int seed = 1;
+	size_t onset = data.size()*2/3;
+
+	for ( size_t i = 0; i < data.size(); ++i ) {
+		seed = seed * 1103515245 + 12345;
+		double v = ((seed >> 16) & 0x7fff) / 32767.0 - 0.5;
+		if ( i >= onset ) {
+			double t = (i-onset) / fsamp;
+			v += 20*sin(2*M_PI*2*t) * exp(-t/5);
+		}
+		data[i] = (T)v;
+	}
+
+	return data;
+}
+
+
+//! The previous implementation of STALTA::apply used as reference
+template <typename T>
+void referenceSTALTA(std::vector<T> &data, double fsamp, double lenSTA, double lenLTA) {
+	int numSTA = int(lenSTA*fsamp+0.5), numLTA = int(lenLTA*fsamp+0.5);
+	int initLength = numLTA/2, sampleCount = 0;
+	double inlta = 1./numLTA, insta = 1./numSTA;
+	double sta = 0, lta = 0;
+
+	for ( size_t i = 0; i < data.size(); ++i ) {
+		if ( sampleCount < initLength ) {
+			lta = (sampleCount*lta+fabs(data[i]))/(sampleCount+1);
+			sta = lta;
+			data[i] = 1.;
+			sampleCount++;
+		}
+		else {
+			double q = (sta - lta)*inlta;
+			lta += q;
+			sta += (fabs(data[i]) - sta)*insta;
+			data[i] = (T)(sta/lta);
+		}
+	}
+}
+
+
+//! The previous implementation of the AIC repicker used as reference
+template <typename T>
+int referenceAIC(int n, const T *data, int margin = 10) {
+	double sumwin1 = 0, sumwin2 = 0, minaic = 0;
+	int imin = margin, imax = n-margin, kmin = -1;
+	for ( int i = 0; i < n; ++i ) {
+		T squared = data[i]*data[i];
+		if ( i < imin )
+			sumwin1 += squared;
+		else
+			sumwin2 += squared;
+	}
+
+	for ( int k = imin; k < imax; ++k ) {
+		double var1 = sumwin1/(k-1),
+		       var2 = sumwin2/(n-k-1);
+		double aic = k*log10(var1) + (n-k-1)*log10(var2);
+		T squared = data[k]*data[k];
+
+		sumwin1 += squared;
+		sumwin2 -= squared;
+
+		if ( (k == imin) || (aic < minaic) ) {
+			minaic = aic;
+			kmin = k;
+		}
+	}
+
+	return kmin;
+}
+
+
+//! Creates reproducible source receiver pairs up to 100 deg and 600 km
+inline std::vector<TTT::Grid::Point> createPoints(size_t count) {
+	std::vector<TTT::Grid::Point> points;
+	unsigned int seed = 1;
+
+	for ( size_t i = 0; i < count; ++i ) {
+		double r[4];
+		for ( int k = 0; k < 4; ++k ) {
+			seed = seed * 1103515245 + 12345;
+			r[k] = ((seed >> 16) & 0x7fff) / 32767.0;
+		}
+
+		points.push_back(TTT::Grid::Point(r[0]*80-40, r[1]*80-40, r[2]*600,
+		                                  r[3]*80-40, r[0]*20+r[1]*60-40));
+	}
+
+	return points;
+}
+
+
+//! Serializes an object to SCML to compare object trees
+inline std::string toXML(Core::BaseObject *obj) {
+	std::stringbuf buf;
+	IO::XMLArchive ar;
+	ar.create(&buf);
+	ar << obj;
+	ar.close();
+	return buf.str();
+}
+
+
+}
+}
+
+
+#endif
@@ -0,0 +1,223 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_bsonarchive
+
+
+#include <seiscomp3/io/archive/bsonarchive.h>
+#include <seiscomp3/io/exporter.h>
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <boost/iostreams/filtering_streambuf.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/copy.hpp>
+
+#include <sstream>
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+// A stream buffer like a pipe which does not support seeking
+class SequentialBuf : public std::streambuf {
+	public:
+		string data;
+
+	protected:
+		int_type overflow(int_type c) {
+			if ( c != traits_type::eof() ) data += (char)c;
+			return traits_type::not_eof(c);
+		}
+
+		streamsize xsputn(const char *s, streamsize n) {
+			data.append(s, n);
+			return n;
+		}
+};
+
+
+// A stream buffer like a full disk which accepts only the first bytes.
+// It reports the current position but cannot seek back.
+class LimitedBuf : public std::streambuf {
+	public:
+		LimitedBuf(size_t limit) : limit(limit) {}
+
+		string data;
+		size_t limit;
+
+	protected:
+		int_type overflow(int_type c) {
+			if ( c == traits_type::eof() ) return traits_type::not_eof(c);
+			if ( data.size() >= limit ) return traits_type::eof();
+			data += (char)c;
+			return c;
+		}
+
+		streamsize xsputn(const char *s, streamsize n) {
+			n = min(n, (streamsize)(limit - data.size()));
+			data.append(s, n);
+			return n;
+		}
+
+		pos_type seekoff(off_type off, ios_base::seekdir dir, ios_base::openmode) {
+			if ( off == 0 && dir == ios_base::cur ) return pos_type(data.size());
+			return pos_type(off_type(-1));
+		}
+
+		pos_type seekpos(pos_type pos, ios_base::openmode) {
+			if ( pos == pos_type(data.size()) ) return pos;
+			return pos_type(off_type(-1));
+		}
+};
+
+
+// Adds an event with a publicID that needs to be escaped in JSON
+EventParametersPtr createQuotedEventParameters(int events, int arrivals) {
+	EventParametersPtr ep = createEventParameters(events, arrivals);
+	EventPtr event = Event::Create("Event/\"1\"");
+	event->setPreferredOriginID("Origin/0");
+	event->add(new OriginReference("Origin/0"));
+	ep->add(event.get());
+	return ep;
+}
+
+
+string toBSON(Core::BaseObject *obj, bool streaming, bool json) {
+	stringbuf buf;
+	IO::BSONArchive ar;
+	ar.setStreaming(streaming);
+	ar.setJSON(json);
+	ar.create(&buf);
+	ar << obj;
+	ar.close();
+	return buf.str();
+}
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(streamingOutput) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	// Large enough to flush the stream writer several times
+	EventParametersPtr ep = createQuotedEventParameters(50, 40);
+
+	string tree = toBSON(ep.get(), false, false);
+	string streamed = toBSON(ep.get(), true, false);
+	BOOST_CHECK(tree.size() > 500000);
+	BOOST_CHECK(tree == streamed);
+
+	string treeJSON = toBSON(ep.get(), false, true);
+	string streamedJSON = toBSON(ep.get(), true, true);
+	BOOST_CHECK(treeJSON == streamedJSON);
+
+	// Output to stream buffers that cannot seek is buffered until close
+	SequentialBuf seqBuf;
+	{
+		IO::BSONArchive ar;
+		ar.setStreaming(true);
+		ar.create(&seqBuf);
+		ar << ep;
+	}
+	BOOST_CHECK(seqBuf.data == tree);
+
+	EventParametersPtr empty = new EventParameters;
+	BOOST_CHECK(toBSON(empty.get(), false, false) == toBSON(empty.get(), true, false));
+	BOOST_CHECK(toBSON(empty.get(), false, true) == toBSON(empty.get(), true, true));
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(streamingCompression) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	EventParametersPtr ep = createQuotedEventParameters(10, 20);
+
+	stringbuf buf;
+	{
+		IO::BSONArchive ar;
+		ar.setStreaming(true);
+		ar.setCompression(true);
+		ar.create(&buf);
+		ar << ep;
+	}
+
+	boost::iostreams::filtering_istreambuf in;
+	in.push(boost::iostreams::zlib_decompressor());
+	in.push(buf);
+	stringstream decompressed;
+	boost::iostreams::copy(in, decompressed);
+
+	BOOST_CHECK(decompressed.str() == toBSON(ep.get(), false, false));
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(writeErrors) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	EventParametersPtr ep = createQuotedEventParameters(50, 40);
+	IO::ExporterPtr bson = IO::Exporter::Create("bson");
+	IO::ExporterPtr json = IO::Exporter::Create("bson-json");
+	BOOST_REQUIRE(bson != NULL);
+	BOOST_REQUIRE(json != NULL);
+
+	stringbuf buf;
+	BOOST_CHECK(bson->write(&buf, ep.get()));
+	BOOST_CHECK(buf.str() == toBSON(ep.get(), false, false));
+
+	// The buffer runs full while streaming
+	LimitedBuf small(1000);
+	BOOST_CHECK(!bson->write(&small, ep.get()));
+
+	LimitedBuf smallJSON(1000);
+	BOOST_CHECK(!json->write(&smallJSON, ep.get()));
+
+	// The length prefixes of flushed documents cannot be patched
+	IO::BSONArchive ar;
+	LimitedBuf noSeek(10000000);
+	ar.setStreaming(true);
+	ar.create(&noSeek);
+	ar << ep;
+	ar.close();
+	BOOST_CHECK(!ar.good());
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
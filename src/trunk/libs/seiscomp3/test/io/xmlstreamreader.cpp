@@ -0,0 +1,176 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_xmlstreamreader
+
+
+#include <seiscomp3/io/archive/xmlarchive.h>
+#include <seiscomp3/io/archive/xmlstreamreader.h>
+#include <seiscomp3/datamodel/eventparameters_package.h>
+#include <seiscomp3/datamodel/inventory_package.h>
+#include <seiscomp3/datamodel/version.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <sstream>
+#include <stdio.h>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::DataModel;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+string createDocument() {
+	EventParametersPtr ep = new EventParameters;
+	InventoryPtr inv = new Inventory;
+
+	for ( int i = 0; i < 20; ++i ) {
+		char id[32];
+		snprintf(id, sizeof(id), "Pick/%d", i);
+		PickPtr pick = Pick::Create(id);
+		pick->setTime(TimeQuantity(Core::Time(2015, 1, 1, 0, 0, i)));
+		pick->setWaveformID(WaveformStreamID("GE", "MORC", "", "BHZ", ""));
+		pick->add(new Comment);
+		ep->add(pick.get());
+	}
+
+	OriginPtr origin = Origin::Create("Origin/1");
+	origin->setTime(TimeQuantity(Core::Time(2015, 1, 1)));
+	origin->setLatitude(RealQuantity(52.3));
+	origin->setLongitude(RealQuantity(13.1));
+	for ( int i = 0; i < 20; ++i ) {
+		char id[32];
+		snprintf(id, sizeof(id), "Pick/%d", i);
+		ArrivalPtr arr = new Arrival;
+		arr->setPickID(id);
+		arr->setPhase(Phase("P"));
+		origin->add(arr.get());
+	}
+	ep->add(origin.get());
+
+	EventPtr event = Event::Create("Event/1");
+	event->setPreferredOriginID(origin->publicID());
+	event->add(new OriginReference(origin->publicID()));
+	ep->add(event.get());
+
+	NetworkPtr net = Network::Create();
+	net->setCode("GE");
+	net->setStart(Core::Time(1990, 1, 1));
+	StationPtr sta = Station::Create();
+	sta->setCode("MORC");
+	sta->setStart(Core::Time(1995, 1, 1));
+	net->add(sta.get());
+	inv->add(net.get());
+
+	stringbuf buf;
+	IO::XMLArchive ar;
+	ar.create(&buf);
+	ar << ep;
+	ar << inv;
+	ar.close();
+
+	return buf.str();
+}
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(readObjects) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	string doc = createDocument();
+
+	stringbuf buf(doc);
+	IO::XMLArchive ar;
+	BOOST_REQUIRE(ar.open(&buf));
+	EventParametersPtr ep;
+	InventoryPtr inv;
+	ar >> ep;
+	ar >> inv;
+	ar.close();
+	BOOST_REQUIRE(ep != NULL);
+	BOOST_REQUIRE(inv != NULL);
+
+	stringbuf streamBuf(doc);
+	IO::XMLStreamReader reader;
+	BOOST_REQUIRE(reader.open(&streamBuf));
+	BOOST_CHECK(reader.version() == Core::Version(DataModel::Version::Major, DataModel::Version::Minor));
+
+	PublicObjectPtr obj = reader.read();
+	BOOST_REQUIRE(EventParameters::Cast(obj) != NULL);
+	BOOST_CHECK_EQUAL(toXML(obj.get()), toXML(ep.get()));
+
+	obj = reader.read();
+	BOOST_REQUIRE(Inventory::Cast(obj) != NULL);
+	BOOST_CHECK_EQUAL(toXML(obj.get()), toXML(inv.get()));
+
+	BOOST_CHECK(reader.read() == NULL);
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(readChildren) {
+	PublicObject::SetRegistrationEnabled(false);
+
+	stringbuf buf(createDocument());
+	IO::XMLStreamReader reader;
+	BOOST_REQUIRE(reader.open(&buf));
+
+	int picks = 0, origins = 0, events = 0, networks = 0;
+	ObjectPtr obj;
+	while ( (obj = reader.next()) != NULL ) {
+		BOOST_CHECK(obj->parent() == NULL);
+
+		if ( Pick::Cast(obj) ) {
+			BOOST_CHECK(EventParameters::Cast(reader.topLevelObject()) != NULL);
+			BOOST_CHECK_EQUAL(Pick::Cast(obj)->commentCount(), size_t(1));
+			++picks;
+		}
+		else if ( Origin::Cast(obj) ) {
+			BOOST_CHECK_EQUAL(Origin::Cast(obj)->arrivalCount(), size_t(20));
+			++origins;
+		}
+		else if ( Event::Cast(obj) )
+			++events;
+		else if ( Network::Cast(obj) ) {
+			BOOST_CHECK(Inventory::Cast(reader.topLevelObject()) != NULL);
+			BOOST_CHECK_EQUAL(Network::Cast(obj)->stationCount(), size_t(1));
+			++networks;
+		}
+	}
+
+	BOOST_CHECK_EQUAL(picks, 20);
+	BOOST_CHECK_EQUAL(origins, 1);
+	BOOST_CHECK_EQUAL(events, 1);
+	BOOST_CHECK_EQUAL(networks, 1);
+
+	PublicObject::SetRegistrationEnabled(true);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_stalta
+
+
+#include <seiscomp3/math/filter/stalta.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../../processing/picker/aic_private.h"
+#include "../fixtures.h"
+
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Math::Filtering;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+template <typename T>
+void checkSTALTA(double fsamp) {
+	vector<T> data = createTrace<T>(fsamp, 600);
+	vector<T> ref = data;
+
+	STALTA<T> filter(2, 80, fsamp);
+	// Feed in chunks of one record to exercise the state handling
+	for ( size_t i = 0; i < data.size(); i += 512 )
+		filter.apply(min(data.size()-i, size_t(512)), &data[i]);
+
+	referenceSTALTA(ref, fsamp, 2, 80);
+
+	for ( size_t i = 0; i < data.size(); ++i )
+		BOOST_REQUIRE(data[i] == ref[i]);
+}
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(stalta) {
+	checkSTALTA<double>(100);
+	checkSTALTA<double>(200);
+	checkSTALTA<float>(100);
+	checkSTALTA<float>(200);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(aic) {
+	const double rates[] = { 100, 200 };
+
+	for ( size_t r = 0; r < 2; ++r ) {
+		vector<double> data = createTrace<double>(rates[r], 60);
+		double var1, var2;
+		int kmin = maeda_aic_min((int)data.size(), &data[0], 0.0, var1, var2);
+		BOOST_CHECK_EQUAL(kmin, referenceAIC((int)data.size(), &data[0]));
+		// The onset is set after two thirds of the trace
+		BOOST_CHECK(abs(kmin - int(data.size()*2/3)) < rates[r]*0.1);
+		BOOST_CHECK(var2 > var1);
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
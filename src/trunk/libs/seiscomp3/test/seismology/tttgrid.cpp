@@ -0,0 +1,152 @@
+/***************************************************************************
+ *   Copyright (C) by GFZ Potsdam and gempa GmbH                           *
+ *                                                                         *
+ *   You can redistribute and/or modify this program under the             *
+ *   terms of the SeisComP Public License.                                 *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   SeisComP Public License for more details.                             *
+ ***************************************************************************/
+
+
+#define SEISCOMP_TEST_MODULE test_tttgrid
+
+
+#define SEISCOMP_COMPONENT test_tttgrid
+#include <seiscomp3/logging/log.h>
+#include <seiscomp3/seismology/ttt/grid.h>
+#include <seiscomp3/seismology/ttt/libtau.h>
+#include <seiscomp3/seismology/ttt/locsat.h>
+#include <seiscomp3/unittest/unittests.h>
+
+#include "../fixtures.h"
+
+#include <math.h>
+#include <vector>
+
+
+using namespace std;
+using namespace Seiscomp;
+using namespace Seiscomp::Logging;
+using namespace Seiscomp::TTT;
+using namespace Seiscomp::Test;
+namespace bu = boost::unit_test;
+
+
+namespace {
+
+
+const char *Phases[] = { "P", "Pn", "Pg", "S", "Sn", "Sg" };
+
+
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(accuracy_locsat) {
+	enableConsoleLogging(getAll());
+
+	Grid grid;
+	Locsat locsat;
+	BOOST_REQUIRE(grid.setModel("iasp91"));
+	BOOST_REQUIRE(locsat.setModel("iasp91"));
+
+	vector<Grid::Point> points = createPoints(2000);
+
+	for ( size_t p = 0; p < sizeof(Phases) / sizeof(const char*); ++p ) {
+		double maxDiff = 0, sumDiff = 0;
+		size_t count = 0, missing = 0;
+
+		for ( size_t i = 0; i < points.size(); ++i ) {
+			const Grid::Point &pt = points[i];
+			TravelTime ref;
+
+			try {
+				ref = locsat.compute(Phases[p], pt.lat1, pt.lon1, pt.dep1,
+				                     pt.lat2, pt.lon2, 0, 0);
+			}
+			catch ( ... ) {
+				continue;
+			}
+
+			try {
+				TravelTime tt = grid.compute(Phases[p], pt.lat1, pt.lon1, pt.dep1,
+				                             pt.lat2, pt.lon2, 0, 0);
+				double diff = fabs(tt.time - ref.time);
+				if ( diff > maxDiff ) maxDiff = diff;
+				sumDiff += diff;
+				++count;
+			}
+			catch ( ... ) {
+				// Close to the table boundaries LOCSAT extrapolates
+				++missing;
+			}
+		}
+
+		SEISCOMP_INFO("%-3s: %d samples, %d missing, mean diff %.4fs, max diff %.4fs",
+		              Phases[p], int(count), int(missing),
+		              count ? sumDiff / count : 0.0, maxDiff);
+
+		BOOST_CHECK(count > 0);
+		BOOST_CHECK(maxDiff < 0.1);
+		BOOST_CHECK(sumDiff < 0.01 * count);
+	}
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(batch) {
+	Grid grid;
+	BOOST_REQUIRE(grid.setModel("iasp91"));
+
+	vector<Grid::Point> points = createPoints(1000);
+	vector<TravelTime> results(points.size());
+
+	size_t valid = grid.compute(&results[0], "P", &points[0], points.size());
+	BOOST_CHECK(valid > 0);
+
+	size_t count = 0;
+	for ( size_t i = 0; i < points.size(); ++i ) {
+		const Grid::Point &p = points[i];
+		try {
+			TravelTime tt = grid.compute("P", p.lat1, p.lon1, p.dep1,
+			                             p.lat2, p.lon2);
+			BOOST_CHECK(results[i].time == tt.time);
+			++count;
+		}
+		catch ( ... ) {
+			BOOST_CHECK(results[i].time < 0);
+		}
+	}
+
+	BOOST_CHECK(count == valid);
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+
+
+
+
+//<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+BOOST_AUTO_TEST_CASE(libtauModel) {
+	// The libtau tables are optional
+	LibTau libtau;
+	try {
+		libtau.setModel("iasp91");
+	}
+	catch ( ... ) {
+		BOOST_TEST_MESSAGE("libtau tables not available, skipped");
+		return;
+	}
+
+	Grid grid;
+	BOOST_CHECK(grid.setModel("libtau:iasp91"));
+}
+//>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
@@ -48,6 +48,7 @@
 #include "seiscomp3/datamodel/databasereader.h"
 #include "seiscomp3/datamodel/databasequery.h"
 #include "seiscomp3/datamodel/messages.h"
+#include "seiscomp3/datamodel/eventparameterscolumns.h"
 %}
 
 %newobject Seiscomp::DataModel::DatabaseReader::loadJournaling;
@@ -59,6 +60,10 @@
 %newobject Seiscomp::DataModel::DatabaseReader::loadConfig;
 %newobject Seiscomp::DataModel::DatabaseReader::loadRouting;
 
+// Provides std::vector<size_t> as Indexes. It is imported before
+// datamodelbase.i to keep the exception handler defined there.
+%import "Geo.i"
+
 %include "datamodelbase.i"
 %include "seiscomp3/datamodel/types.h"
 
@@ -231,4 +236,16 @@ optional_enum(Seiscomp::DataModel::StationGroupType);
 %include "seiscomp3/datamodel/databasequery.h"
 %include "seiscomp3/datamodel/messages.h"
 
+// columnar event parameters, None is a keyword in Python
+%rename(NoIndex) Seiscomp::DataModel::StringDictionary::None;
+%ignore Seiscomp::DataModel::EventParametersColumns::read(Seiscomp::IO::XMLStreamReader &);
+
+namespace std {
+   %template(vectori) vector<int>;
+   %template(vectorui) vector<unsigned int>;
+   %template(vectorsc) vector<signed char>;
+};
+
+%include "seiscomp3/datamodel/eventparameterscolumns.h"
+
 %include "datamodelext.i"
@@ -0,0 +1,87 @@
+"""Test for the Python bindings of DataModel.EventParametersColumns."""
+import unittest
+from seiscomp3 import Core, DataModel
+
+
+def createEventParameters():
+    ep = DataModel.EventParameters()
+    start = Core.Time(2020, 1, 1, 0, 0, 0)
+
+    origin = DataModel.Origin.Create("Origin/1")
+    origin.setTime(DataModel.TimeQuantity(start))
+    origin.setLatitude(DataModel.RealQuantity(52.4))
+    origin.setLongitude(DataModel.RealQuantity(13.1))
+
+    for i, sta in enumerate(["APE", "KBS", "RUE"]):
+        pick = DataModel.Pick.Create("Pick/%d" % i)
+        pick.setTime(DataModel.TimeQuantity(start + Core.TimeSpan(10.0 * (i+1))))
+        pick.setWaveformID(DataModel.WaveformStreamID("GE", sta, "", "BHZ", ""))
+        pick.setPhaseHint(DataModel.Phase("P"))
+        ep.add(pick)
+
+        arrival = DataModel.Arrival()
+        arrival.setPickID(pick.publicID())
+        arrival.setPhase(DataModel.Phase("P"))
+        arrival.setTimeResidual(i - 1.0)
+        origin.add(arrival)
+
+    ep.add(origin)
+    return ep
+
+
+class EventParametersColumnsTests(unittest.TestCase):
+    """Test the functionality of DataModel.EventParametersColumns"""
+
+    def setUp(self):
+        DataModel.PublicObject.SetRegistrationEnabled(False)
+
+    def tearDown(self):
+        DataModel.PublicObject.SetRegistrationEnabled(True)
+
+    def testColumns(self):
+        """Add event parameters and read the columns"""
+
+        columns = DataModel.EventParametersColumns()
+        columns.add(createEventParameters())
+
+        picks = columns.picks()
+        self.assertEqual(picks.size(), 3, 'Wrong number of picks!')
+        self.assertEqual(columns.origins().size(), 1, 'Wrong number of origins!')
+        self.assertEqual(columns.arrivals().size(), 3, 'Wrong number of arrivals!')
+
+        streamID = columns.streamIDs().value(picks.streamID[1])
+        self.assertEqual(streamID, 'GE.KBS..BHZ', 'Wrong stream ID!')
+        self.assertEqual(columns.pickRow("Pick/2"), 2, 'Wrong pick row!')
+        self.assertEqual(columns.pickRow("unknown"),
+                         DataModel.EventParametersColumns.NoRow,
+                         'Unknown pick found!')
+        self.assertEqual(columns.streamIDs().find("unknown"),
+                         DataModel.StringDictionary.NoIndex,
+                         'Unknown stream ID found!')
+
+    def testSelection(self):
+        """Select and aggregate rows"""
+
+        columns = DataModel.EventParametersColumns()
+        columns.add(createEventParameters())
+
+        start = Core.Time(2020, 1, 1, 0, 0, 0)
+        rows = columns.selectPicks(start, start + Core.TimeSpan(25.0))
+        self.assertEqual(list(rows), [0, 1], 'Wrong picks selected!')
+
+        rows = columns.selectPicks(start, start + Core.TimeSpan(60.0),
+                                   'GE.RUE..BHZ')
+        self.assertEqual(list(rows), [2], 'Wrong picks of stream selected!')
+
+        self.assertEqual(list(columns.countPicksPerStream()), [1, 1, 1],
+                         'Wrong pick counts!')
+
+        stats = columns.timeResiduals("P")
+        self.assertEqual(stats.count, 3, 'Wrong number of residuals!')
+        self.assertAlmostEqual(stats.mean, 0.0)
+        self.assertAlmostEqual(stats.min, -1.0)
+        self.assertAlmostEqual(stats.max, 1.0)
+
+
+if __name__ == '__main__':
+    unittest.main()